@@ -89,7 +89,7 @@
 
 /* Software timer definitions. */
 #define configUSE_TIMERS                         1
-#define configTIMER_TASK_PRIORITY                ( 2 )
+#define configTIMER_TASK_PRIORITY                ( 32 )
 #define configTIMER_QUEUE_LENGTH                 10
 #define configTIMER_TASK_STACK_DEPTH             256
 
@@ -168,6 +168,12 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* 自定义 Tickless Idle：息屏时进入 STOP，由 RTC 唤醒定时器限定时长（见 low_power.c） */
+#define configUSE_TICKLESS_IDLE                  2
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+void LowPower_SuppressTicksAndSleep(uint32_t xExpectedIdleTime);
+#endif
+#define portSUPPRESS_TICKS_AND_SLEEP(xExpectedIdleTime) LowPower_SuppressTicksAndSleep(xExpectedIdleTime)
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
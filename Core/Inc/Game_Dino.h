@@ -2,7 +2,6 @@
 #define __GAME_DINO_H
 
 void Dino_Tick(void);
-int DinoGame_Animation(void);
 void DinoGame_Pos_Init(void);
 void Game_Dino_Init(void);
 
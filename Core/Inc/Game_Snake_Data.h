@@ -8,22 +8,22 @@ const uint8_t Game_Snake_Tile_8x8[][8] =
 {
 /*--  调入了一幅图像：空气  --*/
 /*--  宽度x高度=8x8  --*/
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+{0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
 /*--  调入了一幅图像：墙壁  --*/
 /*--  宽度x高度=8x8  --*/
-0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+{0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF},
 /*--  调入了一幅图像：食物  --*/
 /*--  宽度x高度=8x8  --*/
-0x00,0x30,0x4A,0x4A,0x4C,0x48,0x30,0x00,
+{0x00,0x30,0x4A,0x4A,0x4C,0x48,0x30,0x00},
 /*--  调入了一幅图像：蛇头  --*/
 /*--  宽度x高度=8x8  --*/
-0xFF,0x81,0xBD,0xA5,0xA5,0xBD,0x81,0xFF,
+{0xFF,0x81,0xBD,0xA5,0xA5,0xBD,0x81,0xFF},
 /*--  调入了一幅图像：蛇身  --*/
 /*--  宽度x高度=8x8  --*/
-0x00,0x7E,0x42,0x5A,0x5A,0x42,0x7E,0x00,
+{0x00,0x7E,0x42,0x5A,0x5A,0x42,0x7E,0x00},
 /*--  调入了一幅图像：蛇尾  --*/
 /*--  宽度x高度=8x8  --*/
-0x00,0x30,0x4A,0x4A,0x4C,0x48,0x30,0x00,
+{0x00,0x30,0x4A,0x4A,0x4C,0x48,0x30,0x00},
 };
 
 #endif
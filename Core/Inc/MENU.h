@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 #include "input.h"
+#include "ui_anim.h"
 
 /* 自动息屏配置 */
 #define AUTO_SLEEP_ENABLED 1        // 是否启用自动息屏 (1=启用, 0=禁用)
@@ -26,15 +27,23 @@
 #define MENU_BORDER 1         // 边框线条尺寸
 #define IS_CENTERED 1         // 是否居中
 #define IS_OVERSHOOT 1        // 是否过冲 (果冻效果)
-#define OVERSHOOT 0.15       // 过冲量 0 < 范围 < 1;
-#define ANIMATION_SPEED 0.5 // 动画速度 0 < 范围 <= 1;
+#define OVERSHOOT_DAMPING 0.6  // 过冲时光标弹簧的阻尼比 0 < 范围 < 1, 越小过冲越大;
+#define CURSOR_SPRING_OMEGA 45 // 光标弹簧固有角频率 (rad/s), 越大越快;
+#define ANIMATION_TIME_MS 150  // 补间动画时长 (ms), 与帧率无关;
+
+#define MARQUEE_SPEED 30        // 超宽选中项的滚动字幕速度 (像素/秒)
+#define MARQUEE_PAUSE_MS 1000   // 每轮滚动开始前停顿 (ms)
+#define MARQUEE_GAP 24          // 首尾相接时的间隔 (像素)
+
+#define MENU_FLING_MIN_RATE 20  // 转速不低于此值 (格/秒) 时松手后列表继续惯性滚动
+#define MENU_FLING_MAX 40       // 惯性滚动的最大初速度 (项/秒)
+#define MENU_FLING_DECEL 160    // 惯性滚动的减速度 (项/秒²)，最大初速度下约滑行 5 项
 
 #define CURSOR_CEILING (((MENU_HEIGHT - MENU_MARGIN - MENU_MARGIN) / MENU_LINE_H) - 1) // 光标限位
 
 /* 全局变量声明 */
 extern uint32_t last_activity_time;    // 最后活动时间
 extern uint8_t screen_sleeping;        // 屏幕睡眠状态
-extern uint8_t sleep_before_brightness; // 睡眠前的亮度值
 extern uint8_t oled_brightness;        // 当前亮度值（0~255）
 extern uint16_t auto_sleep_seconds;    // 可调节的自动睡眠时间(秒)
 
@@ -51,27 +60,78 @@ enum _MENU_StrVarType // 选项字符串附带的变量的数据类型枚举
     FLOAT,
 };
 
-enum _menu_command
+/* 显示后端接口：菜单层只通过这张表绘图，不直接调用具体的屏幕驱动 */
+typedef struct _MENU_DriverOps
 {
-    BUFFER_DISPLAY, // 无参无返
-    BUFFER_CLEAR,   // 无参无返
-    SHOW_STRING,    // 可变参数列表对应顺序: x, y, string
-    SHOW_CURSOR,    // 可变参数列表对应顺序: x, y, width, height;
-    DRAW_FRAME,     // 可变参数列表对应顺序: x, y, width, height;
-};
+    void (*clear)(void);                                                        // 擦除缓冲区
+    void (*display)(void);                                                      // 缓冲区更新至显示器
+    uint8_t (*draw_text)(int16_t x, int16_t y, const char *str, uint8_t font);  // 显示字符串，返回字符数；font 为 0 时用默认字体
+    void (*invert_rect)(int16_t x, int16_t y, int16_t width, int16_t height);   // 区域反色（光标）
+    void (*frame)(int16_t x, int16_t y, int16_t width, int16_t height);         // 空心矩形（边框）
+    uint8_t (*measure_text)(const char *str);                                   // 只计算字符数，不绘制
+    uint16_t (*render_strip)(const char *str, uint8_t *strip, uint16_t strip_w); // 离屏光栅化为 MENU_FONT_H 高的条带（按页存放，每页 strip_w 字节），返回像素宽度
+    void (*blit_strip)(int16_t x, int16_t y, uint8_t width, const uint8_t *strip, uint16_t strip_w, uint16_t src_x); // 显示条带中从 src_x 开始、宽 width 的窗口
+} MENU_DriverOps;
 
-typedef struct _MENU_OptionTypeDef // 选项结构体
+/*
+ * 附带变量的选项格式化后的最大长度（含结束符）
+ * 31 个字符约 1.5 个屏宽，超宽时由滚动字幕显示全文；原先的 64 字节只是格式化用的栈上临时缓冲，
+ * 现在每个状态侧表项要常驻一份格式化结果和一份 STRING 内容，滚动字幕的离屏条带宽度也按它计算，
+ * 因此取 32。超出的部分被截断。
+ */
+#define MENU_OPTION_TEXT_MAX 32
+
+typedef struct _MENU_PageDef MENU_PageDef;
+
+typedef struct _MENU_OptionTypeDef // 选项结构体（只读，随页面表放在 Flash）
 {
-    char *String;                     // 选项字符串
+    const char *String;               // 选项字符串（附带变量时为格式模板）
     void (*func)(void);               // 函数指针
+    const MENU_PageDef *Child;        // 子菜单页面，非 NULL 时确定键进入该页面
     void *StrVarPointer;              // 附带变量 的指针
     enum _MENU_StrVarType StrVarType; // 附带变量 的类型
-    uint8_t StrLen;                   // 字符串长度
+    uint8_t StrLen;                   // 字符串长度（编译期计算）
 } MENU_OptionTypeDef;
 
+typedef struct _MENU_OptionState // 选项的可变状态（RAM 侧表，只有内容会变的页面才有）
+{
+    const char *Text;                      // 运行时替换的显示文本/模板，NULL 时使用选项表中的 String
+    uint8_t StrLen;                        // 当前显示的字符串长度
+
+    /* 附带变量的格式化缓存：模板指针与变量值都没变时直接复用，不再 sprintf */
+    uint8_t CacheValid;                    // 缓存有效
+    const char *CacheTemplate;             // 生成缓存时的模板
+    uint32_t CacheValue;                   // 生成缓存时的变量值（数值类型，按位）
+    char CacheString[MENU_OPTION_TEXT_MAX]; // 生成缓存时的字符串内容（STRING）
+    char CacheText[MENU_OPTION_TEXT_MAX];  // 格式化结果
+} MENU_OptionState;
+
+/* 虚拟列表的数据源：不物化选项表，只在绘制可见行时按下标取文本。
+ * 第 0 行固定为 "<<<"，数据项 index 显示在第 index + 1 行，光标与滚动语义与普通页面一致。
+ * 每帧只取可见窗口上下各多一行与光标所在行，RAM 与单帧开销不随项数增长。 */
+typedef struct _MENU_ListSource
+{
+    uint16_t (*count)(void *ctx);                               // 当前项数，可随时变化（超过 MENU_LIST_MAX_ITEMS 截断）
+    const char *(*get_item)(void *ctx, uint16_t index, char *buf); // 第 index 项的文本：写入 buf（MENU_OPTION_TEXT_MAX 字节）或返回常量
+    void (*on_select)(void *ctx, uint16_t index);               // 确定键选中数据项（可为 NULL）
+    void *ctx;                                                  // 回调上下文
+    uint8_t live;                                               // 内容会自行变化（扫描结果、消息记录等），静止时也定期重绘
+} MENU_ListSource;
+
+#define MENU_LIST_MAX_ITEMS (INT16_MAX - 1) // 虚拟列表项数上限（下标为 int16_t）
+
+struct _MENU_PageDef // 菜单页面（只读）
+{
+    const MENU_OptionTypeDef *OptionList; // 选项表，[0] 为 "<<<"；虚拟列表为 NULL
+    int16_t Option_Max_i;                 // 最后一项的下标（编译期计算）；虚拟列表运行时取 count
+    const MENU_PageDef *Parent;           // 上级页面，根页面为 NULL
+    MENU_OptionState *State;              // 可变状态侧表（与选项表等长），静态页面为 NULL
+    const MENU_ListSource *Source;        // 虚拟列表的数据源，普通页面为 NULL
+};
+
 typedef struct _MENU_HandleTypeDef // 选项结构体
 {
-    MENU_OptionTypeDef *OptionList; // 选项列表指针
+    const MENU_PageDef *Page;     // 页面（选项表）
 
     int16_t Catch_i;              // 选中下标
     int16_t Cursor_i;             // 光标下标
@@ -80,9 +140,17 @@ typedef struct _MENU_HandleTypeDef // 选项结构体
     int16_t Show_i_Previous;      // 上一次的显示下标
     int16_t Wheel_Event;          // 菜单滚动事件
     uint8_t AnimationUpdateEvent; // 动画更新事件
-    uint8_t isRun;                // 运行标志
     uint8_t isInitialized;        // 已初始化标志
-    // uint8_t isPlayingAnimation; // 正在播放动画标志
+
+    /* 动画槽位（见 ui_anim.h），首次绘制时分配，MENU_HandleRelease 释放 */
+    UI_AnimId AnimCursor[4];      // 光标 xsta / ysta / xend / yend
+    UI_AnimId AnimListOffset;     // 列表滚动的垂直偏移
+    UI_AnimId AnimScrollBar;      // 滚动条滑块高度
+
+    /* 惯性滚动（快速拨动后松手继续滑行并减速） */
+    int32_t FlingVelocity;        // 速度（Q16 项/秒，正数向下），0 表示未滑行
+    int32_t FlingAccum;           // 不足一项的位移（Q16）
+    uint32_t FlingTick;           // 上次推进的时刻；仍在转动时为预计停手的时刻
 
 } MENU_HandleTypeDef;
 
@@ -100,53 +168,99 @@ typedef enum UI_State
 #define COORD_CHANGE_SIZE(sta, end) (((end) - (sta)) + 1)   // 坐标转换成尺寸 COORD_CHANGE_SIZE
 #define SIZE_CHANGE_COORD(sta, size) (((sta) + (size)) - 1) // 尺寸转换成坐标 SIZE_CHANGE_COORD
 
-// 逐步接近目标, actual当前, target目标, step_size步长
-#define STEPWISE_TO_TARGET(actual, target, step_size)                                                                          \
-    ((((target) - (actual)) > (0.0625))    ? ((actual) + (0.0625) + (((target) - (actual)) * (step_size)))                     \
-     : (((target) - (actual)) < -(0.0625)) ? ((actual) - (0.0625) + (((target) - (actual)) * (step_size)))                     \
-                                           : ((target)))
+/* 声明式菜单页面（X-macro）：每个页面用一个列表宏描述选项，ITEM / SUBMENU / VAR 由展开处提供
+ *   #define MY_ITEMS(ITEM, SUBMENU, VAR)   \
+ *       ITEM("<<<", NULL)                  \
+ *       SUBMENU("Tools", Tools)            \
+ *       VAR("Temp:%.1fC", &temp, FLOAT)
+ *   MENU_PAGE_DEFINE(My, NULL, MY_ITEMS);
+ * 展开成 Flash 中的 const 选项表与页面 MENU_Page_My，选项数与字符串长度都在编译期算好，
+ * 不再需要 ".." 结尾标记。显示内容会变（VAR 或运行时改文本）的页面用 MENU_PAGE_DEFINE_DYNAMIC，
+ * 额外生成等长的 RAM 状态侧表。 */
+#define MENU_X_ITEM(str, fn)        {(str), (fn), NULL, NULL, INT8, sizeof(str) - 1},
+#define MENU_X_SUBMENU(str, id)     {(str), NULL, &MENU_Page_##id, NULL, INT8, sizeof(str) - 1},
+#define MENU_X_VAR(str, var, type)  {(str), NULL, NULL, (var), (type), sizeof(str) - 1},
+
+#define MENU_PAGE_DECLARE(id) extern const MENU_PageDef MENU_Page_##id
+
+#define MENU_PAGE_OPTIONS_(id, ITEMS) \
+    static const MENU_OptionTypeDef MENU_Options_##id[] = {ITEMS(MENU_X_ITEM, MENU_X_SUBMENU, MENU_X_VAR)}
+#define MENU_PAGE_COUNT_(id) ((int16_t)(sizeof(MENU_Options_##id) / sizeof(MENU_Options_##id[0])))
+
+#define MENU_PAGE_DEFINE(id, parent, ITEMS) \
+    MENU_PAGE_OPTIONS_(id, ITEMS);          \
+    const MENU_PageDef MENU_Page_##id = {MENU_Options_##id, MENU_PAGE_COUNT_(id) - 1, (parent), NULL, NULL}
+
+#define MENU_PAGE_DEFINE_DYNAMIC(id, parent, ITEMS)                      \
+    MENU_PAGE_OPTIONS_(id, ITEMS);                                       \
+    static MENU_OptionState MENU_State_##id[MENU_PAGE_COUNT_(id)];       \
+    const MENU_PageDef MENU_Page_##id = {MENU_Options_##id, MENU_PAGE_COUNT_(id) - 1, (parent), MENU_State_##id, NULL}
+
+/* 虚拟列表页面：内容由数据源 source（const MENU_ListSource *）按需提供 */
+#define MENU_PAGE_DEFINE_LIST(id, parent, source) \
+    const MENU_PageDef MENU_Page_##id = {NULL, 0, (parent), NULL, (source)}
 
 /**********************************************************/
 /* driver */
 
-int menu_command_callback(enum _menu_command command, ...);
-void MENU_RunMenu(MENU_HandleTypeDef *hMENU);
+/* 编译期绑定的显示后端（menu_driver.c 为 OLED 实现，其他屏幕/主机端替换该文件即可）。
+ * 表为 const，开启 LTO 时经表的调用会被折叠为直接调用 */
+extern const MENU_DriverOps MENU_Driver;
+
+void MENU_Display(void);
+void MENU_Present(void);
+void MENU_PushPage(const MENU_PageDef *Page);
+/* 菜单页应用的回调（ctx 为 MENU_HandleTypeDef *），自定义页面在自己的 UI_App 里转调 */
+void MENU_PageEnter(void *ctx);
+uint32_t MENU_PageFrame(void *ctx, bool full);
+void MENU_PageInput(void *ctx, const InputEvent *event);
+void MENU_PageExit(void *ctx);
+void MENU_PageResume(void *ctx);
 void MENU_HandleInit(MENU_HandleTypeDef *hMENU);
-void MENU_Event_and_Action(MENU_HandleTypeDef *hMENU);
+void MENU_HandleRelease(MENU_HandleTypeDef *hMENU);
+void MENU_HandleInput(MENU_HandleTypeDef *hMENU, const InputEvent *event);
 void MENU_UpdateIndex(MENU_HandleTypeDef *hMENU);
 void MENU_ShowOptionList(MENU_HandleTypeDef *hMENU);
-uint8_t MENU_ShowOption(int16_t X, int16_t Y, MENU_OptionTypeDef *Option);
+uint8_t MENU_ShowOption(int16_t X, int16_t Y, const MENU_OptionTypeDef *Option, MENU_OptionState *State);
+uint8_t MENU_MeasureOption(const MENU_OptionTypeDef *Option, MENU_OptionState *State);
+uint8_t MENU_OptionLen(MENU_HandleTypeDef *hMENU, int16_t i);
+void MENU_SyncListCount(MENU_HandleTypeDef *hMENU);
 void MENU_ShowCursor(MENU_HandleTypeDef *hMENU);
 void MENU_ShowBorder(MENU_HandleTypeDef *hMENU);
 void MENU_DrawScrollBar(MENU_HandleTypeDef *hMENU);
 void MENU_DrawProgressBar(int16_t x, int16_t y, uint8_t width, uint8_t height, uint8_t value);
 void CLOCK_Draw(void);
 
+/* 状态小部件覆盖层（见 ui_overlay.h） */
+void MENU_UpdateOverlay(void);
+void MENU_RefreshOverlay(void);
+void MENU_SetFpsVisible(uint8_t on);    // 帧率小部件开关（默认打开）
+
 /* 自动息屏功能 */
 void MENU_UpdateActivity(void);
 void MENU_CheckAutoSleep(void);
 
+/* 事件驱动等待：画面静止时阻塞到输入或下一个截止时间，代替固定的 osDelay(10) 轮询 */
+uint32_t MENU_NextDeadline(void);
+uint8_t MENU_WaitInput(uint32_t timeout);
+
 /* 倒计时功能声明已迁移到 time_task.h，避免 MENU.h 过度耦合 */
 
 /**********************************************************/
 /* use */
 
 void MENU_RunMainMenu(void);
-void MENU_RunToolsMenu(void);
-void MENU_RunGamesMenu(void);
 void MENU_Information(void);
-void MENU_RunSettingMenu(void);
 void MENU_DisplaySetting(void);
 void MENU_SleepSetting(void);
 void MENU_TimerSetting(void);
 void MENU_SystemSetting(void);
 void MENU_AboutSetting(void);
 void MENU_WIFISetting(void);
-void MENU_RunTestLongMenu(void);
+void MENU_InputRecord(void);
+void MENU_InputReplay(void);
 void MENU_RunWeatherMenu(void);
-void Update_FPS_Counter(void);
 InputEvent MENU_ReceiveInputEvent(void);
-uint32_t Get_Current_FPS(void);
 
 /* 游戏相关函数声明 */
  void Game_Dino_Init(void);
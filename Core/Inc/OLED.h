@@ -18,6 +18,14 @@
 /*********************参数宏定义*/
 
 
+/*类型定义*********************/
+
+/*传输时合成钩子：发送第Page页之前，在该页的128字节副本Line上叠加内容（不修改显存）*/
+typedef void (*OLED_ComposeHook)(uint8_t Page, uint8_t *Line);
+
+/*********************类型定义*/
+
+
 /*函数声明*********************/
 
 /*初始化函数*/
@@ -26,6 +34,7 @@ void OLED_Init(void);
 /*更新函数*/
 void OLED_Update(void);
 void OLED_UpdateArea(int16_t X, int16_t Y, uint8_t Width, uint8_t Height);
+void OLED_SetComposeHook(OLED_ComposeHook Hook);
 
 /*显存控制函数*/
 void OLED_Clear(void);
@@ -36,6 +45,10 @@ void OLED_ReverseArea(int16_t X, int16_t Y, uint8_t Width, uint8_t Height);
 /*亮度控制函数*/
 void OLED_SetBrightness(uint8_t brightness);
 
+/*睡眠控制函数*/
+void OLED_Sleep(void);
+void OLED_Wake(void);
+
 /*显示函数*/
 void OLED_ShowChar(int16_t X, int16_t Y, char Char, uint8_t FontSize);
 void OLED_ShowString(int16_t X, int16_t Y, char *String, uint8_t FontSize);
@@ -46,6 +59,7 @@ void OLED_ShowBinNum(int16_t X, int16_t Y, uint32_t Number, uint8_t Length, uint
 void OLED_ShowFloatNum(int16_t X, int16_t Y, double Number, uint8_t IntLength, uint8_t FraLength, uint8_t FontSize);
 void OLED_ShowChinese(int16_t X, int16_t Y, char *Chinese);
 void OLED_ShowImage(int16_t X, int16_t Y, uint8_t Width, uint8_t Height, const uint8_t *Image);
+void OLED_ShowImagePart(int16_t X, int16_t Y, uint8_t Width, uint8_t Height, const uint8_t *Image, uint16_t ImageWidth, uint16_t OffsetX);
 void OLED_Printf(int16_t X, int16_t Y, uint8_t FontSize, char *format, ...);
 
 /*绘图函数*/
@@ -22,4 +22,7 @@ extern osEventFlagsId_t g_appEventFlags;
 #define APP_EVT_SNTP_DONE   (1U << 2)   /* SNTP 配置已结束（成功/失败都会置位） */
 #define APP_EVT_SNTP_OK     (1U << 3)   /* SNTP 配置成功（仅成功置位） */
 
+/* 计时服务事件位定义 */
+#define APP_EVT_TIMER_DONE  (1U << 4)   /* 有计时到点（由 timer_service 置位，UI 取走事件后清除） */
+
 #endif /* __APP_EVENTS_H */
@@ -24,6 +24,8 @@ typedef struct
 void Config_Load(void);
 void Config_MarkDirty(void);
 void Config_FlushIfNeeded(void);
+void Config_Flush(void);      /* 不等待 CONFIG_FLUSH_DELAY，立即写入未保存的修改 */
+uint32_t Config_MsUntilFlush(void); /* 距延迟写入的毫秒数，没有未保存的修改时为 UINT32_MAX */
 void Config_ResetDefaults(void);
 const AppConfig *Config_Get(void);
 bool Config_SetWiFiCredentials(const char *ssid, const char *password);
@@ -8,19 +8,23 @@
 
 typedef enum
 {
-    KEY_UNPRESSED ,
-    KEY_SHORT_PRESSED ,
-    KEY_LONG_PRESSED ,
+    KEY_UNPRESSED ,     // 无变化
+    KEY_DOWN ,          // 消抖后按下
+    KEY_UP ,            // 消抖后松开
 } KeyPressState;
 
 
 void Encoder_Init(void);
 
 KeyPressState KeyPress(void);
+void Key_OnEdgeFromISR(void);              // EXTI6 双边沿中断里调用
+uint32_t KeyPress_MsUntilDeadline(void);   // 消抖到期；无待定时 UINT32_MAX
+uint32_t KeyPress_EdgeTick(void);          // 最近一次有效跳变的时刻（毫秒）
 
 // 编码器接口 - 推荐使用 input.h 的 Input_GetEvent() 获取统一事件
 int16_t Encoder_Roll(void);      // 获取消抖后的旋转格数
 int16_t Encoder_RawDelta(void);  // 获取原始增量（内部使用）
+uint32_t Encoder_MsUntilDeadline(void);    // 下一次起步窗口/限速结算；无待定时 UINT32_MAX
 
 #endif
 
@@ -10,6 +10,7 @@
 
 #include "encoder_driver.h"   
 #include <stdint.h>
+#include <stdbool.h>
 
 // 定义事件类型
 typedef enum {
@@ -17,15 +18,70 @@ typedef enum {
     INPUT_UP,      // 对应编码器逆时针
     INPUT_DOWN,    // 对应编码器顺时针
     INPUT_BACK,    // 对应按键长按
-    INPUT_ENTER    // 对应按键短按
+    INPUT_ENTER,   // 对应按键短按
+    INPUT_DOUBLE,  // 双击（第二次单击；需界面使能 INPUT_GESTURE_DOUBLE）
+    INPUT_REPEAT   // 按住自动连发（需界面使能 INPUT_GESTURE_REPEAT）
 } InputType;
 
+#define INPUT_MOD_HELD      (1U << 0)   // 旋转时按键按住（按住旋转，steps 已按 INPUT_HELD_GAIN 放大）
+
 // 定义包含数据的事件结构体
 typedef struct {
     InputType type;  // 事件类型
     int16_t value;   // 事件数据 
+    int16_t steps;   // 旋转：按转速加速后的步数（慢转时等于 value，见 input_accel.h）
+    uint16_t rate;   // 旋转：转速（格/秒），0 表示刚开始转动
+    uint32_t time;   // 产生事件的沿的时刻（HAL_GetTick 毫秒，中断里记录）；长按/连发为达到阈值的时刻
+    uint8_t mods;    // INPUT_MOD_xxx
 } InputEvent;
 
+/*
+ * 手势识别（input.c，表驱动状态机）
+ * 消抖后的按下/松开、旋转与超时按规则表转移状态并产生事件：
+ *   - 单击立即产生 ENTER（不为等双击而延迟）；使能双击时，INPUT_DOUBLE_MS 内的第二次单击产生 DOUBLE；
+ *   - 按住超过 INPUT_LONG_MS 产生 BACK；使能连发时改为按住 INPUT_REPEAT_DELAY_MS 后
+ *     每 INPUT_REPEAT_MS 产生一次 REPEAT（不再产生 BACK，松开也不产生 ENTER）；
+ *   - 使能按住旋转时，按住期间的旋转带 INPUT_MOD_HELD、步数放大，作为快速调节，松开不产生 ENTER。
+ * 手势按栈顶界面使能（UI_App.gestures），未使能的界面只看到 ENTER/BACK/UP/DOWN，行为不变。
+ */
+#define INPUT_GESTURE_DOUBLE        (1U << 0)
+#define INPUT_GESTURE_PRESS_ROTATE  (1U << 1)
+#define INPUT_GESTURE_REPEAT        (1U << 2)
+
+#define INPUT_LONG_MS           800U    // 长按
+#define INPUT_DOUBLE_MS         300U    // 双击：松开到第二次按下的最长间隔
+#define INPUT_REPEAT_DELAY_MS   400U    // 连发：按住到第一次连发
+#define INPUT_REPEAT_MS         100U    // 连发间隔
+#define INPUT_HELD_GAIN         10      // 按住旋转时每格的步数
+
+void Input_SetGestures(uint8_t gestures);   // UI 任务调用（切换栈顶界面时）
+
+/*
+ * 中断驱动的输入
+ * 按键 PB6（双边沿）与编码器 A/B 相 PA8/PA9（双边沿，保持 TIM1 编码器复用功能，只借用 EXTI 线）
+ * 的中断只记录沿的时刻并置位 InputTask 的线程标志 INPUT_FLAG_EDGE，不在中断里判定：
+ *   - InputTask 阻塞在线程标志上，超时取 Input_MsUntilDeadline（消抖到期、手势超时、编码器起步窗口、回放的下一个事件），
+ *     没有待定判定时一直阻塞，静止时没有任何周期唤醒；
+ *   - 被唤醒后反复调用 Input_GetEvent 取出全部事件，经 InputQueue_Post 合并后送入输入队列。
+ * 同一组 EXTI 线也是息屏 STOP 模式的唤醒源（见 low_power.h）。
+ */
+#define INPUT_FLAG_EDGE     (1U << 0)   // InputTask 线程标志：按键/编码器沿
+
+void Input_Init(void);                  // 配置 EXTI 线与中断（Encoder_Init 之后调用）
 InputEvent Input_GetEvent(void);
+uint32_t Input_MsUntilDeadline(void);   // InputTask 可阻塞的时长；osWaitForever 表示只等中断
+void Input_Wake(void);                  // 唤醒 InputTask 重新计算截止时间（如开始回放，见 input_replay.h）
+
+/*
+ * 按键按下时刻捕获
+ * 按键事件在松开并消抖之后才产生（还要经过界面帧），对时刻敏感的界面（秒表）
+ * 打开捕获后，EXTI6 下降沿在中断里读取 TIM5 微秒计数作为按下时刻，与消抖、松开和帧率无关。
+ * 一次按下只记第一个下降沿，之后按下与松开的抖动沿都忽略，直到消抖后的松开。
+ */
+
+uint32_t Input_TimestampUs(void);                   // 自由运行的微秒计数（32 位回绕）
+void Input_SetPressCapture(bool on);
+bool Input_PressCaptureEnabled(void);
+bool Input_TakePressStamp(uint32_t *stamp_us);      // 取走最近一次按下时刻；没有时返回 false
 
 #endif /* INC_INPUT_H_ */
@@ -0,0 +1,33 @@
+#ifndef __INPUT_ACCEL_H
+#define __INPUT_ACCEL_H
+
+#include <stdint.h>
+#include "input.h"
+
+/*
+ * 编码器转速估计与加速曲线（与硬件无关）
+ *
+ * InputTask 每次读到消抖后的格数，由 InputAccel_Rotation 根据相邻两次出格的时间间隔
+ * 估计转速（格/秒，指数平滑），再按加速曲线得到步数写入 InputEvent.steps：
+ *   - 停顿超过 INPUT_ACCEL_IDLE_MS 或反向后的第一格转速为 0，步数等于格数（慢转逐格精确）；
+ *   - 连续快速旋转时按曲线放大，长列表、大范围数值少转几圈。
+ * 需要逐格的界面（游戏等）继续使用 value；列表、数值微调使用 steps，列表还用 rate 决定惯性滚动。
+ * 曲线可在运行时替换（InputAccel_SetCurve）。仅由 InputTask 调用（非线程安全）。
+ */
+
+#define INPUT_ACCEL_IDLE_MS     150U    // 两格间隔超过此值视为重新起步（转速归零）
+#define INPUT_ACCEL_MAX_STEPS   100     // 单个事件的最大步数
+
+typedef struct
+{
+    uint16_t min_rate;      // 转速不低于此值（格/秒）时
+    uint8_t gain;           // 每格的步数
+} InputAccelPoint;
+
+/* 替换加速曲线：points 按 min_rate 升序，需在调用期间保持有效；NULL 恢复默认曲线 */
+void InputAccel_SetCurve(const InputAccelPoint *points, uint8_t count);
+
+/* 由 detents 格（正=顺时针）生成旋转事件，更新转速估计；detents 为 0 时返回 INPUT_NONE */
+InputEvent InputAccel_Rotation(int16_t detents, uint32_t now_ms);
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef __INPUT_QUEUE_H
+#define __INPUT_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "input.h"
+
+/*
+ * 输入事件投递（生产者一侧的合并与背压）
+ *
+ * InputTask 不再直接 osMessageQueuePut(..., 0)（队列满时静默丢事件），而是经 InputQueue_Post：
+ *   - 旋转事件：UI 任务跟得上（队列为空）时立即入队；队列里还有未读事件时先暂存在“尾槽”，
+ *     后续同方向的旋转把格数/步数累加进去，快速拨动在 UI 卡顿期间只占一个队列位置；
+ *     换向或有按键事件时先把尾槽入队，保持先后顺序；
+ *   - 按键事件（ENTER/BACK）绝不丢弃：队列满时阻塞等待 UI 取走（背压）；
+ *   - 队列满记一次溢出（诊断计数），阻塞投递失败才计为丢弃。
+ * 尾槽在队列排空后由 InputQueue_Flush 送出；有暂存时 InputQueue_MsUntilRetry 给出重试间隔，
+ * InputTask 据此短暂唤醒，否则一直阻塞到下一个输入中断。
+ * 录制输入时（见 input_replay.h），投递的事件在合并之前记入录制缓冲区。
+ * 仅由生产者（InputTask；主机端为脚本）调用。
+ */
+
+#define INPUT_QUEUE_RETRY_MS    4U      // 有暂存的旋转时，检查队列是否排空的间隔
+
+typedef struct
+{
+    uint32_t posted;        // 入队的事件数
+    uint32_t coalesced;     // 合并进尾槽的旋转事件数
+    uint32_t overflows;     // 投递时队列已满的次数
+    uint32_t dropped;       // 阻塞投递仍失败而丢弃的事件数（应为 0）
+    uint32_t max_depth;     // 投递时观察到的最大队列深度
+} InputQueueStats;
+
+/* 投递一个事件（INPUT_NONE 忽略） */
+void InputQueue_Post(const InputEvent *event);
+
+/* 队列已排空时送出暂存的旋转事件 */
+void InputQueue_Flush(void);
+
+/* 有暂存事件时返回重试间隔（毫秒），否则返回 UINT32_MAX */
+uint32_t InputQueue_MsUntilRetry(void);
+
+void InputQueue_GetStats(InputQueueStats *out);
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef __INPUT_REPLAY_H
+#define __INPUT_REPLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "input.h"
+
+/*
+ * 输入录制与回放（可重复的界面性能测试）
+ *
+ * 录制：InputQueue_Post 把投递的每个事件（类型、格数、步数、修饰、时刻）记入 RAM 环形缓冲区，
+ *       保留最近 INPUT_REPLAY_RECORDS 条；停止后经 InputReplay_FormatRecords 分段格式化，
+ *       由 TimeTask 通过 ESP8266 串口链路发布到 MQTT 主题 `RADAR/REPLAY`。
+ * 回放：按时刻把录制或脚本中的事件经 InputQueue_Post 送入 InputEventQueueHandle，
+ *       与旋钮产生的事件走同一条路径；目标板由 InputTask 驱动（截止时间并入 Input_MsUntilDeadline），
+ *       主机端由回归/基准程序的空闲钩子驱动（假时钟），同一脚本在两端产生相同的交互。
+ *       回放期间暂停录制；回放中有真实输入时中止回放（InputTask）。
+ * 录制与回放都从“主菜单、光标停在 Tools”开始（菜单入口先返回主菜单），脚本据此编写。
+ * 录制/回放由 UI 任务启停，记录与投递在 InputTask 中进行；停止录制后环形缓冲区不再变化。
+ */
+
+#define INPUT_REPLAY_RECORDS    128     // 录制缓冲区条数
+
+typedef struct
+{
+    uint32_t at_ms;         // 相对开始的时刻（录制缓冲区内为事件的绝对时刻）
+    int16_t value;
+    int16_t steps;
+    uint8_t type;           // InputType
+    uint8_t mods;           // INPUT_MOD_xxx
+} InputReplayStep;
+
+/* 脚本行：不加速、无修饰 */
+#define INPUT_REPLAY_STEP(at, type, v)  {(at), (v), (v), (type), 0}
+
+typedef struct
+{
+    uint32_t recorded;      // 录制的事件数（含被覆盖的）
+    uint32_t recordings;    // 完成的录制次数
+    uint32_t played;        // 回放送出的事件数
+    uint32_t replays;       // 完整播放结束的次数
+    uint32_t aborted;       // 被真实输入或停止中止的次数
+    uint32_t last_ms;       // 最近一次回放的时长
+} InputReplayStats;
+
+/* 内置脚本：滚动测试长菜单 40 格、打开天气翻 5 张卡片、玩贪吃蛇 30 秒 */
+extern const InputReplayStep g_InputReplaySession[];
+extern const uint16_t g_InputReplaySessionLen;
+
+/* 录制 */
+void InputReplay_RecordStart(void);
+void InputReplay_RecordStop(void);          // 丢弃末尾那次停止录制的确定
+bool InputReplay_Recording(void);
+void InputReplay_Record(const InputEvent *event);   // InputQueue_Post 调用
+uint16_t InputReplay_RecordCount(void);     // 缓冲区中的条数
+
+/* 从第 first 条起格式化录制内容（"at/type/value/steps/mods"，空格分隔，不含逗号），
+ * 返回写入的条数，0 表示已到末尾 */
+uint16_t InputReplay_FormatRecords(uint16_t first, char *buf, uint32_t size);
+
+/* 回放 */
+void InputReplay_Play(const InputReplayStep *steps, uint16_t count);
+bool InputReplay_PlayRecording(void);       // 没有录制内容时返回 false
+void InputReplay_Stop(void);
+bool InputReplay_Playing(void);
+
+/* 送出到点的事件，返回距下一个事件的毫秒数（没有回放时为 UINT32_MAX） */
+uint32_t InputReplay_Poll(uint32_t now_ms);
+uint32_t InputReplay_MsUntilNext(uint32_t now_ms);
+
+void InputReplay_GetStats(InputReplayStats *out);
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef __LOW_POWER_H
+#define __LOW_POWER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 低功耗管理（Tickless Idle + STOP 模式）
+ *
+ * 亮屏时空闲任务只执行 WFI（SLEEP 模式），1 kHz 节拍照常。
+ * 息屏（OLED_Sleep）且没有网络事务进行时：
+ *   - 空闲任务关闭 SysTick 与 HAL 时基，用 RTC 唤醒定时器限定时长后进入 STOP，
+ *     醒来后恢复 PLL 时钟并按 RTC 实际流逝时间补偿 FreeRTOS 节拍与 HAL_GetTick。
+ * 唤醒源：EC11 按键 PB6、编码器 A/B 相 PA8/PA9 的 EXTI 线（由 input.c 配置并常开，InputTask 本身就是中断驱动的）。
+ * 串口在 STOP 下收不到数据，因此 AT 事务期间用 LowPower_Hold/Release 禁止进入 STOP。
+ */
+
+#define LOWPOWER_STOP_MAX_MS        30000U  // 单次 STOP 最长时间（RTC 唤醒定时器 RTCCLK/16 上限约 32 s）
+
+typedef struct
+{
+    uint32_t stop_entries;          // 进入 STOP 的次数
+    uint32_t stop_ms;               // 累计处于 STOP 的时间
+    uint32_t sleep_ms;              // 累计息屏时间（STOP 驻留率 = stop_ms / sleep_ms）
+    uint32_t wakes;                 // EXTI 唤醒次数
+    uint32_t wake_latency_ms;       // 最近一次唤醒沿到面板点亮的时间（含按键松开判定）
+    uint32_t wake_latency_max_ms;
+} LowPower_Stats;
+
+void LowPower_Init(void);
+
+/* 面板进入/退出睡眠：允许/禁止 STOP，统计唤醒 */
+void LowPower_SetDisplaySleeping(bool sleeping);
+
+/* 网络事务等不允许 STOP 的区间（可嵌套） */
+void LowPower_Hold(void);
+void LowPower_Release(void);
+
+/* FreeRTOS portSUPPRESS_TICKS_AND_SLEEP 实现（空闲任务中调用，调度器已挂起） */
+void LowPower_SuppressTicksAndSleep(uint32_t xExpectedIdleTime);
+
+/* 输入 EXTI 沿（由 HAL_GPIO_EXTI_Callback 调用）：息屏期间记为一次唤醒 */
+void LowPower_OnWakeEdge(void);
+
+LowPower_Stats LowPower_GetStats(void);
+
+#endif
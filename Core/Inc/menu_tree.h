@@ -0,0 +1,76 @@
+#ifndef __MENU_TREE_H
+#define __MENU_TREE_H
+
+#include "MENU.h"
+
+/*
+ * 菜单树（X-macro）
+ *
+ * MENU_TREE 列出所有静态页面 PAGE(id, parent, ITEMS)，每个页面的选项由对应的列表宏给出
+ * （写法见 MENU.h 的 MENU_PAGE_DEFINE）。MENU.c 把它展开成 Flash 中的 const 表，
+ * 页面之间通过 SUBMENU 的子页面指针与 parent 互相链接。
+ * 自带界面的功能（定时器、天气、游戏等）以 ITEM 的函数指针进入，函数把自己的应用压入屏幕栈；
+ * 项数很多或运行时才知道内容的列表用虚拟列表页面（见 MENU.h 的 MENU_ListSource）。
+ */
+
+#define MENU_MAIN_ITEMS(ITEM, SUBMENU, VAR)                                                  \
+    ITEM("<<<", NULL)                                                                        \
+    SUBMENU("Tools", Tools)                 /* 工具 */                                       \
+    SUBMENU("Games", Games)                 /* 游戏 */                                       \
+    SUBMENU("Setting", Setting)             /* 设置 */                                       \
+    ITEM("Information", MENU_Information)   /* 信息 */                                       \
+    SUBMENU("Test Menu", TestLong)          /* 测试长菜单 */                                 \
+    ITEM("Weather", MENU_RunWeatherMenu)    /* 天气 */
+
+#define MENU_TOOLS_ITEMS(ITEM, SUBMENU, VAR)                                                 \
+    ITEM("<<<", NULL)                                                                        \
+    ITEM("Timer", MENU_TimerSetting)        /* 定时器 */                                     \
+    ITEM("Stopwatch", Stopwatch_Open)       /* 秒表 */                                       \
+    ITEM("Serial Port", NULL)               /* 串口 */                                       \
+    ITEM("Oscilloscope", NULL)              /* 示波器 */                                     \
+    ITEM("PWM Output", NULL)                /* PWM 输出 */                                   \
+    ITEM("PWM Input", NULL)                 /* PWM 输入 */                                   \
+    ITEM("ADC Input", NULL)                 /* ADC 输入 */                                   \
+    ITEM("I2C Scanner", NULL)               /* I2C扫描 */                                    \
+    ITEM("SPI Test", NULL)                  /* SPI测试 */                                    \
+    ITEM("Timer Config", NULL)              /* 定时器配置 */                                 \
+    ITEM("GPIO Control", NULL)              /* GPIO控制 */                                   \
+    ITEM("UART Logger", NULL)               /* UART日志 */                                   \
+    ITEM("Frequency Gen", NULL)             /* 频率发生器 */                                 \
+    ITEM("Voltage Meter", NULL)             /* 电压计 */                                     \
+    ITEM("Logic Analyzer", NULL)            /* 逻辑分析仪 */                                 \
+    ITEM("Signal Gen", NULL)                /* 信号发生器 */                                 \
+    ITEM("Memory Test", NULL)               /* 内存测试 */                                   \
+    ITEM("Input Record", MENU_InputRecord)  /* 输入录制 */                                   \
+    ITEM("Input Replay", MENU_InputReplay)  /* 输入回放 */
+
+#define MENU_GAMES_ITEMS(ITEM, SUBMENU, VAR)                                                 \
+    ITEM("<<<", NULL)                                                                        \
+    ITEM("Snake Game", Game_Snake_Init)     /* 贪吃蛇游戏 */                                 \
+    ITEM("Dino Game", Game_Dino_Init)       /* 恐龙跳跃游戏 */                               \
+    ITEM("Tetris", NULL)                    /* 俄罗斯方块（占位） */                         \
+    ITEM("2048", NULL)                      /* 2048游戏（占位） */                           \
+    ITEM("Pong", NULL)                      /* 乒乓球游戏（占位） */                         \
+    ITEM("Breakout", NULL)                  /* 打砖块游戏（占位） */
+
+#define MENU_SETTING_ITEMS(ITEM, SUBMENU, VAR)                                               \
+    ITEM("<<<", NULL)                                                                        \
+    ITEM("Display", MENU_DisplaySetting)    /* 显示设置 */                                   \
+    ITEM("Sleep", MENU_SleepSetting)        /* 睡眠设置 */                                   \
+    ITEM("System", MENU_SystemSetting)      /* 系统设置 */                                   \
+    ITEM("About", MENU_AboutSetting)        /* 关于 */                                       \
+    ITEM("WIFI", MENU_WIFISetting)          /* WiFi 配网 */
+
+#define MENU_TREE(PAGE)                                                                      \
+    PAGE(Main,     NULL,            MENU_MAIN_ITEMS)                                         \
+    PAGE(Tools,    &MENU_Page_Main, MENU_TOOLS_ITEMS)                                        \
+    PAGE(Games,    &MENU_Page_Main, MENU_GAMES_ITEMS)                                        \
+    PAGE(Setting,  &MENU_Page_Main, MENU_SETTING_ITEMS)
+
+#define MENU_TREE_DECLARE_(id, parent, ITEMS) MENU_PAGE_DECLARE(id);
+MENU_TREE(MENU_TREE_DECLARE_)
+
+/* 虚拟列表页面（MENU_PAGE_DEFINE_LIST，内容由数据源按需生成，定义在 MENU.c） */
+MENU_PAGE_DECLARE(TestLong);
+
+#endif
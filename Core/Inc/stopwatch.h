@@ -0,0 +1,44 @@
+#ifndef __STOPWATCH_H
+#define __STOPWATCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 毫秒秒表（带计次）
+ *
+ * 计时基准是 TIM5 的 32 位自由运行微秒计数（Input_TimestampUs），不用 1 ms 的 HAL 节拍；
+ * 计数约 71.6 分钟回绕一次，回绕圈数按 HAL 节拍推算，总时长用 64 位微秒保存。
+ * 开始/计次的时刻取自按键按下沿（EXTI6 中断里记录，见 input.h），
+ * 与消抖、松开和界面帧率无关；没有按下沿记录时退化为处理事件的时刻。
+ * 最近 STOPWATCH_LAPS 次计次保存在环形缓冲区中，更早的只保留编号。
+ * 运行中只重画并局部刷新发生变化的那几位数字。
+ * 退出界面不停止计时，再次进入继续显示。仅由 UI 任务调用。
+ *
+ * 操作：短按 开始 / 计次（暂停时继续）；旋转 暂停（暂停时翻看计次）；
+ *       长按 暂停时清零，其余情况返回（计时在后台继续）。
+ */
+
+#define STOPWATCH_LAPS  8       // 保存的计次数
+
+typedef struct
+{
+    uint32_t laps;              // 累计计次数
+    uint32_t stamped;           // 使用按下沿时刻的开始/计次数
+    uint32_t fallback;          // 没有按下沿记录、用事件处理时刻的次数
+    uint32_t lag_last_us;       // 最近一次：按下沿到界面处理该事件的延迟
+    uint32_t lag_max_us;        // （即不用按下沿时刻会带来的误差）
+} StopwatchStats;
+
+/* 打开秒表界面（菜单选项） */
+void Stopwatch_Open(void);
+
+/* 正在计时（包括界面已退出、在后台计时） */
+bool Stopwatch_Running(void);
+
+/* 当前总时长（微秒） */
+uint64_t Stopwatch_ElapsedUs(void);
+
+void Stopwatch_GetStats(StopwatchStats *out);
+
+#endif
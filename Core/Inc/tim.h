@@ -41,6 +41,8 @@ extern TIM_HandleTypeDef htim1;
 void MX_TIM1_Init(void);
 
 /* USER CODE BEGIN Prototypes */
+void TIM5_TimestampInit(void);
+#define TIM5_TIMESTAMP_US()   (TIM5->CNT)
 
 /* USER CODE END Prototypes */
 
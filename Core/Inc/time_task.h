@@ -11,11 +11,15 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
+#include "timer_service.h"
 
 /* SNTP 配置 */
 #define SNTP_TIMEZONE       8                    // 时区：东八区（中国）
 #define SNTP_SERVER         "ntp.aliyun.com"     // NTP 服务器
 
+/* 倒计时设置 */
+#define TIMER_STEP_SECONDS  5                    // 调节时间每步的秒数（快速旋转由输入层加速）
+
 /* 时间结构体 */
 typedef struct {
     uint16_t year;
@@ -49,16 +53,16 @@ bool SNTP_GetTime(SNTP_Time_t* time);
  */
 bool SNTP_GetTimeString(char* buf, size_t buf_size);
 
-/* ========= 倒计时功能（从 MENU.c 迁移到 time_task.c） ========= */
-extern uint8_t timer_enabled;          // 定时器启用标志 (0=关闭, 1=启用)
-extern uint16_t timer_seconds;         // 定时器时间(秒)
-extern uint16_t timer_current;         // 当前定时器剩余时间
-extern uint32_t timer_start_time;      // 定时器开始时间
+/* ========= 倒计时功能（基于 timer_service，到点由软件定时器回调通知） ========= */
+extern uint16_t timer_seconds;         // 定时器设定时间(秒)，保存在配置中
 
 void MENU_StartTimer(uint16_t seconds);
 void MENU_StopTimer(void);
-uint8_t MENU_UpdateTimer(void);
-void MENU_ShowTimer(int16_t x, int16_t y);
+bool MENU_TimerRunning(void);
+uint16_t MENU_TimerRemaining(void);     // 显示用剩余秒数
+TimerSvcId MENU_TimerId(void);          // 倒计时所在的计时槽位（未运行时为 TIMER_SVC_NONE）
+void MENU_ServiceTimers(void);          // 取走到点事件并弹出提示（UI 任务每轮调用）
+void MENU_ShowTimer(void);
 void MENU_ShowTimeUpAlert(void);
 
 void MENU_TimerSetting(void);
@@ -0,0 +1,74 @@
+#ifndef __TIMER_SERVICE_H
+#define __TIMER_SERVICE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 倒计时 / 提醒服务
+ *
+ * 最多 TIMER_SVC_MAX 个计时同时运行，每个槽位对应一个 FreeRTOS 软件定时器（CMSIS osTimer）：
+ *   - 到点由定时器服务任务回调，标记该槽位“待处理”并置位 APP_EVT_TIMER_DONE，
+ *     不依赖哪个界面正在运行、也不需要任何循环逐帧检查；
+ *   - 周期提醒（repeat）到点后自动按原周期重新计时，每次到点各产生一次待处理事件。
+ * UI 任务用 TimerSvc_TakeExpired 逐个取走到点事件（弹窗提示等）。
+ * 剩余时间按启动时刻现算，显示用“剩余整秒数”（向上取整，与倒计时习惯一致）：
+ *   - TimerSvc_Watch 比较调用方保存的上一次视图，只有显示的秒数或状态变化时返回 true，
+ *     界面据此决定是否重新格式化/重画；
+ *   - TimerSvc_MsUntilChange 给出下一次秒数变化的时间，帧循环据此安排唤醒。
+ * 启动/停止与查询由 UI 任务调用；到点回调在定时器服务任务中运行，只改写槽位的状态字。
+ */
+
+#define TIMER_SVC_MAX       4       // 同时运行的计时数
+#define TIMER_SVC_LABEL_MAX 14      // 名称最大字符数（与弹窗一行文本一致）
+#define TIMER_SVC_NONE      (-1)
+
+typedef int8_t TimerSvcId;
+
+typedef enum
+{
+    TIMER_SVC_IDLE = 0,
+    TIMER_SVC_RUNNING,
+    TIMER_SVC_EXPIRED,      // 一次性计时已到点，等待 TimerSvc_TakeExpired 取走
+} TimerSvcState;
+
+/* 界面保存的显示状态：TimerSvc_Watch 与之比较 */
+typedef struct
+{
+    uint8_t state;          // TimerSvcState
+    uint32_t remaining_s;
+} TimerSvcView;
+
+/* 创建各槽位的软件定时器（内核启动前或 UI 任务开始前调用一次） */
+void TimerSvc_Init(void);
+
+/* 启动一个计时，返回槽位；没有空闲槽位或时长为 0 时返回 TIMER_SVC_NONE */
+TimerSvcId TimerSvc_Start(const char *label, uint32_t duration_ms, bool repeat);
+
+/* 停止并释放槽位（未取走的到点事件一并丢弃） */
+void TimerSvc_Stop(TimerSvcId id);
+
+/* 停止全部计时 */
+void TimerSvc_StopAll(void);
+
+TimerSvcState TimerSvc_State(TimerSvcId id);
+const char *TimerSvc_Label(TimerSvcId id);
+
+/* 剩余毫秒数 / 显示用剩余秒数（向上取整）；未运行时为 0 */
+uint32_t TimerSvc_RemainingMs(TimerSvcId id);
+uint32_t TimerSvc_RemainingSeconds(TimerSvcId id);
+
+/* 刷新 view；显示内容（状态或剩余秒数）有变化时返回 true */
+bool TimerSvc_Watch(TimerSvcId id, TimerSvcView *view);
+
+/* 距 id 的显示秒数下一次变化的毫秒数；未运行时返回 UINT32_MAX */
+uint32_t TimerSvc_MsUntilChange(TimerSvcId id);
+
+/* 距最近一个计时到点的毫秒数，至少为 1：已到点而回调还没标记时，调用方短暂等待后再看，
+   不会拿 0 当作“不限时”或忙等；没有运行中的计时返回 UINT32_MAX */
+uint32_t TimerSvc_MsUntilExpiry(void);
+
+/* 取走一个到点事件，返回其槽位（一次性计时随之释放）；没有时返回 TIMER_SVC_NONE */
+TimerSvcId TimerSvc_TakeExpired(void);
+
+#endif
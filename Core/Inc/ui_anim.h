@@ -0,0 +1,68 @@
+#ifndef __UI_ANIM_H
+#define __UI_ANIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 界面动画引擎（Q16 定点，按毫秒推进）
+ *
+ * 动画状态保存在固定大小的槽位池中，调用者只持有槽位编号（UI_AnimId），
+ * 因此多个菜单/控件可以同时各自播放动画，互不干扰。
+ *   - 补间 (tween)：在给定时长内按缓动曲线从当前值走到目标值；
+ *   - 弹簧 (spring)：阻尼弹簧追随目标值，阻尼比 < 1 时带过冲（果冻效果）。
+ * 每帧调用一次 UI_Anim_Update(HAL_GetTick())，动画进度只取决于流逝的时间，与帧率无关。
+ * 全部静止时不必调用（界面可以阻塞等待输入）：之后开始的动画从下一次 UI_Anim_Update 起计时。
+ * 全部槽位静止时 UI_Anim_AllSettled() 返回 true，可据此判断界面空闲。
+ * 仅由 UI 任务调用（非线程安全）。
+ */
+
+typedef int32_t q16_t;                                  // 16.16 定点数
+
+#define Q16_ONE             ((q16_t)1 << 16)
+#define Q16(x)              ((q16_t)((x) * 65536.0))    // 编译期常量转换（仅用于常量）
+#define Q16_FROM_INT(n)     ((q16_t)(n) * Q16_ONE)
+#define Q16_ROUND(q)        ((int16_t)(((q) + (Q16_ONE / 2)) >> 16))   // 四舍五入到整数像素
+
+#define UI_ANIM_SLOTS       32      // 同时存在的动画槽位数
+#define UI_ANIM_MAX_STEP_MS 50U     // 单次推进的最大时长：卡顿/长时间未刷新后不会一步跳到终点
+
+typedef uint8_t UI_AnimId;          // 槽位编号，UI_ANIM_NONE 表示未分配
+#define UI_ANIM_NONE        0U
+
+typedef enum
+{
+    UI_EASE_LINEAR = 0,
+    UI_EASE_OUT_QUAD,
+    UI_EASE_OUT_CUBIC,
+} UI_AnimEase;
+
+/* 分配一个槽位，初值 initial（静止）；池满时返回 UI_ANIM_NONE */
+UI_AnimId UI_Anim_Alloc(q16_t initial);
+
+/* 释放槽位并把 *id 置为 UI_ANIM_NONE */
+void UI_Anim_Free(UI_AnimId *id);
+
+/* 立即跳到 value 并静止 */
+void UI_Anim_Set(UI_AnimId id, q16_t value);
+
+/* 从当前值补间到 target；目标未变时不重新开始 */
+void UI_Anim_TweenTo(UI_AnimId id, q16_t target, uint16_t duration_ms, UI_AnimEase ease);
+
+/* 以弹簧追随 target（保留当前速度）；omega 为固有角频率 (rad/s)，zeta 为阻尼比，均为 Q16 */
+void UI_Anim_SpringTo(UI_AnimId id, q16_t target, q16_t omega, q16_t zeta);
+
+q16_t UI_Anim_Value(UI_AnimId id);
+q16_t UI_Anim_Target(UI_AnimId id);
+bool UI_Anim_IsSettled(UI_AnimId id);
+
+/* 把所有槽位推进到 now_ms */
+void UI_Anim_Update(uint32_t now_ms);
+
+/* 所有已分配的槽位都已静止 */
+bool UI_Anim_AllSettled(void);
+
+/* 已分配的槽位数（调试用） */
+uint8_t UI_Anim_InUse(void);
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef __UI_OVERLAY_H
+#define __UI_OVERLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 状态小部件覆盖层（FPS、倒计时、网络状态等）
+ *
+ * 小部件不画进 OLED_DisplayBuf，而是各自保存一份预渲染的 6x8 字模，
+ * 在传输时经 OLED 合成钩子叠加到发送的数据上：
+ *   - Overlay_Present()  整屏发送显存 + 全部小部件（菜单帧使用）
+ *   - Overlay_Refresh()  只把内容变化的小部件区域用 OLED_UpdateArea 发送，
+ *                        底层画面不必因为倒计时跳了一秒而整屏重发
+ * 仅由 UI 任务调用（非线程安全）。
+ */
+
+#define OVERLAY_TEXT_MAX    8       // 每个小部件最多字符数
+
+typedef enum
+{
+    OVERLAY_FPS = 0,    // 左上角帧率
+    OVERLAY_TIMER,      // 右上角倒计时
+    OVERLAY_NET,        // 左下角网络状态
+    OVERLAY_COUNT
+} OverlayId;
+
+/* 设置小部件文本；NULL 或空串表示隐藏。内容不变时不标记刷新 */
+void Overlay_SetText(OverlayId id, const char *text);
+
+/* 整屏发送：显存 + 所有可见小部件 */
+void Overlay_Present(void);
+
+/* 局部刷新：只发送内容有变化的小部件所在区域 */
+void Overlay_Refresh(void);
+
+/* 是否有待刷新的小部件 */
+bool Overlay_IsDirty(void);
+
+/* 合成函数（OLED_ComposeHook）：把与第 page 页相交的小部件叠加到 line 上 */
+void Overlay_Compose(uint8_t page, uint8_t *line);
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef __UI_POPUP_H
+#define __UI_POPUP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "input.h"
+
+/*
+ * 弹窗 / 提示条层
+ *
+ * 弹窗不画进 OLED_DisplayBuf：文本框预渲染为位图，和状态小部件一样在传输时经合成钩子
+ * 叠加（Overlay_Compose 最后调用 Popup_Compose，弹窗在最上层）。
+ *   - POPUP_TOAST  底部提示条，不拦截输入，到时自动消失
+ *   - POPUP_MODAL  居中对话框，任意输入确认并被吞掉；duration_ms 为 0 时一直等到确认
+ * 多个弹窗按到达顺序排队，依次从底部滑入、滑出（ui_anim 补间）。
+ * 弹窗移动或内容变化时只用 OLED_UpdateArea 刷新新旧位置的并集，底层页面照常绘制与动画，
+ * 弹窗滑走后露出的区域直接来自显存，不需要页面重画。
+ * 帧循环每轮调用 Popup_Tick 推进状态，绘制之后调用 Popup_Refresh 发送脏区域。
+ * 仅由 UI 任务调用（非线程安全）；其他任务的事件经事件标志/队列交给 UI 任务再弹出。
+ */
+
+#define POPUP_QUEUE_LEN     4       // 排队中的弹窗数（不含正在显示的）
+#define POPUP_TEXT_MAX      14      // 文本最大字符数（8x16 字体，一行）
+#define POPUP_SLIDE_MS      150     // 滑入/滑出时长
+
+typedef enum
+{
+    POPUP_TOAST = 0,
+    POPUP_MODAL,
+} PopupKind;
+
+/* 加入队列；队列满时返回 false */
+bool Popup_Show(const char *text, PopupKind kind, uint32_t duration_ms);
+
+/* 有弹窗正在显示或排队 */
+bool Popup_IsActive(void);
+
+/* 输入先交给弹窗：模态弹窗确认并吞掉事件时返回 true */
+bool Popup_HandleInput(const InputEvent *event);
+
+/* 推进状态与动画；返回距离下一次变化的毫秒数，0 表示动画中，UINT32_MAX 表示无弹窗 */
+uint32_t Popup_Tick(uint32_t now_ms);
+
+/* 弹窗位置/内容有变化时局部刷新新旧区域 */
+void Popup_Refresh(void);
+
+/* 整屏发送时已带上当前弹窗（由 Overlay_Present 调用） */
+void Popup_Presented(void);
+
+/* 合成函数：把弹窗与第 page 页相交的部分叠加到 line 上（由 Overlay_Compose 调用） */
+void Popup_Compose(uint8_t page, uint8_t *line);
+
+#endif
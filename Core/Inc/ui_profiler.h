@@ -0,0 +1,88 @@
+#ifndef __UI_PROFILER_H
+#define __UI_PROFILER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 帧耗时分析器（取代原来每秒一个整数的 FPS 计数）
+ *
+ * 帧循环在每个阶段开始时调用 Profiler_Phase，分析器用高精度计时器（目标板为 DWT 周期计数器，
+ * 主机端为假时钟）把上一阶段的耗时记到该阶段名下。Screen_Run 的每一轮是一帧：
+ *   - PROFILER_INPUT     读取并处理输入
+ *   - PROFILER_LAYOUT    动画推进、小部件/弹窗状态、配置保存等逻辑
+ *   - PROFILER_RASTER    界面绘制到显存、过渡合成
+ *   - PROFILER_TRANSFER  显存经 SPI 发送（整屏与局部刷新）
+ *   - PROFILER_IDLE      阻塞等待输入或下一帧
+ * 发送过画面的帧计入统计：每个阶段与整帧忙碌时间（除空闲外之和）各有一个固定分桶直方图，
+ * 由此得到 min/avg/p95/p99/max（百分位取所在桶的上界，分辨率见 ui_profiler.c 的分桶表）；
+ * 最近 PROFILER_SPARK_LEN 帧的忙碌时间保存为滚动折线，可叠加在屏幕左上角 FPS 旁边。
+ * 另有一个输入延迟直方图：输入事件的沿（InputEvent.time，中断里记录）到处理完该事件、
+ * 画面送出的时长（毫秒分辨率），即手指动作到屏幕响应的时间。
+ * 统计从 Profiler_Init/Profiler_Reset 起累计，适合长时间拷机；Profiler_Format 输出一行
+ * 文本（不含逗号，可直接作为 MQTT 消息或串口日志）。
+ * 计时与累计仅由 UI 任务调用；其他任务读取报告时可能与正在记录的一帧交错，只影响一帧数据。
+ */
+
+#define PROFILER_BUCKETS    16      // 直方图桶数（最后一桶为溢出）
+#define PROFILER_SPARK_LEN  32      // 滚动折线的帧数（每帧一列）
+
+typedef enum
+{
+    PROFILER_INPUT = 0,
+    PROFILER_LAYOUT,
+    PROFILER_RASTER,
+    PROFILER_TRANSFER,
+    PROFILER_IDLE,
+    PROFILER_PHASES,
+    PROFILER_FRAME = PROFILER_PHASES,   // 整帧忙碌时间（统计用）
+} ProfilerPhase;
+
+typedef struct
+{
+    uint32_t count;         // 样本数（帧数）
+    uint32_t min_us;
+    uint32_t avg_us;
+    uint32_t p95_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+} ProfilerStats;
+
+/* 启动计时器并清空统计 */
+void Profiler_Init(void);
+
+/* 清空统计（拷机开始前等） */
+void Profiler_Reset(void);
+
+/* 结束上一帧并开始新一帧的输入阶段 */
+void Profiler_FrameBegin(void);
+
+/* 进入 phase 阶段，返回之前所在的阶段（嵌套的子过程结束时用它恢复） */
+ProfilerPhase Profiler_Phase(ProfilerPhase phase);
+
+/* 本帧向屏幕发送了整屏画面（MENU_Display/MENU_Present 调用），同时计算 FPS */
+void Profiler_Presented(void);
+
+/* 最近一秒发送的帧数 */
+uint32_t Profiler_Fps(void);
+
+/* 读取某阶段（或 PROFILER_FRAME）的统计 */
+void Profiler_GetStats(ProfilerPhase phase, ProfilerStats *out);
+
+/* 记录一个输入事件从沿到画面送出的延迟（毫秒） */
+void Profiler_InputLatency(uint32_t ms);
+
+/* 读取输入延迟的统计 */
+void Profiler_GetInputStats(ProfilerStats *out);
+
+/* 格式化一行统计报告，返回写入的长度 */
+int Profiler_Format(char *buf, uint32_t size);
+
+/* 叠加显示滚动折线（FPS 右侧，一页高） */
+void Profiler_SetGraph(bool on);
+bool Profiler_GraphEnabled(void);
+
+/* 合成函数：由 Overlay_Compose 调用，把折线叠加到第 page 页 */
+void Profiler_Compose(uint8_t page, uint8_t *line);
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef __UI_SCREEN_H
+#define __UI_SCREEN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "input.h"
+#include "ui_transition.h"
+
+/*
+ * 屏幕栈与应用生命周期
+ *
+ * 每个界面（菜单页、设置页、信息页……）注册为一个 UI_App，提供
+ * onEnter / onFrame / onInput / onExit 回调，由 Screen_Run 的单一帧循环驱动栈顶屏幕：
+ *   息屏判定 -> 倒计时到点弹窗 -> 输入分发 -> 绘制 -> 设置落盘 -> 等待
+ * 进入子界面只是压栈、返回只是出栈，调用深度不随导航层级增长；
+ * 息屏、帧调度、事件驱动等待和落盘都集中在这里，各界面不再各自轮询。
+ * 回调里可以调用 Screen_Push / Screen_Pop，变化在下一步生效。
+ * 压栈/出栈按 UI_App.transition 播放过渡（见 ui_transition.h）：新界面只绘制一次，
+ * 过渡期间不调用 onFrame，由离屏画面合成，结束后整屏重画一次，再继续界面自己的动画。
+ * 仅由 UI 任务调用（非线程安全）。
+ */
+
+#define UI_SCREEN_DEPTH     8               // 屏幕栈深度
+#define UI_FRAME_MS         10U             // 动画播放中的帧间隔
+#define UI_SCREEN_IDLE      0xFFFFFFFFU     // onFrame 返回值：画面静止，阻塞到输入或下一个截止时间
+
+typedef struct _UI_App
+{
+    const char *name;
+    void (*onEnter)(void *ctx);                             // 压栈时（可为 NULL）
+    uint32_t (*onFrame)(void *ctx, bool full);              // 绘制；full 为需要整屏重画（进入、返回、弹窗之后）
+                                                            // 返回可等待的毫秒数：0 = 动画中，按 UI_FRAME_MS 继续
+    void (*onInput)(void *ctx, const InputEvent *event);    // 输入事件（活动时间已由帧循环更新）
+    void (*onExit)(void *ctx);                              // 出栈时（可为 NULL）
+    void (*onResume)(void *ctx);                            // 上层屏幕退出、重新回到栈顶（可为 NULL）
+    UI_TransitionKind transition;                           // 压栈/出栈时的过渡效果（默认无）
+    uint8_t gestures;                                       // 使能的输入手势 INPUT_GESTURE_xxx（默认无，见 input.h）
+} UI_App;
+
+/* 压入新屏幕并调用其 onEnter；栈满时返回 false */
+bool Screen_Push(const UI_App *app, void *ctx);
+
+/* 弹出栈顶屏幕（调用 onExit），下层屏幕 onResume 并整屏重画 */
+void Screen_Pop(void);
+
+/* 弹出全部屏幕（依次调用 onExit，不调用 onResume），用于 UI 任务重新进入帧循环之前 */
+void Screen_Reset(void);
+
+/* 当前栈深度 */
+uint8_t Screen_Depth(void);
+
+/* 下一帧整屏重画 */
+void Screen_Invalidate(void);
+
+/* 驱动栈顶屏幕，直到栈空返回 */
+void Screen_Run(void);
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef __UI_TRANSITION_H
+#define __UI_TRANSITION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 屏幕过渡合成
+ *
+ * 切换界面时把旧画面、新画面各拷贝一次到离屏缓冲（各 1 KB，与 OLED_DisplayBuf 同布局），
+ * 过渡期间每帧只按进度从两张缓冲合成到显存，不再重画任何界面内容，
+ * 每帧开销固定（8 页 × 128 字节的拷贝/掩码），与界面复杂度无关。
+ *   - UI_TRANSITION_SLIDE  新画面从右侧盖上旧画面（返回时旧画面向右滑走露出新画面）
+ *   - UI_TRANSITION_PUSH   新画面把旧画面推出屏幕（返回时方向相反）
+ *   - UI_TRANSITION_FADE   4x4 有序抖动掩码逐级替换像素
+ * 用法：Transition_Arm 保存当前显存为旧画面 -> 绘制新画面（此时 MENU_Display 不发送）
+ *       -> Transition_Start 保存新画面 -> 每帧 Transition_Step 合成到显存并发送，返回 false 时结束，
+ *       显存恢复为完整的新画面。
+ * 仅由 UI 任务调用（非线程安全）。
+ */
+
+#define UI_TRANSITION_MS    180U    // 过渡时长
+
+typedef enum
+{
+    UI_TRANSITION_NONE = 0,
+    UI_TRANSITION_SLIDE,
+    UI_TRANSITION_PUSH,
+    UI_TRANSITION_FADE,
+} UI_TransitionKind;
+
+/* 保存当前显存为旧画面，等待新画面；backward 为返回方向 */
+void Transition_Arm(UI_TransitionKind kind, bool backward);
+
+/* 已保存旧画面、尚未开始（新画面绘制中，不应发送到屏幕） */
+bool Transition_IsArmed(void);
+
+/* 保存当前显存为新画面并开始过渡 */
+void Transition_Start(uint32_t now_ms);
+
+/* 过渡进行中 */
+bool Transition_IsRunning(void);
+
+/* 按 now_ms 的进度把一帧合成到显存；过渡结束（显存为新画面）时返回 false */
+bool Transition_Step(uint32_t now_ms);
+
+/* 放弃过渡（息屏、栈清空等） */
+void Transition_Cancel(void);
+
+#endif
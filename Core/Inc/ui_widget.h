@@ -0,0 +1,53 @@
+#ifndef __UI_WIDGET_H
+#define __UI_WIDGET_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 设置/信息页面控件
+ *
+ * 每个控件是一份只读描述（通常放在 Flash），Widget_Push 把它作为屏幕压入屏幕栈（见 ui_screen.h）：
+ *   - UI_WIDGET_TEXT     静态文本页：标题 + 最多 3 行文本，确定/返回退出
+ *   - UI_WIDGET_SLIDER   滑块：标签、数值与进度条，旋钮按 step 调整
+ *   - UI_WIDGET_SPINNER  数值微调：按输入层的加速步数调整（见 input_accel.h），快速旋转时步进放大
+ *   - UI_WIDGET_TOGGLE   开关：顺时针打开、逆时针关闭
+ * 数值控件使能按住旋转（见 input.h）：按住按键旋转时步数放大 INPUT_HELD_GAIN 倍，作为快速调节，松开不退出。
+ * 数值通过 get/set 回调读写，set 立即生效（如亮度）；退出时数值有变化才标记配置待保存。
+ * 进入、返回与弹窗之后整屏重画；之后只有数值变化时重画数值区域并局部刷新，
+ * 其余帧只刷新状态小部件，静止时阻塞到输入或下一个截止时间，不占用 CPU。
+ * 仅由 UI 任务调用（非线程安全）。
+ */
+
+#define UI_WIDGET_TEXT_MAX      24      // 格式化文本的最大长度（含结束符）
+#define UI_WIDGET_LINES         3       // 文本页的正文行数
+
+typedef enum
+{
+    UI_WIDGET_TEXT = 0,
+    UI_WIDGET_SLIDER,
+    UI_WIDGET_SPINNER,
+    UI_WIDGET_TOGGLE,
+} UI_WidgetKind;
+
+typedef struct _UI_Widget
+{
+    UI_WidgetKind kind;
+    const char *title;                                  // 标题，第 0 行居中（可为 NULL）
+
+    /* 文本页 */
+    const char *(*line)(uint8_t row, char *buf);        // 第 row 行 (0 ~ UI_WIDGET_LINES-1) 的内容：写入 buf 或返回常量，NULL 为空行
+
+    /* 数值控件 */
+    const char *label;                                  // 数值左侧的标签
+    const char *hint;                                   // 底部提示（可为 NULL）
+    int32_t min, max, step;                             // 范围与单步（开关为 0 ~ 1）
+    int32_t (*get)(void);                               // 读取当前值
+    void (*set)(int32_t value);                         // 写入新值（立即生效）
+    void (*format)(int32_t value, char *buf);           // 数值显示格式，NULL 时为十进制（开关为 ON/OFF）
+} UI_Widget;
+
+/* 把控件作为屏幕压栈；栈满时返回 false */
+bool Widget_Push(const UI_Widget *widget);
+
+#endif
@@ -16,11 +16,11 @@ typedef struct {
 } WeatherData_t;
 
 
-/* 初始化默认数据（可选：Weather_Run 内部也会懒初始化） */
+/* 初始化默认数据（可选：进入界面时也会懒初始化） */
 void Weather_InitDefault(void);
 
-/* 运行天气全屏界面（旋钮左右切换城市，按键退出） */
-void Weather_Run(void);
+/* 压入天气全屏界面（旋钮左右切换城市，按键退出；不阻塞，由 Screen_Run 驱动） */
+void Weather_Open(void);
 
 /* 数据访问接口：便于后续 API 更新天气 */
 size_t Weather_GetCityCount(void);
@@ -7,34 +7,7 @@
 #include <math.h>
 #include "MENU.h"
 #include "input.h"
-#include "cmsis_os.h"
-
-/* 输入事件队列：由 InputTask 生产（读硬件），各 UI/游戏从队列消费 */
-extern osMessageQueueId_t InputEventQueueHandle;
-
-static void Game_FlushInputEvents(void)
-{
-    if (!InputEventQueueHandle) return;
-    InputEvent evt;
-    while (osMessageQueueGet(InputEventQueueHandle, &evt, NULL, 0) == osOK) {
-        /* discard */
-    }
-}
-
-static InputEvent Game_ReceiveInputEvent(uint32_t timeout_ms)
-{
-    InputEvent evt;
-    evt.type = INPUT_NONE;
-    evt.value = 0;
-
-    if (!InputEventQueueHandle) return evt;
-    if (osMessageQueueGet(InputEventQueueHandle, &evt, NULL, timeout_ms) == osOK) {
-        return evt;
-    }
-    evt.type = INPUT_NONE;
-    evt.value = 0;
-    return evt;
-}
+#include "ui_screen.h"
 
 // 游戏对象位置结构体
 struct Object_Position{
@@ -136,73 +109,7 @@ void Show_Dino(void)
 // 碰撞检测函数，传入两个结构体的地址
 int isColliding(struct Object_Position *a,struct Object_Position *b)
 {
-    if((a->maxX>b->minX)&&(a->minX<b->maxX)&&(a->maxY>b->minY)&&(a->minY<b->maxY))
-    {
-        OLED_Clear();
-        OLED_ShowString(28,24,"Game Over",OLED_8X16);
-        OLED_ShowString(24,40,"Score:",OLED_6X8);
-        OLED_ShowNum(60,40,Score,3,OLED_6X8);
-        OLED_Update();
-        
-        // 等待按键退出
-        while(1)
-        {
-            InputEvent event = Game_ReceiveInputEvent(50);
-            if(event.type == INPUT_ENTER)
-            {
-                MENU_UpdateActivity();
-                break;
-            }
-        }
-        return 1;
-    }
-    return 0;
-}
-
-// 游戏主循环
-int DinoGame_Animation(void)
-{
-    while(1)
-    {
-        int return_flag;
-
-        /* 输入从队列获取（避免与 InputTask 抢 Input_GetEvent） */
-        InputEvent event = Game_ReceiveInputEvent(0);
-        if (event.type != INPUT_NONE) {
-            MENU_UpdateActivity();
-        }
-
-        // 检查是否按了返回键退出游戏
-        if(event.type == INPUT_BACK || event.type == INPUT_ENTER)
-        {
-            return 0;
-        }
-
-        // 旋转触发跳跃（只在非跳跃状态时触发）
-        if((event.type == INPUT_UP || event.type == INPUT_DOWN) && dino_jump_flag == 0)
-        {
-            dino_jump_flag = 1;
-        }
-        
-        // 更新游戏状态 - 关键修复！
-        Dino_Tick();
-        
-        OLED_Clear();
-        Show_Score();
-        Show_Ground();
-        Show_Barrier();
-        Show_Cloud();
-        Show_Dino();
-        OLED_Update();
-        
-        return_flag=isColliding(&dino,&barrier);
-        if(return_flag==1)
-        {
-            return 0;
-        }
-        
-        osDelay(40); // 控制游戏速度
-    }
+    return (a->maxX>b->minX)&&(a->minX<b->maxX)&&(a->maxY>b->minY)&&(a->minY<b->maxY);
 }
 
 void Dino_Tick(void)
@@ -252,33 +159,133 @@ void DinoGame_Pos_Init(void)
     barrier_flag=0;
 }
 
-// 游戏初始化和启动
-void Game_Dino_Init(void)
+/* 恐龙跳跃作为屏幕栈上的应用（见 ui_screen.h）：由 Screen_Run 驱动，
+   奔跑中每 DINO_FRAME_MS 推进一帧，帧间阻塞在输入队列上；开始与结束画面静止时只等按键 */
+#define DINO_FRAME_MS   40U     // 控制游戏速度
+
+typedef enum {
+    DINO_TITLE,     // 开始画面，按键开始
+    DINO_RUN,       // 奔跑中
+    DINO_OVER,      // 撞上障碍，按键退出
+} DinoState;
+
+static DinoState Dino_State;
+static uint32_t Dino_NextFrame;  // 下一帧的时刻
+
+static void DinoGame_Draw(void)
 {
-    /* 进入游戏前先清空积压输入，避免误触发 */
-    Game_FlushInputEvents();
+    OLED_Clear();
+    switch(Dino_State)
+    {
+        case DINO_TITLE:
+            OLED_ShowString(32, 16, "Dino Game", OLED_8X16);
+            OLED_ShowString(8, 32, "Rotate to Jump", OLED_6X8);
+            OLED_ShowString(8, 40, "PA2 to Start/Exit", OLED_6X8);
+            break;
+
+        case DINO_RUN:
+            Show_Score();
+            Show_Ground();
+            Show_Barrier();
+            Show_Cloud();
+            Show_Dino();
+            break;
+
+        case DINO_OVER:
+            OLED_ShowString(28,24,"Game Over",OLED_8X16);
+            OLED_ShowString(24,40,"Score:",OLED_6X8);
+            OLED_ShowNum(60,40,Score,3,OLED_6X8);
+            break;
+    }
+    MENU_Display();
+}
 
-    // 初始化游戏状态
+static void DinoGame_Enter(void *ctx)
+{
+    (void)ctx;
     DinoGame_Pos_Init();
-    
-    // 显示游戏开始画面
-    OLED_Clear();
-    OLED_ShowString(32, 16, "Dino Game", OLED_8X16);
-    OLED_ShowString(8, 32, "Rotate to Jump", OLED_6X8);
-    OLED_ShowString(8, 40, "PA2 to Start/Exit", OLED_6X8);
-    OLED_Update();
-    
-    // 等待按键开始游戏
-    while(1)
+    Dino_State = DINO_TITLE;
+}
+
+static uint32_t DinoGame_Frame(void *ctx, bool full)
+{
+    uint32_t now = HAL_GetTick();
+    (void)ctx;
+
+    if(Dino_State != DINO_RUN)
     {
-        InputEvent event = Game_ReceiveInputEvent(50);
-        if(event.type == INPUT_ENTER)
-        {
-            MENU_UpdateActivity();
+        if(full) DinoGame_Draw();
+        else MENU_RefreshOverlay();
+        return UI_SCREEN_IDLE;
+    }
+
+    if((int32_t)(now - Dino_NextFrame) < 0)
+    {
+        if(full) DinoGame_Draw();
+        return Dino_NextFrame - now;
+    }
+
+    // 更新游戏状态，绘制时同时更新碰撞框
+    Dino_Tick();
+    DinoGame_Draw();
+    if(isColliding(&dino,&barrier))
+    {
+        Dino_State = DINO_OVER;
+        DinoGame_Draw();
+        return UI_SCREEN_IDLE;
+    }
+
+    Dino_NextFrame += DINO_FRAME_MS;
+    if((int32_t)(now - Dino_NextFrame) >= 0) Dino_NextFrame = now + DINO_FRAME_MS; // 息屏或卡顿后不补帧
+    return Dino_NextFrame - now;
+}
+
+static void DinoGame_Input(void *ctx, const InputEvent *event)
+{
+    (void)ctx;
+
+    switch(Dino_State)
+    {
+        case DINO_TITLE:
+            if(event->type == INPUT_ENTER) // 按键开始游戏
+            {
+                Dino_State = DINO_RUN;
+                Dino_NextFrame = HAL_GetTick();
+            }
+            break;
+
+        case DINO_RUN:
+            // 检查是否按了返回键退出游戏
+            if(event->type == INPUT_BACK || event->type == INPUT_ENTER)
+            {
+                Screen_Pop();
+            }
+            // 旋转触发跳跃（只在非跳跃状态时触发）
+            else if((event->type == INPUT_UP || event->type == INPUT_DOWN) && dino_jump_flag == 0)
+            {
+                dino_jump_flag = 1;
+            }
+            break;
+
+        case DINO_OVER:
+            if(event->type == INPUT_ENTER) // 按键退出
+            {
+                Screen_Pop();
+            }
             break;
-        }
     }
-    
-    // 开始游戏
-    DinoGame_Animation();
+}
+
+static const UI_App DinoGame_App = {
+    .name = "dino",
+    .onEnter = DinoGame_Enter,
+    .onFrame = DinoGame_Frame,
+    .onInput = DinoGame_Input,
+    .transition = UI_TRANSITION_FADE,
+};
+
+// 游戏初始化和启动（压栈，不阻塞）
+void Game_Dino_Init(void)
+{
+    Screen_Push(&DinoGame_App, NULL);
 }
@@ -7,33 +7,7 @@
 #include "input.h"
 #include <stdlib.h>
 #include <stdio.h>
-#include "cmsis_os.h"
-
-/* 输入事件队列：由 InputTask 生产（读硬件），各 UI/游戏从队列消费 */
-extern osMessageQueueId_t InputEventQueueHandle;
-
-static void Game_FlushInputEvents(void)
-{
-	if (!InputEventQueueHandle) return;
-	InputEvent evt;
-	while (osMessageQueueGet(InputEventQueueHandle, &evt, NULL, 0) == osOK) {
-		/* discard */
-	}
-}
-
-static InputEvent Game_ReceiveInputEvent(uint32_t timeout_ms)
-{
-	InputEvent evt;
-	evt.type = INPUT_NONE;
-	evt.value = 0;
-	if (!InputEventQueueHandle) return evt;
-	if (osMessageQueueGet(InputEventQueueHandle, &evt, NULL, timeout_ms) == osOK) {
-		return evt;
-	}
-	evt.type = INPUT_NONE;
-	evt.value = 0;
-	return evt;
-}
+#include "ui_screen.h"
 
 extern uint8_t OLED_DisplayBuf[8][128];		//把OLED显存拿过来
 
@@ -145,9 +119,16 @@ uint8_t Game_Snake_Advance(Game_Snake_Class* Snake)//把蛇映射到地图
 	return 1;			//前进成功
 }
 
-void Game_Snake_Play(Game_Snake_Class* Snake)		//开始游戏
+/* 贪吃蛇作为屏幕栈上的应用（见 ui_screen.h）：由 Screen_Run 驱动，每 Game_Speed 毫秒前进一格，
+   帧间阻塞在输入队列上（转向立即生效），到点弹窗与息屏与其他界面一致 */
+static Game_Snake_Class Snake_1;
+static WSAD Heading_Previous;		//上一次前进成功的方向
+static uint8_t Game_Over;			//游戏结束，等待按键退出
+static uint32_t Game_NextStep;		//下一次前进的时刻
+
+static void Game_Snake_Step(Game_Snake_Class* Snake)
 {
-	while(Snake->Head_i - Snake->Tail_i < 3)		//出身点随机方向强制移动三格;
+	if(Snake->Head_i - Snake->Tail_i < 3)		//出身点向右强制移动三格
 	{
 		Snake->H_X++;
 		if(Snake->H_X >= 16) Snake->H_X = 0; // 防止越界
@@ -155,90 +136,115 @@ void Game_Snake_Play(Game_Snake_Class* Snake)		//开始游戏
 		Snake->Head_i = (Snake->Head_i + 1) % 128;					//蛇头节点下标前进1格
 		Snake->node[Snake->Head_i] = &Map[Snake->H_Y][Snake->H_X];	//蛇头节点指向到前方地图方块
 		*Snake->node[Snake->Head_i] = SnakeHead;					//蛇头节点指向的地图方块变为蛇头
-		
-		Map_Update();
-		OLED_Update();
-		osDelay(Game_Speed);
+		return;
 	}
-	WSAD Heading_Previous = Snake->Heading; 
-	int16_t temp = 0;
-
-	
-	while(1)	//主循环
-	{		
-		InputEvent event = Game_ReceiveInputEvent(0);
-		if (event.type != INPUT_NONE) {
-			MENU_UpdateActivity();
-		}
-		if(event.type == INPUT_BACK || event.type == INPUT_ENTER) {return;}	//退出游戏
 
-		// 旋转编码器改变方向：顺时针(Down)右转，逆时针(Up)左转
-		if(event.type == INPUT_DOWN)
-		{
-			Snake->Heading = (Snake->Heading + (event.value % 4)) % 4;
-		}
-		else if(event.type == INPUT_UP)
-		{
-			Snake->Heading = (Snake->Heading + 4 - (event.value % 4)) % 4;
-		}
-		
-		if(Game_Snake_Advance(Snake)){Heading_Previous = Snake->Heading;}	//如果前进成功则记录方向
-		else
+	if(Game_Snake_Advance(Snake)){Heading_Previous = Snake->Heading;}	//如果前进成功则记录方向
+	else
+	{
+		Snake->Heading = Heading_Previous; 		//如果前进失败尝试之前的方向再试一次
+		if(Game_Snake_Advance(Snake) == 0)		//如果仍然失败则游戏结束
 		{
-			Snake->Heading = Heading_Previous; 		//如果前进失败尝试之前的方向再试一次
-			if(Game_Snake_Advance(Snake) == 0)		//如果仍然失败则游戏结束
-			{
-				OLED_Clear();
-				OLED_ShowString(20, 10, "Game Over!", OLED_8X16);
-				char score_str[32];
-				sprintf(score_str, "Score: %d", Game_Credits);
-				OLED_ShowString(30, 30, score_str, OLED_8X16);
-				OLED_ShowString(15, 45, "Press to exit", OLED_6X8);
-				OLED_Update();
-				
-				while(1){
-				InputEvent evt = Game_ReceiveInputEvent(50);
-				if(evt.type == INPUT_BACK || evt.type == INPUT_ENTER) {return;}	//退出游戏
-				if (evt.type != INPUT_NONE) MENU_UpdateActivity();
-				}
-			}
+			Game_Over = 1;
 		}
-		
+	}
+}
+
+static void Game_Snake_Draw(void)
+{
+	if(Game_Over)
+	{
+		char score_str[32];
+		OLED_Clear();
+		OLED_ShowString(20, 10, "Game Over!", OLED_8X16);
+		sprintf(score_str, "Score: %d", Game_Credits);
+		OLED_ShowString(30, 30, score_str, OLED_8X16);
+		OLED_ShowString(15, 45, "Press to exit", OLED_6X8);
+	}
+	else
+	{
 		Map_Update();
-		OLED_Update();
-		osDelay(Game_Speed);
 	}
+	MENU_Display();
 }
 
-void Game_Snake_Init(void)
+static void Game_Snake_Enter(void *ctx)
 {
-	/* 进入游戏前先清空积压输入，避免误触发 */
-	Game_FlushInputEvents();
+	(void)ctx;
 
 	Game_Credits = 0;
 	Game_Speed = 200;	
+	Game_Over = 0;
 	Map_Clear();		//清除蛇尸
 	
 	// 初始化随机种子
 	srand(HAL_GetTick());
 	
-	Game_Snake_Class Snake_1;
-		Snake_1.Head_i = 0;
-		Snake_1.Tail_i = 0;
-		Snake_1.H_X = rand()%16;
-		Snake_1.H_Y = rand()%8;
-		Snake_1.Heading = right;
-		Snake_1.node[Snake_1.Head_i] = &Map[Snake_1.H_Y][Snake_1.H_X];
+	Snake_1.Head_i = 0;
+	Snake_1.Tail_i = 0;
+	Snake_1.H_X = rand()%16;
+	Snake_1.H_Y = rand()%8;
+	Snake_1.Heading = right;
+	Snake_1.node[Snake_1.Head_i] = &Map[Snake_1.H_Y][Snake_1.H_X];
+	Heading_Previous = right;
 
 	Map[Snake_1.H_Y][Snake_1.H_X] = SnakeHead;
 	
 	RandFood();
-	
-	Map_Update();
-	OLED_Update();
-	Game_Snake_Play(&Snake_1);
-	
-	// 清理按键状态，避免退出后误触发
-	Game_FlushInputEvents();
-	return;
+	Game_NextStep = HAL_GetTick();	//第一帧就走出第一格
+}
+
+static uint32_t Game_Snake_Frame(void *ctx, bool full)
+{
+	uint32_t now = HAL_GetTick();
+	(void)ctx;
+
+	if(Game_Over)
+	{
+		if(full) Game_Snake_Draw();
+		else MENU_RefreshOverlay();
+		return UI_SCREEN_IDLE;		//等待按键退出
+	}
+
+	if((int32_t)(now - Game_NextStep) >= 0)
+	{
+		Game_Snake_Step(&Snake_1);
+		Game_NextStep += Game_Speed;
+		if((int32_t)(now - Game_NextStep) >= 0) Game_NextStep = now + Game_Speed;	//息屏或卡顿后不补走
+		full = true;
+	}
+	if(full) Game_Snake_Draw();
+
+	return Game_Over ? UI_SCREEN_IDLE : (Game_NextStep - now);
+}
+
+static void Game_Snake_Input(void *ctx, const InputEvent *event)
+{
+	(void)ctx;
+
+	if(event->type == INPUT_BACK || event->type == INPUT_ENTER) {Screen_Pop(); return;}	//退出游戏
+	if(Game_Over) return;
+
+	// 旋转编码器改变方向：顺时针(Down)右转，逆时针(Up)左转
+	if(event->type == INPUT_DOWN)
+	{
+		Snake_1.Heading = (Snake_1.Heading + (event->value % 4)) % 4;
+	}
+	else if(event->type == INPUT_UP)
+	{
+		Snake_1.Heading = (Snake_1.Heading + 4 - (event->value % 4)) % 4;
+	}
+}
+
+static const UI_App Game_Snake_App = {
+	.name = "snake",
+	.onEnter = Game_Snake_Enter,
+	.onFrame = Game_Snake_Frame,
+	.onInput = Game_Snake_Input,
+	.transition = UI_TRANSITION_FADE,
+};
+
+void Game_Snake_Init(void)
+{
+	Screen_Push(&Game_Snake_App, NULL);
 }
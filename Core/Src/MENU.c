@@ -5,25 +5,44 @@
 #include "stdio.h"
 #include "main.h"
 #include "string.h"
-#include <stdarg.h>
 
 
 /* 自动息屏相关变量 */
 uint32_t last_activity_time = 0;        // 最后活动时间
 uint8_t screen_sleeping = 0;             // 屏幕睡眠状态 (0=正常, 1=睡眠)
-uint8_t sleep_before_brightness = 128;   // 睡眠前的亮度值
 uint8_t oled_brightness = 128;           // 当前亮度值（0~255）
 uint16_t auto_sleep_seconds = 120;        // 可调节的自动睡眠时间(秒) - 默认120秒
 
-/* FPS 显示开关 (1=显示, 0=关闭) */
+/* FPS 显示开关 (1=显示, 0=关闭)；运行时可由 MENU_SetFpsVisible 关闭（主机端回归截图不含随耗时变化的帧率） */
 #define SHOW_FPS 1
+/* 帧耗时折线开关：FPS 右侧显示最近 32 帧的忙碌时间（每像素 2 ms） */
+#define SHOW_FRAME_GRAPH 0
 
-#if SHOW_FPS
-/* FPS相关变量 */
-static uint32_t frame_count = 0;
-static uint32_t last_fps_time = 0;
-static uint32_t current_fps = 0;
-#endif
+/* 空闲等待（事件驱动） */
+#define MENU_IDLE_POLL_MS 1000 // 空闲时最长等待：由其他任务改变的状态小部件（网络标记）最多延迟这么久显示
+#define MENU_LIVE_POLL_MS 100  // 列表含绑定变量的选项时的最长等待（数值变化的显示延迟）
+
+static InputEvent pending_event;          // MENU_WaitInput 阻塞取到的事件，留给下一次 MENU_ReceiveInputEvent
+static uint8_t has_pending_event = 0;
+static uint8_t frame_settled = 0;         // 最近一帧绘制时动画已全部静止
+static uint8_t fps_visible = SHOW_FPS;    // 覆盖层左上角显示帧率
+
+/* 滚动字幕（超宽选中项） */
+#define MARQUEE_X       (MENU_X + MENU_MARGIN + MENU_PADDING)           // 可视窗口起点
+#define MARQUEE_W       (MENU_WIDTH - 2 * (MENU_MARGIN + MENU_PADDING))   // 可视窗口宽度
+#define MARQUEE_STRIP_W ((MENU_OPTION_TEXT_MAX - 1) * MENU_FONT_W)       // 条带宽度（最长选项文本）
+
+static struct
+{
+    char Text[MENU_OPTION_TEXT_MAX];    // 条带对应的文本
+    uint8_t Strip[(MENU_FONT_H / 8) * MARQUEE_STRIP_W]; // 离屏条带（按页存放）
+    uint16_t Width;                     // 文本像素宽度
+    const MENU_HandleTypeDef *Owner;    // 正在滚动的菜单与选中项，切换后从头开始
+    int16_t Index;
+    uint32_t StartTick;                 // 本轮滚动的起始时间
+    uint32_t NextMs;                    // 距离下一次移动的毫秒数
+    uint8_t Active;                     // 本帧画了滚动字幕
+} marquee;
 
 static size_t MENU_BoundedStrnlen(const char *s, size_t max_len)
 {
@@ -54,6 +73,17 @@ static size_t MENU_BoundedStrnlen(const char *s, size_t max_len)
 #include "input.h"
 #include "cmsis_os.h"
 #include "config_store.h"
+#include "ui_overlay.h"
+#include "app_events.h"
+#include "low_power.h"
+#include "menu_tree.h"
+#include "ui_screen.h"
+#include "ui_widget.h"
+#include "ui_popup.h"
+#include "ui_transition.h"
+#include "ui_profiler.h"
+#include "stopwatch.h"
+#include "input_replay.h"
 
 /* 外部队列句柄 - 用于接收输入事件 */
 extern osMessageQueueId_t InputEventQueueHandle;
@@ -61,114 +91,52 @@ extern osMessageQueueId_t TimeQueueHandle;
 
 /* 函数前向声明 */
 InputEvent MENU_ReceiveInputEvent(void);
+static const char *MENU_FormatOption(const MENU_OptionTypeDef *Option, MENU_OptionState *State);
+static uint32_t MENU_UpdateFling(MENU_HandleTypeDef *hMENU);
 
 
 /*
  * 说明（阅读指南）：
- * 1) 本菜单系统通过 menu_command_callback 作为“统一指令入口”来解耦菜单逻辑和硬件驱动。
- *    - 菜单层：只发命令（显示/光标/边框/读取输入），不关心具体硬件如何实现。
- *    - 设备层：在回调内部把命令映射到 OLED/按键/编码器等驱动函数。
- * 2) 输入事件（确认/返回/旋钮）被采集为标准化的返回值，供菜单状态机消化。
-
+ * 1) 本菜单系统通过 MENU_Driver（MENU_DriverOps 函数表）来解耦菜单逻辑和显示驱动。
+ *    - 菜单层：只调用清屏/显示/文字/反色/边框等类型化接口，不关心具体硬件如何实现。
+ *    - 设备层：menu_driver.c 把这些接口映射到 OLED 驱动函数。
+ * 2) 输入事件（确认/返回/旋钮）由 InputTask 采集为标准化事件，经队列交给菜单状态机消化。
  */
-/// @brief 菜单指令回调函数（使用标准 stdarg.h 实现）
-/// @param  command 指令
-/// @param  ... 可变参数列表根据指令定义
-/// @return  返回值根据指令定义
-int menu_command_callback(enum _menu_command command, ...)
-{
-    int retval = 0;
-    va_list args;
-    va_start(args, command);
 
-    switch (command)
-    {
-        /* Output */
-    case BUFFER_DISPLAY: // 无参无返
-    {
-        // 统一刷新：将显存缓冲一次性推送到 OLED（OLED_Update）
-#if SHOW_FPS
-        // 显示FPS在左上角
-        uint32_t fps = Get_Current_FPS();
-        char fps_str[8];
-        sprintf(fps_str, "%lu", fps);
-        OLED_ShowString(0, 0, fps_str, OLED_6X8);
-#endif
-        
-        // 显示倒计时（如果启用）
-        if (timer_enabled) {
-            MENU_ShowTimer(90, 5);
-        }
-        
-        OLED_Update();
-#if SHOW_FPS
-        Update_FPS_Counter(); // 更新FPS计数器
-#endif
-    }
-    break;
-
-    case BUFFER_CLEAR: // 无参无返
-    {
-        OLED_Clear();
-    }
-    break;
-
-    case SHOW_STRING: // 参数:( int x, int y, char *str, int font_size ); 返回: uint8_t 字符串长度;
-    {
-        /*
-         * 使用标准 stdarg.h 提取参数：
-         * 注意：va_arg 对于小于 int 的类型会被提升为 int
-         * 所以 int16_t, uint8_t 等都应该用 int 来提取
-         */
-        int show_x = va_arg(args, int);
-        int show_y = va_arg(args, int);
-        char *show_string = va_arg(args, char *);
-        int font_size = va_arg(args, int);
-        
-        // 如果font_size为0，使用默认值
-        if (font_size == 0) {
-            font_size = OLED_8X16;
-        }
-
-        /* 按需使用参数 */
-        OLED_ShowString(show_x, show_y, show_string, (uint8_t)font_size);
-        retval = strlen(show_string); // 返回字符串长度
-    }
-    break;
-
-    case SHOW_CURSOR: // 参数:( int xsta, int ysta, int xend, int yend ); 返回: 无;
-    {
-        /* 使用 va_arg 提取参数 */
-        int cursor_xsta = va_arg(args, int);
-        int cursor_ysta = va_arg(args, int);
-        int cursor_xend = va_arg(args, int);
-        int cursor_yend = va_arg(args, int);
-
-        /* 按需使用参数 */
-        OLED_ReverseArea(cursor_xsta, cursor_ysta, COORD_CHANGE_SIZE(cursor_xsta, cursor_xend),
-                         COORD_CHANGE_SIZE(cursor_ysta, cursor_yend));
+/// @brief 提交一帧：更新覆盖层小部件内容后整屏推送，并记入帧耗时统计
+/// @note  屏幕过渡等待新画面时只留在显存里，由过渡合成后再发送
+void MENU_Display(void)
+{
+    ProfilerPhase phase = Profiler_Phase(PROFILER_LAYOUT); // 此前的时间属于界面绘制
+
+    MENU_UpdateOverlay();
+    if (!Transition_IsArmed()) {
+        Profiler_Phase(PROFILER_TRANSFER);
+        MENU_Driver.display();
+        Profiler_Presented();
+        Profiler_Phase(PROFILER_LAYOUT);
     }
-    break;
-
-    case DRAW_FRAME: // 参数:( int x, int y, int width, int height ); 返回: 无;
-    {
-        /* 使用 va_arg 提取参数 */
-        int frame_x = va_arg(args, int);
-        int frame_y = va_arg(args, int);
-        int frame_width = va_arg(args, int);
-        int frame_height = va_arg(args, int);
+    frame_settled = UI_Anim_AllSettled(); // 在推进之前判断：刚静止的动画还需要再画一帧终点
+    UI_Anim_Update(HAL_GetTick()); // 动画按流逝时间推进，下一帧绘制到此刻为止的进度
+    Profiler_Phase(phase);
+}
 
-        /* 按需使用参数 */
-        OLED_DrawRectangle(frame_x, frame_y, frame_width, frame_height, 0);
-    }
-    break;
+/// @brief 发送过渡合成的一帧：与 MENU_Display 相同但不推进界面动画，页面自己的动画等过渡结束再播放
+void MENU_Present(void)
+{
+    ProfilerPhase phase = Profiler_Phase(PROFILER_LAYOUT);
 
-    default:
-        break;
-    }
+    MENU_UpdateOverlay();
+    Profiler_Phase(PROFILER_TRANSFER);
+    MENU_Driver.display();
+    Profiler_Presented();
+    Profiler_Phase(phase);
+}
 
-    va_end(args);
-    return retval;
+/// @brief 读取动画当前值（整数像素）；槽位未分配（池满）时直接使用目标值
+static int16_t MENU_AnimValue(UI_AnimId id, q16_t target)
+{
+    return Q16_ROUND((id != UI_ANIM_NONE) ? UI_Anim_Value(id) : target);
 }
 
 
@@ -179,96 +147,309 @@ void MENU_UpdateActivity(void)
 {
     last_activity_time = HAL_GetTick();
     
-    // 如果屏幕处于睡眠状态，则唤醒
+    // 如果屏幕处于睡眠状态，则唤醒（GDDRAM 保持，面板直接恢复睡眠前的画面）
     if (screen_sleeping) {
-    // 唤醒策略：恢复进入睡眠前的亮度，清除睡眠标记
         screen_sleeping = 0;
-        oled_brightness = sleep_before_brightness;
-        OLED_SetBrightness(oled_brightness);
+        OLED_Wake();
+        LowPower_SetDisplaySleeping(false); // 记录唤醒到亮屏的延迟
     }
 }
 
 /**
- * @brief 检查是否需要自动息屏
+ * @brief 检查是否需要自动息屏；超时则真正睡眠并阻塞到被唤醒
+ * @note  睡眠期间关闭显示与充电泵，不渲染、不发送 SPI，UI 任务阻塞在输入队列上。
+ *        任意输入唤醒，唤醒事件本身被丢弃（不会误触发菜单操作）；
+ *        倒计时运行中则最迟在到点时醒来，交给调用方弹出"时间到"提示。
+ *        auto_sleep_seconds == 0 表示关闭自动息屏。
  */
 void MENU_CheckAutoSleep(void)
 {
 #if AUTO_SLEEP_ENABLED
-    uint32_t current_time = HAL_GetTick();
     uint32_t sleep_time_ms = auto_sleep_seconds * 1000; // 转换为毫秒
-    
-    // 检查是否超过息屏时间且屏幕未处于睡眠状态
-    if (!screen_sleeping && (current_time - last_activity_time) >= sleep_time_ms) {
-    // 进入睡眠：保存当前亮度，拉低亮度至 0，并标记睡眠状态
-    sleep_before_brightness = oled_brightness;  // 保存当前亮度
-        oled_brightness = 0;
-        screen_sleeping = 1;
-        OLED_SetBrightness(0);  // 关闭屏幕
+    InputEvent event;
+    uint32_t timeout, expiry;
+
+    if (screen_sleeping || auto_sleep_seconds == 0) {
+        return;
+    }
+    if ((HAL_GetTick() - last_activity_time) < sleep_time_ms) {
+        return;
     }
+
+    // 有计时已经到点、定时器服务任务还没来得及标记：按到点唤醒处理，不关面板，帧循环随后弹出提示
+    expiry = TimerSvc_MsUntilExpiry();
+    if (expiry <= 1U) {
+        MENU_UpdateActivity();
+        return;
+    }
+
+    // 进入睡眠：先落盘未保存的设置，再关闭面板
+    Config_Flush();
+    screen_sleeping = 1;
+    OLED_Sleep();
+
+    // 有计时运行时等到最近一个到点（亮屏提示），到点的提示由调用方的帧循环弹出
+    timeout = (expiry == UINT32_MAX) ? osWaitForever : expiry;
+
+    // 没有计时运行才允许 STOP：STOP 期间靠 LSI 计时，误差太大；秒表的微秒计数器在 STOP 下也会停
+    if (expiry == UINT32_MAX && !Stopwatch_Running()) {
+        LowPower_SetDisplaySleeping(true);
+    }
+
+    if (osMessageQueueGet(InputEventQueueHandle, &event, NULL, timeout) == osOK) {
+        // 旋钮一次转动会连续产生多个事件，同一批次一并丢弃
+        while (osMessageQueueGet(InputEventQueueHandle, &event, NULL, 0) == osOK);
+    }
+    has_pending_event = 0;
+
+    MENU_UpdateActivity();
 #endif
 }
 
-/* 倒计时相关实现已迁移到 time_task.c */
+/**
+ * @brief 距下一个需要处理的时间点的毫秒数：自动息屏、倒计时跳秒、设置延迟落盘、状态小部件刷新
+ * @return 至少 1：已到期的项目由帧循环的下一轮处理，而计时到点要等定时器服务任务标记，
+ *         返回 0 会让 MENU_WaitInput(0) 在较高优先级上空转，饿死定时器服务任务
+ */
+uint32_t MENU_NextDeadline(void)
+{
+    uint32_t now = HAL_GetTick();
+    uint32_t deadline = MENU_IDLE_POLL_MS;
+    uint32_t t;
 
-/* ******************************************************** */
+#if AUTO_SLEEP_ENABLED
+    if (!screen_sleeping && auto_sleep_seconds != 0) {
+        uint32_t idle = now - last_activity_time;
+        uint32_t limit = auto_sleep_seconds * 1000U;
+        t = (idle >= limit) ? 0 : (limit - idle);
+        if (t < deadline) deadline = t;
+    }
+#endif
+
+    // 覆盖层上的倒计时逐秒跳动；其他计时只需在到点时唤醒（到点事件由 MENU_ServiceTimers 弹窗）
+    t = TimerSvc_MsUntilChange(MENU_TimerId());
+    if (t < deadline) deadline = t;
+    t = TimerSvc_MsUntilExpiry();
+    if (t < deadline) deadline = t;
+
+    t = Config_MsUntilFlush();
+    if (t < deadline) deadline = t;
+
+    return (deadline == 0) ? 1 : deadline;
+}
 
-/// @brief 菜单运行函数
-/// @param hMENU 菜单句柄
-void MENU_RunMenu(MENU_HandleTypeDef *hMENU)
+/**
+ * @brief 阻塞等待输入，最长 timeout 毫秒；取到的事件由下一次 MENU_ReceiveInputEvent 返回
+ * @return 1 有输入，0 超时
+ */
+uint8_t MENU_WaitInput(uint32_t timeout)
 {
-    MENU_HandleInit(hMENU); // 初始化
-    
-    // 初始化最后活动时间
-    MENU_UpdateActivity();
+    if (has_pending_event) {
+        return 1;
+    }
+    if (osMessageQueueGet(InputEventQueueHandle, &pending_event, NULL, timeout) == osOK) {
+        has_pending_event = 1;
+    }
+    return has_pending_event;
+}
 
-    while (hMENU->isRun)
+/// @brief 菜单是否处于静止状态：动画已停、没有待处理的事件/光标更新
+static uint8_t MENU_IsQuiescent(MENU_HandleTypeDef *hMENU)
+{
+    return frame_settled && UI_Anim_AllSettled() &&
+           !hMENU->AnimationUpdateEvent && !has_pending_event && !screen_sleeping;
+}
+
+/// @brief 可见选项中是否有绑定变量的（数值可能随时变化，需要定期重绘）
+static uint8_t MENU_HasLiveOptions(MENU_HandleTypeDef *hMENU)
+{
+    if (hMENU->Page->Source != NULL) {
+        return hMENU->Page->Source->live; // 虚拟列表不逐项扫描，由数据源声明
+    }
+    // 只看屏上的行：静止时列表偏移为 0，可见的是 Show_i 起的 CURSOR_CEILING + 1 行，滚出屏外的绑定项不必定期重绘
+    for (int16_t i = hMENU->Show_i; i <= hMENU->Show_i + CURSOR_CEILING && i <= hMENU->Option_Max_i; i++)
     {
-    // 1) 息屏判定：优先检查是否需要息屏
-        MENU_CheckAutoSleep();
-        
-    // 2) 定时器：处理倒计时结束弹窗（阻塞等待确认）
-        if (MENU_UpdateTimer()) {
-            // 定时器结束，显示"时间到"提示
-            MENU_ShowTimeUpAlert();
+        if (i >= 0 && hMENU->Page->OptionList[i].StrVarPointer != NULL) {
+            return 1;
         }
-        
-    // 3) 显示：仅在屏幕未睡眠时渲染菜单帧
-        if (!screen_sleeping) {
-            menu_command_callback(BUFFER_CLEAR); // 擦除缓冲区
+    }
+    return 0;
+}
 
-            MENU_ShowOptionList(hMENU); /* 显示选项列表 */
-            MENU_ShowCursor(hMENU);     /* 显示光标 */
-           // MENU_ShowBorder(hMENU);     // 显示边框
-            MENU_DrawScrollBar(hMENU);  // 绘制垂直滚动条
+/* 倒计时相关实现已迁移到 time_task.c */
 
-            menu_command_callback(BUFFER_DISPLAY); // 缓冲区更新至显示器
-        }
-    MENU_Event_and_Action(hMENU); // 检查事件及作相应操作
+/* ******************************************************** */
+
+/* 菜单页面作为屏幕栈上的应用（见 ui_screen.h），由 Screen_Run 的帧循环驱动；
+   回调公开给在菜单页之上加自己逻辑的界面（如定时器设置页）复用 */
 
-    Config_FlushIfNeeded();
+static MENU_HandleTypeDef page_handles[UI_SCREEN_DEPTH]; // 按所在栈深度分配，页面在栈上期间有效
+
+void MENU_PageEnter(void *ctx)
+{
+    MENU_HandleInit((MENU_HandleTypeDef *)ctx);
+}
 
-    osDelay(10);  // 使用 osDelay 让出 CPU
+uint32_t MENU_PageFrame(void *ctx, bool full)
+{
+    MENU_HandleTypeDef *hMENU = (MENU_HandleTypeDef *)ctx;
+    uint32_t wait, fling_wait;
+
+    (void)full; // 菜单每帧都整屏绘制
+
+    MENU_SyncListCount(hMENU); // 虚拟列表项数变化时修正选中项
+    fling_wait = MENU_UpdateFling(hMENU);
+
+    MENU_Driver.clear(); // 擦除缓冲区
+
+    MENU_ShowOptionList(hMENU); /* 显示选项列表 */
+    MENU_ShowCursor(hMENU);     /* 显示光标 */
+   // MENU_ShowBorder(hMENU);     // 显示边框
+    MENU_DrawScrollBar(hMENU);  // 绘制垂直滚动条
+
+    MENU_Display(); // 缓冲区更新至显示器
+
+    // 动画播放中按帧间隔继续；静止后阻塞等待（含绑定变量时定期重绘）
+    if (!MENU_IsQuiescent(hMENU)) {
+        return 0;
+    }
+    wait = MENU_HasLiveOptions(hMENU) ? MENU_LIVE_POLL_MS : UI_SCREEN_IDLE;
+    if (marquee.Active && marquee.NextMs < wait) {
+        wait = marquee.NextMs; // 滚动字幕：到下一次整像素移动时再画
+    }
+    if (fling_wait < wait) {
+        wait = fling_wait;     // 惯性滚动：等到确认松手再开始滑行
+    }
+    return wait;
+}
+
+void MENU_PageInput(void *ctx, const InputEvent *event)
+{
+    MENU_HandleInput((MENU_HandleTypeDef *)ctx, event);
+}
+
+void MENU_PageExit(void *ctx)
+{
+    MENU_HandleRelease((MENU_HandleTypeDef *)ctx);
+}
+
+void MENU_PageResume(void *ctx)
+{
+    ((MENU_HandleTypeDef *)ctx)->AnimationUpdateEvent = 1; // 从子界面返回，光标重新定位
+}
+
+static const UI_App MENU_PageApp = {
+    .name = "menu",
+    .onEnter = MENU_PageEnter,
+    .onFrame = MENU_PageFrame,
+    .onInput = MENU_PageInput,
+    .onExit = MENU_PageExit,
+    .onResume = MENU_PageResume,
+    .transition = UI_TRANSITION_PUSH,
+};
+
+/// @brief 进入菜单页面（压栈，不阻塞）
+void MENU_PushPage(const MENU_PageDef *Page)
+{
+    MENU_HandleTypeDef *hMENU;
+
+    if (Screen_Depth() >= UI_SCREEN_DEPTH) {
+        return;
     }
+
+    hMENU = &page_handles[Screen_Depth()];
+    memset(hMENU, 0, sizeof(*hMENU));
+    hMENU->Page = Page;
+    Screen_Push(&MENU_PageApp, hMENU);
 }
 
 void MENU_HandleInit(MENU_HandleTypeDef *hMENU)
 {
-    hMENU->isRun = 1;                // 运行标志
     hMENU->AnimationUpdateEvent = 1; // 动画更新事件
-    hMENU->Catch_i = 1;              // 选中下标默认为1,(因为hMENU->OptionList[0]为"<<<")
+    hMENU->Catch_i = 1;              // 选中下标默认为1,(因为选项表[0]为"<<<")
     hMENU->Cursor_i = 1;             // 光标下标对应选中项
     hMENU->Show_i = 0;               // 显示(遍历)起始下标
     hMENU->Show_i_Previous = 0;      // 上一次循环的显示下标
-    hMENU->Option_Max_i = 0;         // 选项列表长度
+    hMENU->Option_Max_i = hMENU->Page->Option_Max_i; // 选项数编译期已算好
+    if (hMENU->Page->Source != NULL)
+    {
+        MENU_SyncListCount(hMENU); // 虚拟列表：项数取自数据源
+    }
     hMENU->Wheel_Event = 0;          // 初始化滚轮事件
+    hMENU->FlingVelocity = 0;        // 没有惯性滚动
 
-    for (hMENU->Option_Max_i = 0; hMENU->OptionList[hMENU->Option_Max_i].String[0] != '.';
-         hMENU->Option_Max_i++) // 计算选项列表长度
+    // 静态页面的长度也在表里；只有带状态侧表的页面需要按当前内容测量
+    if (hMENU->Page->State != NULL)
     {
-        hMENU->OptionList[hMENU->Option_Max_i].StrLen =
-            MENU_ShowOption(0, 0, &hMENU->OptionList[hMENU->Option_Max_i]); // 获取字符串长度
+        for (int16_t i = 0; i <= hMENU->Option_Max_i; i++)
+        {
+            hMENU->Page->State[i].StrLen = MENU_MeasureOption(&hMENU->Page->OptionList[i], &hMENU->Page->State[i]);
+        }
     }
-    hMENU->Option_Max_i--; // 不显示".."
+}
+
+/// @brief 虚拟列表第 i 行的文本（第 0 行为 "<<<"）
+static const char *MENU_ListRowText(const MENU_ListSource *Source, int16_t i, char *buf)
+{
+    const char *text;
+
+    if (i == 0)
+    {
+        return "<<<";
+    }
+    text = Source->get_item(Source->ctx, (uint16_t)(i - 1), buf);
+    return (text != NULL) ? text : "";
+}
+
+/// @brief 虚拟列表：从数据源取项数，变化时把选中项限制在范围内并重新定位光标
+void MENU_SyncListCount(MENU_HandleTypeDef *hMENU)
+{
+    const MENU_ListSource *Source = hMENU->Page->Source;
+    uint16_t count;
+
+    if (Source == NULL)
+    {
+        return;
+    }
+
+    count = Source->count(Source->ctx);
+    if (count > MENU_LIST_MAX_ITEMS) count = MENU_LIST_MAX_ITEMS;
+    if ((int16_t)count == hMENU->Option_Max_i && hMENU->Catch_i <= hMENU->Option_Max_i)
+    {
+        return;
+    }
+
+    hMENU->Option_Max_i = (int16_t)count; // 加上第 0 行 "<<<"，最后一行下标正好等于项数
+    if (hMENU->Catch_i > hMENU->Option_Max_i) hMENU->Catch_i = hMENU->Option_Max_i;
+    hMENU->Wheel_Event = 0;
+    MENU_UpdateIndex(hMENU);
+    hMENU->AnimationUpdateEvent = 1;
+}
+
+/// @brief 选项当前的显示长度（字符数）
+uint8_t MENU_OptionLen(MENU_HandleTypeDef *hMENU, int16_t i)
+{
+    if (hMENU->Page->Source != NULL)
+    {
+        char buf[MENU_OPTION_TEXT_MAX];
+        return MENU_Driver.measure_text(MENU_ListRowText(hMENU->Page->Source, i, buf));
+    }
+    if (hMENU->Page->State != NULL)
+    {
+        return hMENU->Page->State[i].StrLen;
+    }
+    return hMENU->Page->OptionList[i].StrLen;
+}
+
+/// @brief 释放菜单占用的动画槽位（菜单退出时调用）
+void MENU_HandleRelease(MENU_HandleTypeDef *hMENU)
+{
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        UI_Anim_Free(&hMENU->AnimCursor[i]);
+    }
+    UI_Anim_Free(&hMENU->AnimListOffset);
+    UI_Anim_Free(&hMENU->AnimScrollBar);
 }
 
 /**
@@ -280,6 +461,13 @@ InputEvent MENU_ReceiveInputEvent(void)
     InputEvent event;
     event.type = INPUT_NONE;
     event.value = 0;
+
+    // 空闲等待中已经取出的事件优先返回
+    if (has_pending_event)
+    {
+        has_pending_event = 0;
+        return pending_event;
+    }
     
     // 非阻塞方式从队列接收事件 (timeout = 0)
     if (osMessageQueueGet(InputEventQueueHandle, &event, NULL, 0) == osOK)
@@ -290,22 +478,117 @@ InputEvent MENU_ReceiveInputEvent(void)
     return event;
 }
 
-void MENU_Event_and_Action(MENU_HandleTypeDef *hMENU)
+/// @brief 快速拨动时记下惯性速度：预计的下一格没有到来（用户停手）之后才开始滑行；慢转则停止滑行
+static void MENU_StartFling(MENU_HandleTypeDef *hMENU, const InputEvent *event)
+{
+    int32_t speed;
+
+    if (event->rate < MENU_FLING_MIN_RATE || event->value <= 0)
+    {
+        hMENU->FlingVelocity = 0;
+        return;
+    }
+
+    speed = (int32_t)event->rate * event->steps / event->value; // 项/秒 = 格/秒 × 每格步数
+    if (speed > MENU_FLING_MAX) speed = MENU_FLING_MAX;
+
+    hMENU->FlingVelocity = (event->type == INPUT_DOWN) ? (speed << 16) : -(speed << 16);
+    hMENU->FlingAccum = 0;
+    hMENU->FlingTick = HAL_GetTick() + 2000U / event->rate; // 两个出格间隔内没有新输入才算松手
+}
+
+/// @brief 推进惯性滚动；返回距下一次需要绘制的毫秒数（未滑行时为 UI_SCREEN_IDLE）
+static uint32_t MENU_UpdateFling(MENU_HandleTypeDef *hMENU)
+{
+    uint32_t now = HAL_GetTick();
+    uint32_t dt;
+    int32_t v = hMENU->FlingVelocity;
+    int32_t decel, whole;
+
+    if (v == 0)
+    {
+        return UI_SCREEN_IDLE;
+    }
+    if ((int32_t)(now - hMENU->FlingTick) < 0)
+    {
+        return hMENU->FlingTick - now; // 仍可能在转动
+    }
+
+    dt = now - hMENU->FlingTick;
+    if (dt > UI_ANIM_MAX_STEP_MS) dt = UI_ANIM_MAX_STEP_MS;
+    hMENU->FlingTick = now;
+
+    hMENU->FlingAccum += (int32_t)(((int64_t)v * dt) / 1000);
+    whole = hMENU->FlingAccum / Q16_ONE;
+    if (whole != 0)
+    {
+        hMENU->FlingAccum -= whole * Q16_ONE;
+
+        // 到达列表首尾就停下，不循环
+        if ((whole > 0 && hMENU->Catch_i + whole >= hMENU->Option_Max_i) ||
+            (whole < 0 && hMENU->Catch_i + whole <= 0))
+        {
+            whole = (whole > 0) ? (hMENU->Option_Max_i - hMENU->Catch_i) : -hMENU->Catch_i;
+            v = 0;
+        }
+        hMENU->Wheel_Event = (int16_t)whole;
+        MENU_UpdateIndex(hMENU);
+        hMENU->Wheel_Event = 0;
+        hMENU->AnimationUpdateEvent = 1;
+    }
+
+    decel = (int32_t)(((int64_t)MENU_FLING_DECEL * Q16_ONE * dt) / 1000);
+    if (v > 0)
+    {
+        v = (v > decel) ? v - decel : 0;
+    }
+    else if (v < 0)
+    {
+        v = (-v > decel) ? v + decel : 0;
+    }
+    hMENU->FlingVelocity = v;
+    return 0;
+}
+
+/// @brief 处理一个输入事件（活动时间已由帧循环更新）
+void MENU_HandleInput(MENU_HandleTypeDef *hMENU, const InputEvent *event)
 {
-    // 从队列接收事件，而不是直接调用 Input_GetEvent()
-    InputEvent event = MENU_ReceiveInputEvent();
-    switch(event.type)
+    if (event->type == INPUT_ENTER || event->type == INPUT_BACK)
+    {
+        hMENU->FlingVelocity = 0; // 按键立即停止惯性滚动
+    }
+
+    switch(event->type)
     {
         case INPUT_ENTER: /* 确定事件 */
         {
-            MENU_UpdateActivity(); // 更新活动时间
-            if (hMENU->OptionList[hMENU->Catch_i].func != NULL)
+            const MENU_ListSource *Source = hMENU->Page->Source;
+            if (Source != NULL)
+            {
+                if (hMENU->Catch_i == 0)
+                {
+                    Screen_Pop(); // "<<<" 退出
+                }
+                else if (Source->on_select != NULL)
+                {
+                    Source->on_select(Source->ctx, (uint16_t)(hMENU->Catch_i - 1));
+                }
+                hMENU->AnimationUpdateEvent = 1;
+                break;
+            }
+
+            const MENU_OptionTypeDef *Option = &hMENU->Page->OptionList[hMENU->Catch_i];
+            if (Option->Child != NULL)
+            {
+                MENU_PushPage(Option->Child); // 进入子菜单（压栈）
+            }
+            else if (Option->func != NULL)
             {
-                hMENU->OptionList[hMENU->Catch_i].func();
+                Option->func(); // 压入功能界面（不阻塞），或只切换状态并弹出提示
             }
             else
             {
-                hMENU->isRun = 0; // 退出
+                Screen_Pop(); // 退出
             }
             hMENU->AnimationUpdateEvent = 1;
         }
@@ -313,29 +596,28 @@ void MENU_Event_and_Action(MENU_HandleTypeDef *hMENU)
 
         case INPUT_BACK: /* 返回事件 */
         {
-            MENU_UpdateActivity(); // 更新活动时间
-            hMENU->isRun = 0;
+            Screen_Pop();
         }
         break;
 
         case INPUT_DOWN: /* 顺时针滚动 (向下) */
         {
-            MENU_UpdateActivity();
-            // 直接使用编码器的旋转格数，实现快速滚动
-            hMENU->Wheel_Event = event.value; 
+            // 使用加速后的步数：慢转逐项，快速拨动一次跨多项
+            hMENU->Wheel_Event = event->steps; 
             
             MENU_UpdateIndex(hMENU);
+            MENU_StartFling(hMENU, event);
             hMENU->AnimationUpdateEvent = 1;
         }
         break;
 
         case INPUT_UP: /* 逆时针滚动 (向上) */
         {
-            MENU_UpdateActivity();
             // 向上滚动取负值
-            hMENU->Wheel_Event = -event.value;
+            hMENU->Wheel_Event = -event->steps;
             
             MENU_UpdateIndex(hMENU);
+            MENU_StartFling(hMENU, event);
             hMENU->AnimationUpdateEvent = 1;
         }
         break;
@@ -350,14 +632,15 @@ void MENU_UpdateIndex(MENU_HandleTypeDef *hMENU)
 {
     // 选中项（Catch_i）根据滚动事件累加，并支持首尾循环
     /* 更新选中下标 */
+    int16_t previous = hMENU->Catch_i;
     hMENU->Catch_i += hMENU->Wheel_Event;
 
-    /* 限制选中下标 - 支持循环滚动 */
+    /* 限制选中下标 - 支持循环滚动：已在首/尾时才绕到另一端，加速跨越多项时先停在首/尾 */
     if (hMENU->Catch_i > hMENU->Option_Max_i) {
-        hMENU->Catch_i = 0;  // 超出最大值时回到0
+        hMENU->Catch_i = (previous == hMENU->Option_Max_i) ? 0 : hMENU->Option_Max_i;
     }
     else if (hMENU->Catch_i < 0) {
-        hMENU->Catch_i = hMENU->Option_Max_i;  // 小于0时回到最大值
+        hMENU->Catch_i = (previous == 0) ? hMENU->Option_Max_i : 0;
     }
 
     /* 重新计算光标位置（Cursor_i）：
@@ -390,26 +673,89 @@ void MENU_UpdateIndex(MENU_HandleTypeDef *hMENU)
     if (hMENU->Cursor_i > hMENU->Option_Max_i) hMENU->Cursor_i = hMENU->Option_Max_i;
 }
 
+/* ******************************************************** */
+/* 滚动字幕：选中项宽于可视窗口时，整行文本离屏光栅化为条带（文本变化时才重画），
+ * 之后每帧只按时间移动窗口拷贝条带，不再逐帧光栅化文字 */
+
+/// @brief 以滚动字幕显示超宽的选中项
+/// @param y 行文本顶端
+static void MENU_DrawMarquee(MENU_HandleTypeDef *hMENU, int16_t y, const char *Text)
+{
+    uint32_t now = HAL_GetTick();
+    uint32_t period, cycle, t, moving, offset, next;
+
+    if (strncmp(marquee.Text, Text, sizeof(marquee.Text) - 1) != 0)
+    {
+        // 文本变化（如数值刷新）：重新光栅化，但不打断滚动进度
+        strncpy(marquee.Text, Text, sizeof(marquee.Text) - 1);
+        marquee.Width = MENU_Driver.render_strip(Text, marquee.Strip, MARQUEE_STRIP_W);
+    }
+    if (marquee.Owner != hMENU || marquee.Index != hMENU->Catch_i)
+    {
+        marquee.Owner = hMENU;
+        marquee.Index = hMENU->Catch_i;
+        marquee.StartTick = now;
+    }
+
+    // 一轮：停顿 MARQUEE_PAUSE_MS，再匀速移动一个文本宽度加间隔，第二份拷贝恰好回到起点
+    period = marquee.Width + MARQUEE_GAP;
+    cycle = MARQUEE_PAUSE_MS + (period * 1000U) / MARQUEE_SPEED;
+    t = (now - marquee.StartTick) % cycle;
+    moving = (t > MARQUEE_PAUSE_MS) ? (t - MARQUEE_PAUSE_MS) : 0;
+    offset = (moving * MARQUEE_SPEED) / 1000U;
+    if (offset >= period) offset = period - 1;
+
+    if (offset < marquee.Width)
+    {
+        uint16_t w = marquee.Width - offset;
+        if (w > MARQUEE_W) w = MARQUEE_W;
+        MENU_Driver.blit_strip(MARQUEE_X, y, (uint8_t)w, marquee.Strip, MARQUEE_STRIP_W, (uint16_t)offset);
+    }
+    if (period - offset < MARQUEE_W)
+    {
+        uint16_t w = MARQUEE_W - (period - offset);
+        if (w > marquee.Width) w = marquee.Width;
+        MENU_Driver.blit_strip(MARQUEE_X + (int16_t)(period - offset), y, (uint8_t)w, marquee.Strip, MARQUEE_STRIP_W, 0);
+    }
+
+    // 画面只在整像素移动时变化：静止菜单按此间隔唤醒，而不是每 10 ms 重绘
+    if (t < MARQUEE_PAUSE_MS)
+    {
+        next = MARQUEE_PAUSE_MS - t;
+    }
+    else
+    {
+        next = ((offset + 1U) * 1000U + MARQUEE_SPEED - 1U) / MARQUEE_SPEED - moving;
+    }
+    marquee.NextMs = (next > 0U) ? next : 1U;
+    marquee.Active = 1;
+}
+
 void MENU_ShowOptionList(MENU_HandleTypeDef *hMENU)
 {
-    static float VerticalOffsetBuffer; // 垂直偏移缓冲
+    int16_t VerticalOffset; // 垂直偏移
+    char RowBuf[MENU_OPTION_TEXT_MAX]; // 虚拟列表的行文本缓冲（逐行复用）
+
+    marquee.Active = 0;
 
     /* 计算显示起始下标 */
     // 显示窗口起点：当前选中项 - 光标位置（让光标位置处的项落在窗口内）
     hMENU->Show_i = hMENU->Catch_i - hMENU->Cursor_i; // 详解 https://www.bilibili.com/read/cv32114635/?jump_opus=1
 
-    if (hMENU->Show_i_Previous != hMENU->Show_i) // 如果显示下标有变化
+    if (hMENU->AnimListOffset == UI_ANIM_NONE)
     {
-        // 计算垂直偏移缓冲量：以像素为单位，正负代表向上/向下平移，随后逐帧缓动归零
-        VerticalOffsetBuffer = ((hMENU->Show_i - hMENU->Show_i_Previous) * MENU_LINE_H);
-        hMENU->Show_i_Previous = hMENU->Show_i;
+        hMENU->AnimListOffset = UI_Anim_Alloc(0);
     }
 
-    if (VerticalOffsetBuffer)
+    if (hMENU->Show_i_Previous != hMENU->Show_i) // 如果显示下标有变化
     {
-        // 行显示偏移量逐渐归零，形成丝滑滚动感
-        VerticalOffsetBuffer = STEPWISE_TO_TARGET(VerticalOffsetBuffer, 0, ANIMATION_SPEED);
+        // 垂直偏移：以像素为单位，正负代表向上/向下平移；叠加在当前偏移上保持连续，随后按时间补间归零
+        UI_Anim_Set(hMENU->AnimListOffset, UI_Anim_Value(hMENU->AnimListOffset) +
+                                               Q16_FROM_INT((hMENU->Show_i - hMENU->Show_i_Previous) * MENU_LINE_H));
+        UI_Anim_TweenTo(hMENU->AnimListOffset, 0, ANIMATION_TIME_MS, UI_EASE_OUT_CUBIC);
+        hMENU->Show_i_Previous = hMENU->Show_i;
     }
+    VerticalOffset = MENU_AnimValue(hMENU->AnimListOffset, 0);
 
     for (int16_t i = -1; i <= CURSOR_CEILING + 1; i++) // 遍历显示 选项
     {
@@ -419,172 +765,275 @@ void MENU_ShowOptionList(MENU_HandleTypeDef *hMENU)
         if (hMENU->Show_i + i > hMENU->Option_Max_i)
             break;
 
+        /* 虚拟列表：只为可见行向数据源取文本 */
+        const char *RowText = NULL;
+        uint8_t RowLen;
+        if (hMENU->Page->Source != NULL)
+        {
+            RowText = MENU_ListRowText(hMENU->Page->Source, hMENU->Show_i + i, RowBuf);
+            RowLen = MENU_Driver.measure_text(RowText);
+        }
+        else
+        {
+            RowLen = MENU_OptionLen(hMENU, hMENU->Show_i + i);
+        }
+
+        uint8_t IsMarquee = (hMENU->Show_i + i == hMENU->Catch_i) && (RowLen * MENU_FONT_W > MARQUEE_W);
+
 #if (IS_CENTERED != 0)
-        int16_t x = MENU_X + ((MENU_WIDTH - (hMENU->OptionList[hMENU->Show_i + i].StrLen * MENU_FONT_W)) / 2); // 水平居中
+        int16_t x = MENU_X + ((MENU_WIDTH - (RowLen * MENU_FONT_W)) / 2); // 水平居中
 #else
         int16_t x = MENU_X + MENU_MARGIN + MENU_PADDING; // 左对齐加边距
 #endif
 
-        int16_t y = MENU_Y + MENU_MARGIN + (i * MENU_LINE_H) + ((MENU_LINE_H - MENU_FONT_H) / 2) + (int)VerticalOffsetBuffer;
+        int16_t y = MENU_Y + MENU_MARGIN + (i * MENU_LINE_H) + ((MENU_LINE_H - MENU_FONT_H) / 2) + VerticalOffset;
+
+        if (IsMarquee)
+        {
+            if (RowText == NULL)
+            {
+                MENU_OptionState *State = (hMENU->Page->State != NULL) ? &hMENU->Page->State[hMENU->Show_i + i] : NULL;
+                RowText = MENU_FormatOption(&hMENU->Page->OptionList[hMENU->Show_i + i], State);
+                if (State != NULL)
+                {
+                    State->StrLen = MENU_Driver.measure_text(RowText);
+                }
+            }
+            MENU_DrawMarquee(hMENU, y, RowText);
+            continue;
+        }
+
+        if (RowText != NULL)
+        {
+            MENU_Driver.draw_text(x, y, RowText, OLED_8X16);
+            continue;
+        }
+
+        /* 显示选项, 内容可变的页面记录长度 */
+        MENU_OptionState *State = (hMENU->Page->State != NULL) ? &hMENU->Page->State[hMENU->Show_i + i] : NULL;
+        uint8_t len = MENU_ShowOption(x, y, &hMENU->Page->OptionList[hMENU->Show_i + i], State);
+        if (State != NULL)
+        {
+            State->StrLen = len;
+        }
+    }
+}
+
+/// @brief 取数值类型附带变量的当前值作为缓存键（按位读取）
+static uint32_t MENU_OptionValueKey(const MENU_OptionTypeDef *Option)
+{
+    uint32_t key = 0;
+
+    switch (Option->StrVarType)
+    {
+    case INT8:
+    case UINT8:
+    case CHAR:
+        key = *(uint8_t *)Option->StrVarPointer;
+        break;
+
+    case INT16:
+    case UINT16:
+        key = *(uint16_t *)Option->StrVarPointer;
+        break;
+
+    case INT32:
+    case UINT32:
+    case FLOAT:
+        memcpy(&key, Option->StrVarPointer, sizeof(key)); // 按位比较，float 也适用
+        break;
 
-        /* 显示选项, 并记录长度 */
-        hMENU->OptionList[hMENU->Show_i + i].StrLen = MENU_ShowOption(x, y, &hMENU->OptionList[hMENU->Show_i + i]);
+    default:
+        break;
     }
+    return key;
 }
 
-uint8_t MENU_ShowOption(int16_t X, int16_t Y, MENU_OptionTypeDef *Option)
+/// @brief 缓存是否仍对应附带变量的当前值
+/// @note  STRING 与缓存时保存的内容逐字节比较（不用哈希，避免碰撞时显示旧文本）；
+///        只比较前 MENU_OPTION_TEXT_MAX-1 个字符：更靠后的字符在格式化结果里已被截掉
+static uint8_t MENU_OptionCacheMatch(const MENU_OptionTypeDef *Option, const MENU_OptionState *State)
 {
-    char String[64]; // 定义字符数组
+    if (Option->StrVarType == STRING)
+    {
+        const char *Src = (const char *)Option->StrVarPointer;
+
+        for (uint8_t i = 0; i < MENU_OPTION_TEXT_MAX - 1; i++)
+        {
+            if (State->CacheString[i] != Src[i]) return 0;
+            if (Src[i] == '\0') return 1;
+        }
+        return 1;
+    }
+    return State->CacheValue == MENU_OptionValueKey(Option);
+}
+
+/// @brief 记下生成缓存时附带变量的值
+static void MENU_OptionCacheStore(const MENU_OptionTypeDef *Option, MENU_OptionState *State)
+{
+    if (Option->StrVarType == STRING)
+    {
+        const char *Src = (const char *)Option->StrVarPointer;
+        uint8_t i;
+
+        for (i = 0; i < MENU_OPTION_TEXT_MAX - 1 && Src[i] != '\0'; i++)
+        {
+            State->CacheString[i] = Src[i];
+        }
+        State->CacheString[i] = '\0';  // 超长时只留可见部分，与 MENU_OptionCacheMatch 的比较长度一致
+        return;
+    }
+    State->CacheValue = MENU_OptionValueKey(Option);
+}
+
+/// @brief 生成选项的显示文本
+/// @param State 选项的状态侧表项，静态页面为 NULL
+/// @return 未绑定变量时直接返回模板本身；否则返回缓存，只有模板或变量值变化时才重新格式化
+static const char *MENU_FormatOption(const MENU_OptionTypeDef *Option, MENU_OptionState *State)
+{
+    static char Scratch[MENU_OPTION_TEXT_MAX]; // 没有状态侧表时无处缓存，每次都格式化
+    const char *Template = (State != NULL && State->Text != NULL) ? State->Text : Option->String;
+    char *String = (State != NULL) ? State->CacheText : Scratch;
+
+    // 未绑定变量的选项：模板即显示内容，不做格式化（也避免解引用空指针）
+    if (Option->StrVarPointer == NULL)
+    {
+        return Template;
+    }
+
+    if (State != NULL && State->CacheValid && State->CacheTemplate == Template && MENU_OptionCacheMatch(Option, State))
+    {
+        return String; // 稳态帧：零格式化
+    }
 
     switch (Option->StrVarType)
     {
     case INT8:
     // 根据变量类型选择合适的格式化方式；模板字符串在 Option->String 中
-        sprintf(String, Option->String, *(int8_t *)Option->StrVarPointer);
+        snprintf(String, MENU_OPTION_TEXT_MAX, Template, *(int8_t *)Option->StrVarPointer);
         break;
 
     case UINT8:
-        sprintf(String, Option->String, *(uint8_t *)Option->StrVarPointer);
+        snprintf(String, MENU_OPTION_TEXT_MAX, Template, *(uint8_t *)Option->StrVarPointer);
         break;
 
     case INT16:
-        sprintf(String, Option->String, *(int16_t *)Option->StrVarPointer);
+        snprintf(String, MENU_OPTION_TEXT_MAX, Template, *(int16_t *)Option->StrVarPointer);
         break;
 
     case UINT16:
-        sprintf(String, Option->String, *(uint16_t *)Option->StrVarPointer);
+        snprintf(String, MENU_OPTION_TEXT_MAX, Template, *(uint16_t *)Option->StrVarPointer);
         break;
 
     case INT32:
-        sprintf(String, Option->String, *(int32_t *)Option->StrVarPointer);
+        snprintf(String, MENU_OPTION_TEXT_MAX, Template, *(int32_t *)Option->StrVarPointer);
         break;
 
     case UINT32:
-        sprintf(String, Option->String, *(uint32_t *)Option->StrVarPointer);
+        snprintf(String, MENU_OPTION_TEXT_MAX, Template, *(uint32_t *)Option->StrVarPointer);
         break;
 
     case CHAR:
-        sprintf(String, Option->String, *(char *)Option->StrVarPointer);
+        snprintf(String, MENU_OPTION_TEXT_MAX, Template, *(char *)Option->StrVarPointer);
         break;
 
     case STRING:
-        sprintf(String, Option->String, (char *)Option->StrVarPointer);
+        snprintf(String, MENU_OPTION_TEXT_MAX, Template, (char *)Option->StrVarPointer);
         break;
 
     case FLOAT:
-        sprintf(String, Option->String, *(float *)Option->StrVarPointer);
+        snprintf(String, MENU_OPTION_TEXT_MAX, Template, *(float *)Option->StrVarPointer);
         break;
 
     default:
-        // 兜底：按指针打印（不建议常用）。如需更强类型安全，考虑引入类型化渲染函数。
-        sprintf(String, Option->String, (void *)Option->StrVarPointer);
-        break;
+        // 未知类型：不猜测参数，原样显示模板
+        return Template;
     }
 
-    // 注意：String 长度上限 64，如模板+数据可能超出，建议在模板设计时控制长度。
-    return menu_command_callback(SHOW_STRING, X, Y, String, OLED_8X16); // 显示字符数组（字符串），使用标准字体
+    // 超出 MENU_OPTION_TEXT_MAX 的部分被截断，模板设计时注意控制长度
+    if (State != NULL)
+    {
+        State->CacheTemplate = Template;
+        MENU_OptionCacheStore(Option, State);
+        State->CacheValid = 1;
+    }
+    return String;
 }
 
-void MENU_ShowCursor(MENU_HandleTypeDef *hMENU)
+uint8_t MENU_ShowOption(int16_t X, int16_t Y, const MENU_OptionTypeDef *Option, MENU_OptionState *State)
 {
-    static float actual_xsta, actual_ysta, actual_xend, actual_yend; // actual
-    static float target_xsta, target_ysta, target_xend, target_yend; // target
-
-#if (IS_OVERSHOOT != 0)
-    static float bounce_xsta, bounce_ysta, bounce_xend, bounce_yend;                   // bounce
-    static uint8_t bounce_cnt_xsta, bounce_cnt_ysta, bounce_cnt_xend, bounce_cnt_yend; // bounce
+    return MENU_Driver.draw_text(X, Y, MENU_FormatOption(Option, State), OLED_8X16); // 使用标准字体
+}
 
-#endif
+/// @brief 只计算选项文本长度（字符数），不绘制
+uint8_t MENU_MeasureOption(const MENU_OptionTypeDef *Option, MENU_OptionState *State)
+{
+    return MENU_Driver.measure_text(MENU_FormatOption(Option, State));
+}
 
-    // static uint16_t Catch_i_Previous = 1, Cursor_i_Previous = 1; // 上一循环的状态
+void MENU_ShowCursor(MENU_HandleTypeDef *hMENU)
+{
+    uint8_t retarget = hMENU->AnimationUpdateEvent;
+    q16_t target[4]; // xsta, ysta, xend, yend
 
-    if (hMENU->AnimationUpdateEvent)
-    {
-        hMENU->AnimationUpdateEvent = 0;
+    hMENU->AnimationUpdateEvent = 0;
 
-        // 光标框宽度基于当前选中项字符串长度计算：左右各留 MENU_PADDING 像素
-        uint16_t cursor_width = (MENU_PADDING + (hMENU->OptionList[hMENU->Catch_i].StrLen * MENU_FONT_W) + MENU_PADDING);
-        uint16_t cursor_height = MENU_LINE_H;
+    // 光标框宽度基于当前选中项字符串长度计算：左右各留 MENU_PADDING 像素
+    uint16_t text_width = MENU_OptionLen(hMENU, hMENU->Catch_i) * MENU_FONT_W;
+    if (text_width > MARQUEE_W) text_width = MARQUEE_W; // 超宽项以滚动字幕显示，光标框住可视窗口
+    uint16_t cursor_width = (MENU_PADDING + text_width + MENU_PADDING);
+    uint16_t cursor_height = MENU_LINE_H;
 
 #if (IS_CENTERED != 0)
-        target_xsta = MENU_X + ((MENU_WIDTH - cursor_width) / 2);
+    int16_t target_xsta = MENU_X + ((MENU_WIDTH - cursor_width) / 2);
 #else
-        target_xsta = MENU_X + MENU_MARGIN;
+    int16_t target_xsta = MENU_X + MENU_MARGIN;
 #endif
-        target_ysta = MENU_Y + MENU_MARGIN + (hMENU->Cursor_i * MENU_LINE_H);
-    // 宏 SIZE_CHANGE_COORD(a, size) 将起点与宽/高转换为终点坐标，便于后续绘制
-    target_xend = SIZE_CHANGE_COORD(target_xsta, cursor_width);
-    target_yend = SIZE_CHANGE_COORD(target_ysta, cursor_height);
+    int16_t target_ysta = MENU_Y + MENU_MARGIN + (hMENU->Cursor_i * MENU_LINE_H);
 
-#if (IS_OVERSHOOT != 0)
-        bounce_xsta = target_xsta + (target_xsta - actual_xsta) * OVERSHOOT;
-        bounce_ysta = target_ysta + (target_ysta - actual_ysta) * OVERSHOOT;
-        bounce_xend = target_xend + (target_xend - actual_xend) * OVERSHOOT;
-        bounce_yend = target_yend + (target_yend - actual_yend) * OVERSHOOT;
-
-        bounce_cnt_xsta = 2; // 反弹次数
-        bounce_cnt_ysta = 2;
-        bounce_cnt_xend = 2;
-        bounce_cnt_yend = 2;
-#endif
-    }
-
-#if (IS_OVERSHOOT != 0)
+    // 宏 SIZE_CHANGE_COORD(a, size) 将起点与宽/高转换为终点坐标，便于后续绘制
+    target[0] = Q16_FROM_INT(target_xsta);
+    target[1] = Q16_FROM_INT(target_ysta);
+    target[2] = Q16_FROM_INT(SIZE_CHANGE_COORD(target_xsta, cursor_width));
+    target[3] = Q16_FROM_INT(SIZE_CHANGE_COORD(target_ysta, cursor_height));
 
-    if (bounce_xsta == actual_xsta)
-    {
-        if (bounce_cnt_xsta--)
-            bounce_xsta = target_xsta + (target_xsta - actual_xsta) * OVERSHOOT;
-        else
-            bounce_xsta = target_xsta;
-    }
-    if (bounce_ysta == actual_ysta)
-    {
-        if (bounce_cnt_ysta--)
-            bounce_ysta = target_ysta + (target_ysta - actual_ysta) * OVERSHOOT;
-        else
-            bounce_ysta = target_ysta;
-    }
-    if (bounce_xend == actual_xend)
+    for (uint8_t i = 0; i < 4; i++)
     {
-        if (bounce_cnt_xend--)
-            bounce_xend = target_xend + (target_xend - actual_xend) * OVERSHOOT;
-        else
-            bounce_xend = target_xend;
-    }
-    if (bounce_yend == actual_yend)
-    {
-        if (bounce_cnt_yend--)
-            bounce_yend = target_yend + (target_yend - actual_yend) * OVERSHOOT;
-        else
-            bounce_yend = target_yend;
+        if (hMENU->AnimCursor[i] == UI_ANIM_NONE)
+        {
+            hMENU->AnimCursor[i] = UI_Anim_Alloc(0); // 首次显示时从左上角展开
+            retarget = 1;
+        }
     }
 
-    // 使用统一的缓动函数 STEPWISE_TO_TARGET 实现平滑/果冻效果
-    actual_xsta = STEPWISE_TO_TARGET(actual_xsta, bounce_xsta, ANIMATION_SPEED);
-    actual_ysta = STEPWISE_TO_TARGET(actual_ysta, bounce_ysta, ANIMATION_SPEED);
-    actual_xend = STEPWISE_TO_TARGET(actual_xend, bounce_xend, ANIMATION_SPEED);
-    actual_yend = STEPWISE_TO_TARGET(actual_yend, bounce_yend, ANIMATION_SPEED);
-
+    if (retarget)
+    {
+        for (uint8_t i = 0; i < 4; i++)
+        {
+#if (IS_OVERSHOOT != 0)
+            // 欠阻尼弹簧：越过目标后回弹，形成果冻效果
+            UI_Anim_SpringTo(hMENU->AnimCursor[i], target[i], Q16(CURSOR_SPRING_OMEGA), Q16(OVERSHOOT_DAMPING));
 #else
-
-    actual_xsta = STEPWISE_TO_TARGET(actual_xsta, target_xsta, ANIMATION_SPEED);
-    actual_ysta = STEPWISE_TO_TARGET(actual_ysta, target_ysta, ANIMATION_SPEED);
-    actual_xend = STEPWISE_TO_TARGET(actual_xend, target_xend, ANIMATION_SPEED);
-    actual_yend = STEPWISE_TO_TARGET(actual_yend, target_yend, ANIMATION_SPEED);
-
+            UI_Anim_TweenTo(hMENU->AnimCursor[i], target[i], ANIMATION_TIME_MS, UI_EASE_OUT_CUBIC);
 #endif
+        }
+    }
 
     // 四舍五入转换为整数像素坐标后绘制反色块作为光标
-    menu_command_callback(SHOW_CURSOR, (int)(actual_xsta + 0.5), (int)(actual_ysta + 0.5), (int)(actual_xend + 0.5),
-                          (int)(actual_yend + 0.5));
+    int16_t cursor_xsta = MENU_AnimValue(hMENU->AnimCursor[0], target[0]);
+    int16_t cursor_ysta = MENU_AnimValue(hMENU->AnimCursor[1], target[1]);
+    int16_t cursor_xend = MENU_AnimValue(hMENU->AnimCursor[2], target[2]);
+    int16_t cursor_yend = MENU_AnimValue(hMENU->AnimCursor[3], target[3]);
+    MENU_Driver.invert_rect(cursor_xsta, cursor_ysta, COORD_CHANGE_SIZE(cursor_xsta, cursor_xend),
+                            COORD_CHANGE_SIZE(cursor_ysta, cursor_yend));
 }
 
 void MENU_ShowBorder(MENU_HandleTypeDef *hMENU) // 显示边框
 {
+    (void)hMENU; // 边框只取决于布局常量，参数与其他 MENU_Show* 一致
     for (int16_t i = 0; i < MENU_BORDER; i++)
     {
-        menu_command_callback(DRAW_FRAME, MENU_X + i, MENU_Y + i, MENU_WIDTH - i - i, MENU_HEIGHT - i - i);
+        MENU_Driver.frame(MENU_X + i, MENU_Y + i, MENU_WIDTH - i - i, MENU_HEIGHT - i - i);
     }
 }
 
@@ -593,391 +1042,300 @@ void MENU_ShowBorder(MENU_HandleTypeDef *hMENU) // 显示边框
 /* ******************************************************** */
 /* 应用示例 */
 
-void MENU_RunMainMenu(void)
-{
-    static MENU_OptionTypeDef MENU_OptionList[] = {{"<<<"},
-                                                   {"Tools", MENU_RunToolsMenu},        // 工具
-                                                   {"Games", MENU_RunGamesMenu},        // 游戏
-                                                   {"Setting", MENU_RunSettingMenu},    // 设置
-                                                   {"Information", MENU_Information},   // 信息
-                                                   {"Test Menu", MENU_RunTestLongMenu}, // 测试长菜单
-                                                   {"Weather", MENU_RunWeatherMenu},    // 天气
-                                                   {".."}};
-
-    static MENU_HandleTypeDef MENU = {.OptionList = MENU_OptionList};
+/* 菜单树展开为 Flash 中的 const 页面表（内容见 menu_tree.h） */
+#define MENU_TREE_DEFINE_(id, parent, ITEMS) MENU_PAGE_DEFINE(id, parent, ITEMS);
+MENU_TREE(MENU_TREE_DEFINE_)
 
-    MENU_RunMenu(&MENU);
-}
+/* 测试长菜单（演示滚动条）：虚拟列表，项目文本按需生成 */
+#define MENU_TEST_LONG_COUNT 15
 
-void MENU_RunToolsMenu(void)
+static uint16_t MENU_TestLongCount(void *ctx)
 {
-    static MENU_OptionTypeDef MENU_OptionList[] = {{"<<<"},
-                                                   {"Timer", MENU_TimerSetting},       // 定时器
-                                                   {"Serial Port", NULL},              // 串口
-                                                   {"Oscilloscope", NULL},             // 示波器
-                                                   {"PWM Output", NULL},               // PWM 输出
-                                                   {"PWM Input", NULL},                // PWM 输入
-                                                   {"ADC Input", NULL},                // ADC 输入
-                                                   {"I2C Scanner", NULL},              // I2C扫描
-                                                   {"SPI Test", NULL},                 // SPI测试
-                                                   {"Timer Config", NULL},             // 定时器配置
-                                                   {"GPIO Control", NULL},             // GPIO控制
-                                                   {"UART Logger", NULL},              // UART日志
-                                                   {"Frequency Gen", NULL},            // 频率发生器
-                                                   {"Voltage Meter", NULL},            // 电压计
-                                                   {"Logic Analyzer", NULL},           // 逻辑分析仪
-                                                   {"Signal Gen", NULL},               // 信号发生器
-                                                   {"Memory Test", NULL},              // 内存测试
-                                                   {".."}};
-
-    static MENU_HandleTypeDef MENU = {.OptionList = MENU_OptionList};
-
-    MENU_RunMenu(&MENU);
+    (void)ctx;
+    return MENU_TEST_LONG_COUNT;
 }
 
-void MENU_RunGamesMenu(void)
+static const char *MENU_TestLongItem(void *ctx, uint16_t index, char *buf)
 {
-    static MENU_OptionTypeDef MENU_OptionList[] = {{"<<<"},
-                                                   {"Snake Game", Game_Snake_Init},     // 贪吃蛇游戏
-                                                   {"Dino Game", Game_Dino_Init},       // 恐龙跳跃游戏
-                                                   {"Tetris", NULL},                    // 俄罗斯方块（占位）
-                                                   {"2048", NULL},                      // 2048游戏（占位）
-                                                   {"Pong", NULL},                      // 乒乓球游戏（占位）
-                                                   {"Breakout", NULL},                  // 打砖块游戏（占位）
-                                                   {".."}};
+    (void)ctx;
+    snprintf(buf, MENU_OPTION_TEXT_MAX, "Test Item %02u", (unsigned)(index + 1));
+    return buf;
+}
 
-    static MENU_HandleTypeDef MENU = {.OptionList = MENU_OptionList};
+static const MENU_ListSource MENU_TestLongSource = {
+    .count = MENU_TestLongCount,
+    .get_item = MENU_TestLongItem,
+};
 
-    MENU_RunMenu(&MENU);
-}
+MENU_PAGE_DEFINE_LIST(TestLong, &MENU_Page_Main, &MENU_TestLongSource);
 
-/**
- * @brief 测试长菜单（演示滚动条）
- */
-void MENU_RunTestLongMenu(void)
-{
-    static MENU_OptionTypeDef MENU_OptionList[] = {{"<<<"},
-                                                   {"Test Item 01", NULL},
-                                                   {"Test Item 02", NULL},
-                                                   {"Test Item 03", NULL},
-                                                   {"Test Item 04", NULL},
-                                                   {"Test Item 05", NULL},
-                                                   {"Test Item 06", NULL},
-                                                   {"Test Item 07", NULL},
-                                                   {"Test Item 08", NULL},
-                                                   {"Test Item 09", NULL},
-                                                   {"Test Item 10", NULL},
-                                                   {"Test Item 11", NULL},
-                                                   {"Test Item 12", NULL},
-                                                   {"Test Item 13", NULL},
-                                                   {"Test Item 14", NULL},
-                                                   {"Test Item 15", NULL},
-                                                   {".."}};
-
-    static MENU_HandleTypeDef MENU = {.OptionList = MENU_OptionList};
-
-    MENU_RunMenu(&MENU);
+/// @brief 运行菜单：主菜单入栈后由帧循环驱动，直到退出主菜单才返回
+void MENU_RunMainMenu(void)
+{
+    MENU_UpdateActivity(); // 初始化最后活动时间
+    Profiler_Init();
+    Profiler_SetGraph(SHOW_FRAME_GRAPH);
+    MENU_PushPage(&MENU_Page_Main);
+    Screen_Run();
 }
 
 void MENU_RunWeatherMenu(void)
 {
-    Weather_Run();
+    Weather_Open();
 }
 
 
-void MENU_Information(void)
-{
-    menu_command_callback(BUFFER_CLEAR);
-    menu_command_callback(SHOW_STRING, 5, 16, "Menu v2.0", OLED_8X16);
-    menu_command_callback(SHOW_STRING, 5, 32, "By: Harvey", OLED_8X16);
-    
-    // 显示定时器状态（如果启用）
-    if (timer_enabled) {
-        char timer_info[32];
-        sprintf(timer_info, "Timer: %ds running", timer_current);
-        menu_command_callback(SHOW_STRING, 5, 48, timer_info, OLED_8X16);
-    }
-    
-    menu_command_callback(BUFFER_DISPLAY);
+/* ******************************************************** */
+/* 信息/设置页面：由 ui_widget 的控件描述生成（见 ui_widget.h） */
 
-    while (1)
+static const char *MENU_InformationLine(uint8_t row, char *buf)
+{
+    switch (row)
     {
-        InputEvent event = MENU_ReceiveInputEvent();
-        if (event.type == INPUT_ENTER || event.type == INPUT_BACK)
-        {
-            MENU_UpdateActivity(); // 更新活动时间
-            return;
+    case 0: return "Menu v2.0";
+    case 1: return "By: Harvey";
+    case 2:
+        // 显示定时器状态（如果启用）
+        if (MENU_TimerRunning()) {
+            snprintf(buf, UI_WIDGET_TEXT_MAX, "Timer: %ds running", MENU_TimerRemaining());
+            return buf;
         }
-        osDelay(10);
+        return NULL;
+    default: return NULL;
     }
 }
 
+void MENU_Information(void)
+{
+    static const UI_Widget widget = {
+        .kind = UI_WIDGET_TEXT,
+        .line = MENU_InformationLine,
+    };
+
+    Widget_Push(&widget);
+}
+
 /**********************************************************/
 
 /**
- * @brief 运行设置菜单
+ * @brief 显示设置 - 亮度滑块（百分比，每格 5%）
  */
-void MENU_RunSettingMenu(void)
+static int32_t MENU_GetBrightness(void)
+{
+    return (oled_brightness * 100 + 127) / 255; // 四舍五入，百分比与 0~255 往返不漂移
+}
+
+static void MENU_SetBrightness(int32_t percent)
 {
-    static MENU_OptionTypeDef MENU_OptionList[] = {{"<<<"},
-                                                   {"Display", MENU_DisplaySetting},     // 显示设置
-                                                   {"Sleep", MENU_SleepSetting},         // 睡眠设置
-                                                   {"System", MENU_SystemSetting},       // 系统设置
-                                                   {"About",  MENU_AboutSetting},
-												   {"WIFI" ,  MENU_WIFISetting},          // 关于
-                                                   {".."}};
+    oled_brightness = (uint8_t)((percent * 255 + 50) / 100);
+    OLED_SetBrightness(oled_brightness); // 立即应用亮度设置
+}
 
-    static MENU_HandleTypeDef MENU = {.OptionList = MENU_OptionList};
+static void MENU_FormatPercent(int32_t value, char *buf)
+{
+    snprintf(buf, UI_WIDGET_TEXT_MAX, "%ld%%", (long)value);
+}
 
-    MENU_RunMenu(&MENU);
+void MENU_DisplaySetting(void)
+{
+    static const UI_Widget widget = {
+        .kind = UI_WIDGET_SLIDER,
+        .title = "Display",
+        .label = "Brightness:",
+        .hint = "Turn to adjust",
+        .min = 0, .max = 100, .step = 5,
+        .get = MENU_GetBrightness,
+        .set = MENU_SetBrightness,
+        .format = MENU_FormatPercent,
+    };
+
+    Widget_Push(&widget);
 }
 
 /**
- * @brief 显示设置菜单 - 交互式亮度调节
+ * @brief 睡眠时间设置 - 数值微调（0~300 秒，每格 5 秒，快速旋转加速）
  */
-void MENU_DisplaySetting(void)
+static int32_t MENU_GetSleepTime(void)
 {
-    uint8_t brightness_percent = (oled_brightness * 100) / 255; // 转换为百分比
-    char brightness_str[16];
-    
-    while (1)
-    {
-        menu_command_callback(BUFFER_CLEAR);
-        
+    return auto_sleep_seconds;
+}
 
-        
-        // 显示亮度标签
-        menu_command_callback(SHOW_STRING, 5, 20, "Brightness:", OLED_8X16);
-        
-        // 显示亮度百分比
-        sprintf(brightness_str, "%d%%", brightness_percent);
-        menu_command_callback(SHOW_STRING, 90, 20, brightness_str, OLED_8X16);
-        
-        // 绘制亮度进度条
-        MENU_DrawProgressBar(5, 35, 118, 8, brightness_percent);
-        
-        // 显示操作提示
-        
-        menu_command_callback(BUFFER_DISPLAY);
-        
-        // 处理输入事件
-        InputEvent event = MENU_ReceiveInputEvent();
-        if (event.type == INPUT_UP || event.type == INPUT_DOWN)
-        {
-            MENU_UpdateActivity(); // 更新活动时间
-            
-            // 调整亮度 (每次调整5%) - 反转方向使顺时针增加亮度
-            // 下滚(顺时针) = 增加亮度
-            int16_t wheel_value = (event.type == INPUT_DOWN) ? event.value : -event.value;
-            int16_t new_brightness = brightness_percent + (wheel_value * 5);
-            
-            // 限制范围
-            if (new_brightness < 0) new_brightness = 0;
-            if (new_brightness > 100) new_brightness = 100;
-            
-            brightness_percent = new_brightness;
-            
-            // 更新实际亮度值
-            oled_brightness = (brightness_percent * 255) / 100;
-            
-            // 立即应用亮度设置
-            OLED_SetBrightness(oled_brightness);
-        }
-        
-        // 检查退出事件
-        if (event.type == INPUT_ENTER || event.type == INPUT_BACK)
-        {
-            MENU_UpdateActivity();
-            Config_MarkDirty();
-            return;
-        }
+static void MENU_SetSleepTime(int32_t seconds)
+{
+    auto_sleep_seconds = (uint16_t)seconds;
+}
+
+/* 睡眠时间的人性化格式：<60s 显示秒，>=60s 显示 m/s 组合，0 表示 OFF */
+static void MENU_FormatSleepTime(int32_t value, char *buf)
+{
+    if (value == 0) {
+        snprintf(buf, UI_WIDGET_TEXT_MAX, "OFF");
+    } else if (value < 60) {
+        snprintf(buf, UI_WIDGET_TEXT_MAX, "%lds", (long)value);
+    } else if (value % 60 == 0) {
+        snprintf(buf, UI_WIDGET_TEXT_MAX, "%ldm", (long)(value / 60));
+    } else {
+        snprintf(buf, UI_WIDGET_TEXT_MAX, "%ldm%lds", (long)(value / 60), (long)(value % 60));
     }
 }
 
-/**
- * @brief 睡眠时间设置菜单 - 交互式时间调节
- */
 void MENU_SleepSetting(void)
 {
-    char sleep_str[32];
-    
-    while (1)
-    {
-        menu_command_callback(BUFFER_CLEAR);
-        
-        // 显示标题
-        menu_command_callback(SHOW_STRING, 20, 0, "Sleep Setting", OLED_8X16);
-        
-        // 显示睡眠时间标签
-        menu_command_callback(SHOW_STRING, 5, 20, "Auto Sleep:", OLED_8X16);
-        
-        // 显示睡眠时间（人性化格式化：<60s 显示秒，>=60s 显示 m/s 组合，0 表示 OFF）
-        if (auto_sleep_seconds == 0) {
-            sprintf(sleep_str, "OFF");
-        } else if (auto_sleep_seconds < 60) {
-            sprintf(sleep_str, "%ds", auto_sleep_seconds);
-        } else {
-            uint16_t minutes = auto_sleep_seconds / 60;
-            uint16_t seconds = auto_sleep_seconds % 60;
-            if (seconds == 0) {
-                sprintf(sleep_str, "%dm", minutes);
-            } else {
-                sprintf(sleep_str, "%dm%ds", minutes, seconds);
-            }
-        }
-        menu_command_callback(SHOW_STRING, 90, 20, sleep_str, OLED_8X16);
-        
-        // 绘制时间设置进度条 (0-300秒 = 5分钟)
-        // 注意：进度条仅用于可视反馈，真正的息屏阈值来自 auto_sleep_seconds。
-        uint8_t progress_percent = (auto_sleep_seconds * 100) / 300;
-        if (progress_percent > 100) progress_percent = 100;
-        MENU_DrawProgressBar(5, 35, 118, 8, progress_percent);
-        
-        // 显示操作提示（可根据硬件按键/旋钮自定义文案）
-        menu_command_callback(SHOW_STRING, 5, 48, "Turn to adjust", OLED_8X16);
-        
-        menu_command_callback(BUFFER_DISPLAY);
-        
-        InputEvent event = MENU_ReceiveInputEvent();
-        if (event.type == INPUT_UP || event.type == INPUT_DOWN)
-        {
-            // 任意有效输入都视为"活动"，刷新 last_activity_time；若在睡眠则顺便唤醒
-            MENU_UpdateActivity(); // 更新活动时间
-            
-            // 调整睡眠时间
-            int16_t wheel_value = (event.type == INPUT_DOWN) ? event.value : -event.value;
-            int32_t new_sleep_time = auto_sleep_seconds + (wheel_value * 5); // 每次调整5秒
-            
-            // 限制范围 (0-300秒)
-            if (new_sleep_time < 0) new_sleep_time = 0;
-            if (new_sleep_time > 300) new_sleep_time = 300;
-            
-            auto_sleep_seconds = new_sleep_time;
-        }
-        
-        // 检查退出事件：确认或返回均退出本设置页并保留最新 auto_sleep_seconds
-        if (event.type == INPUT_ENTER || event.type == INPUT_BACK)
-        {
-            MENU_UpdateActivity();
-            Config_MarkDirty();
-            return;
-        }
-        osDelay(10);  // 使用 osDelay 让出 CPU
-    }
+    static const UI_Widget widget = {
+        .kind = UI_WIDGET_SPINNER,
+        .title = "Sleep Setting",
+        .label = "Timeout:",
+        .hint = "Turn to adjust",
+        .min = 0, .max = 300, .step = 5,
+        .get = MENU_GetSleepTime,
+        .set = MENU_SetSleepTime,
+        .format = MENU_FormatSleepTime,
+    };
+
+    Widget_Push(&widget);
 }
+
 /**
- * @brief 系统设置菜单
+ * @brief 系统设置 - 自动息屏开关（关闭前的时长在重新打开时恢复）
  */
-void MENU_SystemSetting(void)
+static uint16_t sleep_seconds_restore = 120;
+
+static int32_t MENU_GetAutoSleepOn(void)
 {
-    char auto_sleep_str[32];
-    
-    menu_command_callback(BUFFER_CLEAR);
-    
-    
-#if AUTO_SLEEP_ENABLED
-    if (auto_sleep_seconds == 0) {
-        sprintf(auto_sleep_str, "Auto Sleep: OFF");
-    } else if (auto_sleep_seconds < 60) {
-        sprintf(auto_sleep_str, "Auto Sleep: %ds", auto_sleep_seconds);
+    return auto_sleep_seconds != 0;
+}
+
+static void MENU_SetAutoSleepOn(int32_t on)
+{
+    if (on) {
+        auto_sleep_seconds = sleep_seconds_restore;
     } else {
-        uint16_t minutes = auto_sleep_seconds / 60;
-        uint16_t seconds = auto_sleep_seconds % 60;
-        if (seconds == 0) {
-            sprintf(auto_sleep_str, "Auto Sleep: %dm", minutes);
-        } else {
-            sprintf(auto_sleep_str, "Auto Sleep: %dm%ds", minutes, seconds);
-        }
-    }
-#else
-    sprintf(auto_sleep_str, "Auto Sleep: DISABLED");
-#endif
-    menu_command_callback(SHOW_STRING, 5, 16, auto_sleep_str, OLED_8X16);
-    
-    menu_command_callback(SHOW_STRING, 5, 32, "Language: ENG", OLED_8X16);
-    menu_command_callback(SHOW_STRING, 5, 48, "Press to return", OLED_8X16);
-    
-    menu_command_callback(BUFFER_DISPLAY);
-    
-    while (1)
-    {
-        InputEvent event = MENU_ReceiveInputEvent();
-        if (event.type == INPUT_ENTER || event.type == INPUT_BACK)
-        {
-            MENU_UpdateActivity(); // 仅在有输入时更新活动时间
-            return;
-        }
-        osDelay(10);  // 使用 osDelay 让出 CPU
+        sleep_seconds_restore = auto_sleep_seconds;
+        auto_sleep_seconds = 0;
     }
 }
 
+void MENU_SystemSetting(void)
+{
+    static const UI_Widget widget = {
+        .kind = UI_WIDGET_TOGGLE,
+        .title = "System",
+        .label = "Auto Sleep:",
+        .hint = "Language: ENG",
+        .min = 0, .max = 1, .step = 1,
+        .get = MENU_GetAutoSleepOn,
+        .set = MENU_SetAutoSleepOn,
+    };
+
+    Widget_Push(&widget);
+}
+
 /**
  * @brief 关于设置菜单
  */
+static const char *MENU_AboutLine(uint8_t row, char *buf)
+{
+    static const char *const lines[UI_WIDGET_LINES] = {"Version: v2.0", "Build: 2025", "Press to return"};
+
+    (void)buf;
+    return lines[row];
+}
+
 void MENU_AboutSetting(void)
 {
-    menu_command_callback(BUFFER_CLEAR);
-    
-    menu_command_callback(SHOW_STRING, 20, 0, "About Device", OLED_8X16);
-    menu_command_callback(SHOW_STRING, 5, 16, "Version: v2.0", OLED_8X16);
-    menu_command_callback(SHOW_STRING, 5, 32, "Build: 2025", OLED_8X16);
-    menu_command_callback(SHOW_STRING, 5, 48, "Press to return", OLED_8X16);
-    
-    menu_command_callback(BUFFER_DISPLAY);
-    
-    while (1)
-    {
-        InputEvent event = MENU_ReceiveInputEvent();
-        if (event.type == INPUT_ENTER || event.type == INPUT_BACK)
-        {
-            MENU_UpdateActivity(); // 更新活动时间
-            return;
-        }
-        osDelay(10);  // 使用 osDelay 让出 CPU
-    }
+    static const UI_Widget widget = {
+        .kind = UI_WIDGET_TEXT,
+        .title = "About Device",
+        .line = MENU_AboutLine,
+    };
+
+    Widget_Push(&widget);
 }
 
-void MENU_WIFISetting(void)
+static const char *MENU_WIFILine(uint8_t row, char *buf)
 {
-    const AppConfig *cfg = Config_Get();
+    const AppConfig *cfg;
     const char *ssid = "<default>";
-    char ssid_line[20];
     size_t ssid_len;
 
-    if (cfg != NULL)
+    switch (row)
     {
-        ssid_len = MENU_BoundedStrnlen(cfg->wifi_ssid, sizeof(cfg->wifi_ssid));
-        if ((ssid_len > 0U) && (ssid_len < sizeof(cfg->wifi_ssid)))
+    case 0:
+        cfg = Config_Get();
+        if (cfg != NULL)
         {
-            ssid = cfg->wifi_ssid;
+            ssid_len = MENU_BoundedStrnlen(cfg->wifi_ssid, sizeof(cfg->wifi_ssid));
+            if ((ssid_len > 0U) && (ssid_len < sizeof(cfg->wifi_ssid)))
+            {
+                ssid = cfg->wifi_ssid;
+            }
         }
+        (void)snprintf(buf, UI_WIDGET_TEXT_MAX, "SSID: %.13s", ssid);
+        return buf;
+    case 1: return "ENTER: Save";
+    case 2: return "BACK : Return";
+    default: return NULL;
     }
+}
+
+void MENU_WIFISetting(void)
+{
+    static const UI_Widget widget = {
+        .kind = UI_WIDGET_TEXT,
+        .title = "WIFI Setting",
+        .line = MENU_WIFILine,
+    };
+
+    Widget_Push(&widget);
+}
 
-    (void)snprintf(ssid_line, sizeof(ssid_line), "SSID: %.13s", ssid);
+/* ******************************************************** */
+/* 输入录制/回放（见 input_replay.h）：都先返回主菜单，从“光标停在 Tools”开始，回放时与录制时的起点一致 */
 
-    while (1)
+static void MENU_ReplayHome(void)
+{
+    if (Screen_Depth() > 1)
     {
-        menu_command_callback(BUFFER_CLEAR);
-        menu_command_callback(SHOW_STRING, 24, 0, "WIFI Setting", OLED_8X16);
-        menu_command_callback(SHOW_STRING, 0, 16, ssid_line, OLED_8X16);
-        menu_command_callback(SHOW_STRING, 0, 32, "ENTER: Save", OLED_8X16);
-        menu_command_callback(SHOW_STRING, 0, 48, "BACK : Return", OLED_8X16);
-        menu_command_callback(BUFFER_DISPLAY);
-
-        InputEvent event = MENU_ReceiveInputEvent();
-        if (event.type == INPUT_ENTER || event.type == INPUT_BACK)
-        {
-            MENU_UpdateActivity(); // 更新活动时间
-            return;
-        }
-        osDelay(10);  // 使用 osDelay 让出 CPU
+        Screen_Pop(); // Tools -> 主菜单（光标仍停在 Tools）
     }
 }
 
-/* 滚动条平滑动画参数（使用菜单系统自带的动画机制） */
-static float scrollbar_current_height = 0.0f;      // 当前滚动条高度（平滑值）
-static float scrollbar_target_height = 0.0f;       // 目标滚动条高度
+/**
+ * @brief 开始/停止录制输入；停止后由 TimeTask 上传记录
+ */
+void MENU_InputRecord(void)
+{
+    static char text[24];
+
+    if (InputReplay_Recording())
+    {
+        InputReplay_RecordStop();
+        snprintf(text, sizeof(text), "Saved %u events", (unsigned)InputReplay_RecordCount());
+        Popup_Show(text, POPUP_TOAST, 1500);
+        return;
+    }
+    MENU_ReplayHome();
+    InputReplay_RecordStart();
+    Popup_Show("Recording", POPUP_TOAST, 1000);
+}
 
+/**
+ * @brief 回放最近一次录制，没有录制时回放内置脚本；帧耗时统计从此清零，回放结束后上传
+ */
+void MENU_InputReplay(void)
+{
+    if (InputReplay_Recording())
+    {
+        return;
+    }
+    MENU_ReplayHome();
+    Profiler_Reset();
+    if (!InputReplay_PlayRecording())
+    {
+        InputReplay_Play(g_InputReplaySession, g_InputReplaySessionLen);
+    }
+    Input_Wake();
+}
 
 void MENU_DrawScrollBar(MENU_HandleTypeDef *hMENU)
 {
@@ -990,33 +1348,34 @@ void MENU_DrawScrollBar(MENU_HandleTypeDef *hMENU)
     // 只有当菜单项超过可显示数量时才显示滚动条
     if (hMENU->Option_Max_i <= CURSOR_CEILING) {
         // 重置动画参数
-        scrollbar_current_height = 0.0f;
-        scrollbar_target_height = 0.0f;
+        UI_Anim_Set(hMENU->AnimScrollBar, 0);
         return;
     }
     
     // 计算参数
-    uint8_t total_items = hMENU->Option_Max_i + 1;     // 总项目数
+    int32_t total_items = hMENU->Option_Max_i + 1;     // 总项目数（虚拟列表可达上万项）
     
     // 核心：滑块高度直接反映当前选中项在整个列表中的位置比例
     // 完全按照OLED_UI思想：ScrollBarHeight = TotalHeight * (CurrentItem+1) / TotalItems
-    float position_ratio = (float)(hMENU->Catch_i + 1) / (float)total_items;
-    scrollbar_target_height = scrollbar_height * position_ratio;
+    q16_t scrollbar_target_height = (q16_t)((int64_t)Q16_FROM_INT(scrollbar_height) * (hMENU->Catch_i + 1) / total_items);
     
     // 限制滑块高度范围（保证最小可见性）
-    if (scrollbar_target_height < 6.0f) scrollbar_target_height = 6.0f;
-    if (scrollbar_target_height > scrollbar_height - 2.0f) {
-        scrollbar_target_height = scrollbar_height - 2.0f;
+    if (scrollbar_target_height < Q16_FROM_INT(6)) scrollbar_target_height = Q16_FROM_INT(6);
+    if (scrollbar_target_height > Q16_FROM_INT(scrollbar_height - 2)) {
+        scrollbar_target_height = Q16_FROM_INT(scrollbar_height - 2);
     }
     
-    // 使用菜单系统自带的动画机制（与光标动画保持一致）
-    scrollbar_current_height = STEPWISE_TO_TARGET(scrollbar_current_height, scrollbar_target_height, ANIMATION_SPEED);
+    // 使用动画引擎按时间补间（与列表滚动一致）
+    if (hMENU->AnimScrollBar == UI_ANIM_NONE) {
+        hMENU->AnimScrollBar = UI_Anim_Alloc(0);
+    }
+    UI_Anim_TweenTo(hMENU->AnimScrollBar, scrollbar_target_height, ANIMATION_TIME_MS, UI_EASE_OUT_CUBIC);
     
     // 绘制滚动条轨道（简洁的细线样式）
     OLED_DrawLine(scrollbar_x + 1, scrollbar_y, scrollbar_x + 1, scrollbar_y + scrollbar_height - 1);
     
     // 计算实际绘制的滑块
-    uint8_t thumb_height = (uint8_t)(scrollbar_current_height + 0.5f); // 四舍五入
+    uint8_t thumb_height = (uint8_t)MENU_AnimValue(hMENU->AnimScrollBar, scrollbar_target_height); // 四舍五入
     if (thumb_height < 1) thumb_height = 1;
     
     // 滑块始终从顶部开始，高度表示位置（完全按照OLED_UI思想）
@@ -1048,25 +1407,55 @@ void MENU_DrawProgressBar(int16_t x, int16_t y, uint8_t width, uint8_t height, u
     }
 }
 
-#if SHOW_FPS
-void Update_FPS_Counter(void)
+/**
+ * @brief 更新覆盖层小部件的内容（FPS、倒计时、网络状态），只改文本不发送
+ */
+void MENU_UpdateOverlay(void)
+{
+    if (fps_visible) {
+        char fps_str[12];
+        snprintf(fps_str, sizeof(fps_str), "%lu", (unsigned long)Profiler_Fps());
+        Overlay_SetText(OVERLAY_FPS, fps_str);
+    }
+
+    MENU_ShowTimer();
+
+    // WiFi/MQTT 启动成功后在左下角常驻标记（错误码最高位为 1，需排除）
+    uint32_t flags = g_appEventFlags ? osEventFlagsGet(g_appEventFlags) : 0U;
+    uint8_t online = ((flags & osFlagsError) == 0U) && ((flags & APP_EVT_WIFI_OK) != 0U);
+    Overlay_SetText(OVERLAY_NET, online ? "MQ" : NULL);
+
+    // 联网状态由网络任务置位事件标志，UI 任务在此检测到上线时弹出提示条
+    static uint8_t was_online = 0;
+    if (online && !was_online) {
+        Popup_Show("WiFi online", POPUP_TOAST, 1500);
+    }
+    was_online = online;
+}
+
+/**
+ * @brief 显示/隐藏左上角帧率（默认 SHOW_FPS）
+ */
+void MENU_SetFpsVisible(uint8_t on)
 {
-    frame_count++;
-    uint32_t current_time = HAL_GetTick();
-    
-    // 每1000ms计算一次FPS
-    if(current_time - last_fps_time >= 1000) {
-        current_fps = frame_count;
-        frame_count = 0;
-        last_fps_time = current_time;
+    fps_visible = on;
+    if (!on) {
+        Overlay_SetText(OVERLAY_FPS, NULL);
     }
 }
 
-uint32_t Get_Current_FPS(void)
+/**
+ * @brief 静态页面等待输入时调用：小部件有变化才局部刷新，不重发整屏
+ */
+void MENU_RefreshOverlay(void)
 {
-    return current_fps;
+    ProfilerPhase phase;
+
+    MENU_UpdateOverlay();
+    phase = Profiler_Phase(PROFILER_TRANSFER);
+    Overlay_Refresh();
+    Profiler_Phase(phase);
 }
-#endif /* SHOW_FPS */
 
 void CLOCK_Draw(void)
 {
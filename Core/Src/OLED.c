@@ -79,6 +79,13 @@
   */
 uint8_t OLED_DisplayBuf[8][128];
 
+/**
+  * 传输时合成钩子及其单页暂存区
+  * 设置钩子后，发送每一页前先把该页复制到暂存区，由钩子叠加小部件后再发送
+  */
+static OLED_ComposeHook OLED_Compose = NULL;
+static uint8_t OLED_ComposeLine[128];
+
 /*********************全局变量*/
 
 
@@ -114,6 +121,18 @@ void OLED_WriteData(uint8_t *Data, uint16_t Count)
 	HAL_SPI_Transmit(&hspi1, Data, Count, HAL_MAX_DELAY);
 }
 
+/*返回第Page页实际要发送的数据：无合成钩子时直接是显存，否则为叠加后的暂存区*/
+static uint8_t *OLED_ComposePage(uint8_t Page)
+{
+	if (OLED_Compose == NULL)
+	{
+		return OLED_DisplayBuf[Page];
+	}
+	memcpy(OLED_ComposeLine, OLED_DisplayBuf[Page], 128);
+	OLED_Compose(Page, OLED_ComposeLine);
+	return OLED_ComposeLine;
+}
+
 /*********************通信协议*/
 
 
@@ -184,6 +203,32 @@ void OLED_SetBrightness(uint8_t brightness)
 	OLED_WriteCommand(brightness);	//对比度值 0x00~0xFF
 }
 
+/**
+  * 函    数：OLED进入睡眠
+  * 参    数：无
+  * 返 回 值：无
+  * 说    明：关闭显示并关闭充电泵，面板不再发光；GDDRAM内容保持不变
+  */
+void OLED_Sleep(void)
+{
+	OLED_WriteCommand(0xAE);	//关闭显示
+	OLED_WriteCommand(0x8D);	//设置充电泵
+	OLED_WriteCommand(0x10);	//关闭充电泵
+}
+
+/**
+  * 函    数：OLED退出睡眠
+  * 参    数：无
+  * 返 回 值：无
+  * 说    明：重新开启充电泵和显示，面板直接显示睡眠前GDDRAM中的画面，无需重新初始化和整屏发送
+  */
+void OLED_Wake(void)
+{
+	OLED_WriteCommand(0x8D);	//设置充电泵
+	OLED_WriteCommand(0x14);	//开启充电泵
+	OLED_WriteCommand(0xAF);	//开启显示
+}
+
 /**
   * 函    数：OLED设置显示光标位置
   * 参    数：Page 指定光标所在的页，范围：0~7
@@ -314,7 +359,7 @@ void OLED_Update(void)
 	OLED_DC_HIGH();
 	for (j = 0; j < 8; j++)
 	{
-		HAL_SPI_Transmit(&hspi1, OLED_DisplayBuf[j], 128, HAL_MAX_DELAY);
+		HAL_SPI_Transmit(&hspi1, OLED_ComposePage(j), 128, HAL_MAX_DELAY);
 	}
 }
 
@@ -365,10 +410,23 @@ void OLED_UpdateArea(int16_t X, int16_t Y, uint8_t Width, uint8_t Height)
 	OLED_DC_HIGH();
 	for (j = Page; j < Page1; j++)
 	{
-		HAL_SPI_Transmit(&hspi1, &OLED_DisplayBuf[j][X], Width, HAL_MAX_DELAY);
+		HAL_SPI_Transmit(&hspi1, &OLED_ComposePage(j)[X], Width, HAL_MAX_DELAY);
 	}
 }
 
+/**
+  * 函    数：设置传输时合成钩子
+  * 参    数：Hook 合成函数，NULL表示直接发送显存
+  * 返 回 值：无
+  * 说    明：钩子只作用于发送出去的数据，不修改OLED_DisplayBuf
+  *           用于FPS、倒计时等状态小部件：底层画面与小部件互不覆盖，
+  *           小部件变化时只需OLED_UpdateArea刷新它自己的区域
+  */
+void OLED_SetComposeHook(OLED_ComposeHook Hook)
+{
+	OLED_Compose = Hook;
+}
+
 /**
   * 函    数：将OLED显存数组全部清零
   * 参    数：无
@@ -761,6 +819,62 @@ void OLED_ShowImage(int16_t X, int16_t Y, uint8_t Width, uint8_t Height, const u
 	}
 }
 
+/**
+  * 函    数：OLED显示图像的一部分（横向窗口）
+  * 参    数：X 指定窗口左上角的横坐标，范围：-32768~32767，屏幕区域：0~127
+  * 参    数：Y 指定窗口左上角的纵坐标，范围：-32768~32767，屏幕区域：0~63
+  * 参    数：Width 指定窗口的宽度，范围：0~128
+  * 参    数：Height 指定图像的高度，范围：0~64
+  * 参    数：Image 指定要显示的图像，按页存放，每页ImageWidth字节
+  * 参    数：ImageWidth 指定图像的总宽度（每页的字节数），可以超过屏幕宽度
+  * 参    数：OffsetX 指定窗口在图像中的起始列，范围：0~ImageWidth-Width
+  * 返 回 值：无
+  * 说    明：用于显示宽于屏幕的离屏图像（如滚动字幕），只拷贝窗口内的列
+  *           调用此函数后，要想真正地呈现在屏幕上，还需调用更新函数
+  */
+void OLED_ShowImagePart(int16_t X, int16_t Y, uint8_t Width, uint8_t Height, const uint8_t *Image, uint16_t ImageWidth, uint16_t OffsetX)
+{
+	uint8_t i = 0, j = 0;
+	int16_t Page, Shift;
+	
+	/*将窗口所在区域清空*/
+	OLED_ClearArea(X, Y, Width, Height);
+	
+	/*负数坐标在计算页地址和移位时需要加一个偏移*/
+	Page = Y / 8;
+	Shift = Y % 8;
+	if (Y < 0)
+	{
+		Page -= 1;
+		Shift += 8;
+	}
+	
+	/*遍历图像涉及的相关页*/
+	for (j = 0; j < (Height - 1) / 8 + 1; j ++)
+	{
+		/*遍历窗口内的相关列*/
+		for (i = 0; i < Width; i ++)
+		{
+			if (X + i >= 0 && X + i <= 127)		//超出屏幕的内容不显示
+			{
+				uint8_t Data = Image[j * ImageWidth + OffsetX + i];
+				
+				if (Page + j >= 0 && Page + j <= 7)		//超出屏幕的内容不显示
+				{
+					/*显示图像在当前页的内容*/
+					OLED_DisplayBuf[Page + j][X + i] |= Data << (Shift);
+				}
+				
+				if (Page + j + 1 >= 0 && Page + j + 1 <= 7)		//超出屏幕的内容不显示
+				{
+					/*显示图像在下一页的内容*/
+					OLED_DisplayBuf[Page + j + 1][X + i] |= Data >> (8 - Shift);
+				}
+			}
+		}
+	}
+}
+
 /**
   * 函    数：OLED使用printf函数打印格式化字符串
   * 参    数：X 指定格式化字符串左上角的横坐标，范围：-32768~32767，屏幕区域：0~127
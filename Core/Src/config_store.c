@@ -162,6 +162,29 @@ void Config_FlushIfNeeded(void)
         return;
     }
 
+    Config_Flush();
+}
+
+uint32_t Config_MsUntilFlush(void)
+{
+    uint32_t dirty_ms;
+
+    if (!g_dirty)
+    {
+        return UINT32_MAX;
+    }
+
+    dirty_ms = HAL_GetTick() - g_dirty_tick;
+    return (dirty_ms >= CONFIG_FLUSH_DELAY) ? 0U : (CONFIG_FLUSH_DELAY - dirty_ms);
+}
+
+void Config_Flush(void)
+{
+    if (!g_dirty)
+    {
+        return;
+    }
+
     g_dirty = 0;
 
     sync_from_globals();
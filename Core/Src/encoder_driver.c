@@ -11,7 +11,6 @@
 
 
 #define KEY_DEBOUNCE_TICKS  pdMS_TO_TICKS(20U)
-#define KEY_LONG_TICKS      pdMS_TO_TICKS(800U)
 
 // ===== 编码器消抖参数 =====
 
@@ -31,63 +30,82 @@ void Encoder_Init(void)
     __HAL_TIM_SET_COUNTER(&htim1, 0);
 }
 
+// ===== 按键状态（KeyPress 与截止时间查询共用） =====
+static uint8_t key_last_level = 1;          // 最近一次采样/中断后的电平
+static uint8_t key_stable_level = 1;        // 消抖后的电平
+static TickType_t key_change_tick = 0;      // 最近一次电平跳变（或抖动沿）的时刻
+
+static volatile uint8_t key_edge = 0;       // 中断里记录的沿，KeyPress 取走
+static volatile TickType_t key_edge_tick = 0;
+
+/**
+ * @brief 按键沿中断（EXTI6 双边沿）：只记录时刻，消抖判定在 InputTask 中完成
+ */
+void Key_OnEdgeFromISR(void)
+{
+    key_edge_tick = xTaskGetTickCountFromISR();
+    key_edge = 1;
+}
+
 KeyPressState KeyPress(void)
 {
     // 约定：GPIO 低电平=按下（上拉输入）
     const uint8_t raw_level = (HAL_GPIO_ReadPin(GPIOB, GPIO_PIN_6) == GPIO_PIN_RESET) ? 0 : 1;
     const TickType_t now = xTaskGetTickCount();
 
-    // 去抖：检测输入稳定 KEY_DEBOUNCE_MS 之后才算有效变化
-    static uint8_t last_level = 0;
-    static uint8_t stable_level = 0;
-    static TickType_t last_change_tick = 0;
-
-    static uint8_t pressed = 0;
-    static TickType_t press_tick = 0;
-    static uint8_t long_reported = 0;
-
-    if (raw_level != last_level)
+    // 去抖：最后一个沿之后稳定 KEY_DEBOUNCE_TICKS 才算有效变化；
+    // 沿由中断记录，比采样间隔还短的抖动也会重新开始计时
+    if (key_edge)
     {
-        last_level = raw_level;
-        last_change_tick = now;
+        key_edge = 0;
+        key_change_tick = key_edge_tick;
+        key_last_level = raw_level;
     }
-
-    // 输入稳定足够长时间后，确认一次“有效跳变”
-    if (((now - last_change_tick) >= KEY_DEBOUNCE_TICKS) && stable_level != last_level)
+    else if (raw_level != key_last_level)
     {
-        stable_level = last_level;
-
-        if (stable_level == 0)
-        {
-            // 进入按下
-            pressed = 1;
-            press_tick = now;
-            long_reported = 0;
-        }
-        else
-        {
-            // 进入松开：若之前没有触发长按，则判定短按事件
-            if (pressed)
-            {
-                pressed = 0;
-                if (!long_reported)
-                {
-                    return KEY_SHORT_PRESSED;
-                }
-            }
-        }
+        key_last_level = raw_level;
+        key_change_tick = now;
     }
 
-    // 长按：按住达到阈值就上报一次
-    if (pressed && !long_reported && ((now - press_tick) >= KEY_LONG_TICKS))
+    // 输入稳定足够长时间后，确认一次“有效跳变”；短按/长按/双击等由 input.c 的手势识别判定
+    if (((now - key_change_tick) >= KEY_DEBOUNCE_TICKS) && key_stable_level != key_last_level)
     {
-        long_reported = 1;
-        return KEY_LONG_PRESSED;
+        key_stable_level = key_last_level;
+        return (key_stable_level == 0) ? KEY_DOWN : KEY_UP;
     }
 
     return KEY_UNPRESSED;
 }
 
+/**
+ * @brief 最近一次有效跳变（消抖前的最后一个沿）的时刻，即按下/松开的时刻
+ */
+uint32_t KeyPress_EdgeTick(void)
+{
+    return (uint32_t)key_change_tick * portTICK_PERIOD_MS;
+}
+
+/**
+ * @brief 距按键消抖到期的毫秒数
+ * @return 没有待定的判定时返回 UINT32_MAX（只等中断）
+ */
+uint32_t KeyPress_MsUntilDeadline(void)
+{
+    const TickType_t now = xTaskGetTickCount();
+    TickType_t elapsed;
+
+    if (key_edge)
+    {
+        return 0;
+    }
+    if (key_stable_level != key_last_level)
+    {
+        elapsed = now - key_change_tick;
+        return (elapsed >= KEY_DEBOUNCE_TICKS) ? 0U : (uint32_t)(KEY_DEBOUNCE_TICKS - elapsed) * portTICK_PERIOD_MS;
+    }
+    return UINT32_MAX;
+}
+
 /**
  * @brief 获取编码器原始增量（无消抖）
  * @return 原始脉冲增量
@@ -110,6 +128,14 @@ int16_t Encoder_RawDelta(void)
     return delta;
 }
 
+// ===== 编码器消抖状态（Encoder_Roll 与截止时间查询共用） =====
+static int16_t accumulator = 0;         // 脉冲累积器
+static int8_t  locked_dir = 0;          // 锁定方向：1=正向, -1=反向, 0=未锁定
+static int8_t start_window = 0;         // 起步确认窗口标志
+static int32_t start_tick = 0;          // 起步窗口起始时刻
+static int32_t dir_tick = 0;            // 最近一次“同方向”脉冲时刻（用于锁定超时）
+static int32_t last_output_tick = 0;    // 上次有效输出时刻
+
 /**
  * @brief 编码器消抖读取
  * @return 消抖后的"格数"变化（正=顺时针，负=逆时针，0=无变化）
@@ -121,13 +147,6 @@ int16_t Encoder_RawDelta(void)
  */
 int16_t Encoder_Roll(void)
 {
-    static int16_t accumulator = 0;         // 脉冲累积器
-    static int8_t  locked_dir = 0;          // 锁定方向：1=正向, -1=反向, 0=未锁定
-    static int8_t start_window = 0;       // 起步确认窗口标志
-    static int32_t start_tick = 0;        // 起步窗口起始时刻
-    static int32_t dir_tick = 0;          // 最近一次“同方向”脉冲时刻（用于锁定超时）
-    static int32_t last_output_tick = 0;  // 上次有效输出时刻
-
     const int32_t now = HAL_GetTick();
     const int16_t raw_delta = Encoder_RawDelta();
 
@@ -248,4 +267,27 @@ int16_t Encoder_Roll(void)
     }
 
     return output;
-} 
+}
+
+/**
+ * @brief 距编码器下一次需要结算（起步窗口到期、限速后输出余下的格数）的毫秒数
+ * @return 没有待结算的脉冲时返回 UINT32_MAX（只等 A/B 相中断）
+ * @note  方向锁定超时不需要定时唤醒：下一次读取时按时间判断即可
+ */
+uint32_t Encoder_MsUntilDeadline(void)
+{
+    const int32_t now = HAL_GetTick();
+    int32_t left;
+
+    if (start_window)
+    {
+        left = ENCODER_START_DEBOUNCE_MS - (int32_t)(now - start_tick);
+        return (left > 0) ? (uint32_t)left : 0U;
+    }
+    if (accumulator >= ENCODER_PULSE_PER_DETENT || accumulator <= -ENCODER_PULSE_PER_DETENT)
+    {
+        left = ENCODER_MIN_INTERVAL_MS - (int32_t)(now - last_output_tick);
+        return (left > 0) ? (uint32_t)left : 0U;
+    }
+    return UINT32_MAX;
+}
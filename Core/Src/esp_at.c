@@ -8,6 +8,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include "esp_at.h"
 #include "cmsis_os.h"
+#include "low_power.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -56,11 +57,17 @@ void ESP_AT_Send(const char* cmd) {
   * @brief  Send AT command and wait for specific string
   */
 bool ESP_AT_SendWaitFor(const char* cmd, const char* expect, uint32_t timeout_ms) {
+    bool ok;
     if (!cmd || !expect) return false;
+
+    // 等待应答期间不能进入 STOP（串口在 STOP 下收不到数据）
+    LowPower_Hold();
     ESP_Driver_FlushBuffer();
     uart_send((const uint8_t*)cmd, strlen(cmd));
     uart_send((const uint8_t*)"\r\n", 2);
-    return ESP_AT_WaitFor(expect, timeout_ms);
+    ok = ESP_AT_WaitFor(expect, timeout_ms);
+    LowPower_Release();
+    return ok;
 }
 
 /**
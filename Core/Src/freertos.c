@@ -32,6 +32,12 @@
 #include "app_events.h"
 #include "wifi_task.h"
 #include "time_task.h"
+#include "low_power.h"
+#include "ui_profiler.h"
+#include "timer_service.h"
+#include "input_queue.h"
+#include "input_replay.h"
+#include <stdio.h>
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -129,6 +135,7 @@ void MX_FREERTOS_Init(void) {
 
   /* USER CODE BEGIN RTOS_TIMERS */
   /* start timers, add new ones, ... */
+  TimerSvc_Init(); /* 倒计时/提醒服务的软件定时器 */
   /* USER CODE END RTOS_TIMERS */
 
   /* Create the queue(s) */
@@ -178,13 +185,24 @@ void StartInputTask(void *argument)
   /* Infinite loop */
   for(;;)
   {
-	InputEvent event = Input_GetEvent();
-    if(event.type != INPUT_NONE)
+    /* 阻塞到按键/编码器中断，或消抖、长按等待定判定的截止时间；静止时不再周期唤醒 */
+    osThreadFlagsWait(INPUT_FLAG_EDGE, osFlagsWaitAny, Input_MsUntilDeadline());
+    InputQueue_Flush(); /* UI 已取空队列时送出暂存的旋转 */
+    for(;;)
     {
-      // 发送事件到队列，Menu任务会接收
-      osMessageQueuePut(InputEventQueueHandle, &event, 0, 0);
+      InputEvent event = Input_GetEvent();
+      if(event.type == INPUT_NONE)
+      {
+        break;
+      }
+      if(InputReplay_Playing())
+      {
+        InputReplay_Stop(); /* 回放中转动旋钮或按键：中止回放，把控制交还给用户 */
+      }
+      // 发送事件到队列，Menu任务会接收：连续同向旋转合并，按键不丢（队列满时等待）
+      InputQueue_Post(&event);
     }
-    osDelay(10);
+    InputReplay_Poll(HAL_GetTick()); /* 回放：到点的录制/脚本事件经同一路径入队 */
   }
   /* USER CODE END StartInputTask */
 }
@@ -212,6 +230,7 @@ void StartMenuTask(void *argument)
   for(;;)
   {
     if (ui_state == UI_CLOCK) {
+      MENU_CheckAutoSleep(); /* 超时则息屏并阻塞到唤醒，睡眠期间不再刷新时钟 */
       CLOCK_Draw();
       if (InputEventQueueHandle) {
         InputEvent event;
@@ -300,6 +319,14 @@ sntp_exit:
   }
   SNTP_Time_t current_time;
   char time_str[32] = {0};
+  char power_str[96];
+  char frame_str[192];
+  char input_str[96];
+  char replay_str[224];
+  uint32_t power_reported_wakes = 0;
+  uint32_t input_reported_overflows = 0;
+  uint32_t replay_reported_recordings = 0;
+  uint32_t replay_reported_replays = 0;
 
   /* Infinite loop - 每 10 秒上传一次时间 */
   for(;;)
@@ -315,6 +342,56 @@ sntp_exit:
     } else {
       WIFI_MQTT_Publish("RADAR/TIME", "Get Time Failed");
     }
+
+    /* 每次息屏唤醒后上报一次低功耗统计：STOP 驻留时间与唤醒到亮屏延迟 */
+    LowPower_Stats power = LowPower_GetStats();
+    if (power.wakes != power_reported_wakes && !screen_sleeping) {
+      power_reported_wakes = power.wakes;
+      snprintf(power_str, sizeof(power_str),
+               "wakes=%lu stop_ms=%lu sleep_ms=%lu wake_ms=%lu wake_max_ms=%lu",
+               (unsigned long)power.wakes, (unsigned long)power.stop_ms,
+               (unsigned long)power.sleep_ms, (unsigned long)power.wake_latency_ms,
+               (unsigned long)power.wake_latency_max_ms);
+      WIFI_MQTT_Publish("RADAR/POWER", power_str);
+    }
+
+    /* 输入队列出现过满队列（UI 卡顿）时上报一次合并/背压统计 */
+    InputQueueStats input;
+    InputQueue_GetStats(&input);
+    if (input.overflows != input_reported_overflows) {
+      input_reported_overflows = input.overflows;
+      snprintf(input_str, sizeof(input_str),
+               "posted=%lu coalesced=%lu overflows=%lu dropped=%lu max_depth=%lu",
+               (unsigned long)input.posted, (unsigned long)input.coalesced,
+               (unsigned long)input.overflows, (unsigned long)input.dropped,
+               (unsigned long)input.max_depth);
+      WIFI_MQTT_Publish("RADAR/INPUT", input_str);
+    }
+
+    /* 录制结束后分段上传输入记录；回放结束后上传这一段的帧耗时统计（回放开始时已清零） */
+    InputReplayStats replay;
+    InputReplay_GetStats(&replay);
+    if (replay.recordings != replay_reported_recordings && !InputReplay_Recording()) {
+      uint16_t first = 0, n;
+      replay_reported_recordings = replay.recordings;
+      while ((n = InputReplay_FormatRecords(first, replay_str, sizeof(replay_str))) != 0U) {
+        WIFI_MQTT_Publish("RADAR/REPLAY", replay_str);
+        first += n;
+      }
+    }
+    if (replay.replays != replay_reported_replays && !InputReplay_Playing()) {
+      int len;
+      replay_reported_replays = replay.replays;
+      len = snprintf(replay_str, sizeof(replay_str), "done ms=%lu ", (unsigned long)replay.last_ms);
+      Profiler_Format(replay_str + len, sizeof(replay_str) - (uint32_t)len);
+      WIFI_MQTT_Publish("RADAR/REPLAY", replay_str);
+    }
+
+    /* 帧耗时统计（累计值，拷机时按时间序列观察 p95/p99 的变化） */
+    if (!screen_sleeping) {
+      Profiler_Format(frame_str, sizeof(frame_str));
+      WIFI_MQTT_Publish("RADAR/FRAME", frame_str);
+    }
     osDelay(10000);  // 10 秒
   }
   /* USER CODE END StartTimeTask */
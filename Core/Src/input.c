@@ -6,46 +6,348 @@
  */
 #include "input.h"
 #include "encoder_driver.h"
+#include "input_accel.h"
+#include "input_queue.h"
+#include "input_replay.h"
+#include "tim.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "cmsis_os.h"
+#include "low_power.h"
 
-InputEvent Input_GetEvent(void) // 获取输入事件
+extern osThreadId_t InputTaskHandle;
+
+static volatile uint32_t s_encoder_edge_ms; // 最近一个编码器 A/B 相沿的时刻
+
+static volatile bool s_capture;             // 按下时刻捕获已打开
+static volatile bool s_stamp_valid;
+static volatile bool s_stamp_latched;       // 本次按下已记录，消抖后的松开之前不再记录
+static volatile uint32_t s_stamp_us;        // 最近一次按下时刻
+
+void Input_Init(void)
+{
+    __HAL_RCC_SYSCFG_CLK_ENABLE();
+
+    /* EXTI6 -> PB6，EXTI8/9 -> PA8/PA9 */
+    MODIFY_REG(SYSCFG->EXTICR[1], SYSCFG_EXTICR2_EXTI6, SYSCFG_EXTICR2_EXTI6_PB);
+    MODIFY_REG(SYSCFG->EXTICR[2], SYSCFG_EXTICR3_EXTI8 | SYSCFG_EXTICR3_EXTI9,
+               SYSCFG_EXTICR3_EXTI8_PA | SYSCFG_EXTICR3_EXTI9_PA);
+
+    SET_BIT(EXTI->FTSR, EXTI_FTSR_TR6 | EXTI_FTSR_TR8 | EXTI_FTSR_TR9);
+    SET_BIT(EXTI->RTSR, EXTI_RTSR_TR6 | EXTI_RTSR_TR8 | EXTI_RTSR_TR9);
+    WRITE_REG(EXTI->PR, EXTI_PR_PR6 | EXTI_PR_PR8 | EXTI_PR_PR9);
+    SET_BIT(EXTI->IMR, EXTI_IMR_MR6 | EXTI_IMR_MR8 | EXTI_IMR_MR9);
+
+    /* 回调里调用 osThreadFlagsSet，优先级不能高于 configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY */
+    HAL_NVIC_SetPriority(EXTI9_5_IRQn, 6, 0);
+    HAL_NVIC_EnableIRQ(EXTI9_5_IRQn);
+}
+
+/* ========= 手势识别：表驱动状态机 ========= */
+
+typedef enum
+{
+    GESTURE_IDLE = 0,
+    GESTURE_PRESSED,        // 按下，等待松开/长按
+    GESTURE_HELD,           // 已产生长按 BACK，等待松开
+    GESTURE_REPEATING,      // 按住连发中
+    GESTURE_ROTATING,       // 按住旋转中（松开不产生 ENTER）
+    GESTURE_CLICKED,        // 单击已松开，等待第二次按下
+    GESTURE_PRESSED2,       // 第二次按下
+} GestureState;
+
+typedef enum
+{
+    GESTURE_IN_DOWN = 0,
+    GESTURE_IN_UP,
+    GESTURE_IN_ROTATE,
+    GESTURE_IN_TIMEOUT,
+} GestureInput;
+
+typedef enum
+{
+    GESTURE_EMIT_NONE = 0,
+    GESTURE_EMIT_ENTER,
+    GESTURE_EMIT_BACK,
+    GESTURE_EMIT_DOUBLE,
+    GESTURE_EMIT_REPEAT,
+    GESTURE_EMIT_ROTATE,        // 原样输出旋转
+    GESTURE_EMIT_ROTATE_HELD,   // 旋转加 INPUT_MOD_HELD、放大步数
+} GestureEmit;
+
+#define GESTURE_KEEP    0xFFFFU // 超时：保持当前截止时间
+
+typedef struct
+{
+    uint8_t state;          // GestureState
+    uint8_t input;          // GestureInput
+    uint8_t gesture;        // 需要使能的手势，0 = 总是适用
+    uint8_t next;           // GestureState
+    uint8_t emit;           // GestureEmit
+    uint16_t timeout_ms;    // 转移后的超时，0 = 无，GESTURE_KEEP = 保持
+} GestureRule;
+
+/* 按顺序匹配第一条（状态、输入相同且手势已使能）的规则；没有匹配的输入忽略 */
+static const GestureRule s_gesture_rules[] = {
+    {GESTURE_IDLE,      GESTURE_IN_DOWN,    INPUT_GESTURE_REPEAT,       GESTURE_PRESSED,   GESTURE_EMIT_NONE,        INPUT_REPEAT_DELAY_MS},
+    {GESTURE_IDLE,      GESTURE_IN_DOWN,    0,                          GESTURE_PRESSED,   GESTURE_EMIT_NONE,        INPUT_LONG_MS},
+    {GESTURE_IDLE,      GESTURE_IN_ROTATE,  0,                          GESTURE_IDLE,      GESTURE_EMIT_ROTATE,      0},
+
+    {GESTURE_PRESSED,   GESTURE_IN_UP,      INPUT_GESTURE_DOUBLE,       GESTURE_CLICKED,   GESTURE_EMIT_ENTER,       INPUT_DOUBLE_MS},
+    {GESTURE_PRESSED,   GESTURE_IN_UP,      0,                          GESTURE_IDLE,      GESTURE_EMIT_ENTER,       0},
+    {GESTURE_PRESSED,   GESTURE_IN_ROTATE,  INPUT_GESTURE_PRESS_ROTATE, GESTURE_ROTATING,  GESTURE_EMIT_ROTATE_HELD, 0},
+    {GESTURE_PRESSED,   GESTURE_IN_ROTATE,  0,                          GESTURE_PRESSED,   GESTURE_EMIT_ROTATE,      GESTURE_KEEP},
+    {GESTURE_PRESSED,   GESTURE_IN_TIMEOUT, INPUT_GESTURE_REPEAT,       GESTURE_REPEATING, GESTURE_EMIT_REPEAT,      INPUT_REPEAT_MS},
+    {GESTURE_PRESSED,   GESTURE_IN_TIMEOUT, 0,                          GESTURE_HELD,      GESTURE_EMIT_BACK,        0},
+
+    {GESTURE_HELD,      GESTURE_IN_UP,      0,                          GESTURE_IDLE,      GESTURE_EMIT_NONE,        0},
+    {GESTURE_HELD,      GESTURE_IN_ROTATE,  0,                          GESTURE_HELD,      GESTURE_EMIT_ROTATE,      0},
+
+    {GESTURE_REPEATING, GESTURE_IN_TIMEOUT, 0,                          GESTURE_REPEATING, GESTURE_EMIT_REPEAT,      INPUT_REPEAT_MS},
+    {GESTURE_REPEATING, GESTURE_IN_UP,      0,                          GESTURE_IDLE,      GESTURE_EMIT_NONE,        0},
+    {GESTURE_REPEATING, GESTURE_IN_ROTATE,  0,                          GESTURE_REPEATING, GESTURE_EMIT_ROTATE,      GESTURE_KEEP},
+
+    {GESTURE_ROTATING,  GESTURE_IN_ROTATE,  0,                          GESTURE_ROTATING,  GESTURE_EMIT_ROTATE_HELD, 0},
+    {GESTURE_ROTATING,  GESTURE_IN_UP,      0,                          GESTURE_IDLE,      GESTURE_EMIT_NONE,        0},
+
+    {GESTURE_CLICKED,   GESTURE_IN_DOWN,    0,                          GESTURE_PRESSED2,  GESTURE_EMIT_NONE,        INPUT_LONG_MS},
+    {GESTURE_CLICKED,   GESTURE_IN_ROTATE,  0,                          GESTURE_IDLE,      GESTURE_EMIT_ROTATE,      0},
+    {GESTURE_CLICKED,   GESTURE_IN_TIMEOUT, 0,                          GESTURE_IDLE,      GESTURE_EMIT_NONE,        0},
+
+    {GESTURE_PRESSED2,  GESTURE_IN_UP,      0,                          GESTURE_IDLE,      GESTURE_EMIT_DOUBLE,      0},
+    {GESTURE_PRESSED2,  GESTURE_IN_ROTATE,  INPUT_GESTURE_PRESS_ROTATE, GESTURE_ROTATING,  GESTURE_EMIT_ROTATE_HELD, 0},
+    {GESTURE_PRESSED2,  GESTURE_IN_ROTATE,  0,                          GESTURE_PRESSED2,  GESTURE_EMIT_ROTATE,      GESTURE_KEEP},
+    {GESTURE_PRESSED2,  GESTURE_IN_TIMEOUT, 0,                          GESTURE_HELD,      GESTURE_EMIT_BACK,        0},
+};
+
+static volatile uint8_t s_gestures;         // 栈顶界面使能的手势（UI 任务写，InputTask 读）
+static uint8_t s_gesture_state = GESTURE_IDLE;
+static bool s_gesture_armed;                // 有超时
+static uint32_t s_gesture_deadline;
+static KeyPressState s_key_pending = KEY_UNPRESSED; // 已消抖、尚未送入状态机的按键沿
+static uint32_t s_key_pending_tick;
+
+void Input_SetGestures(uint8_t gestures)
+{
+    s_gestures = gestures;
+}
+
+/* 送入一个输入，按规则转移并生成事件；at 为输入发生的时刻，rotation 为旋转输入的原始事件 */
+static InputEvent Input_GestureStep(GestureInput input, uint32_t at, const InputEvent *rotation)
 {
-    InputEvent event;
-    // 初始化默认值
-    event.type = INPUT_NONE;
-    event.value = 0;
+    InputEvent event = {.type = INPUT_NONE, .time = at};
+    const GestureRule *rule = NULL;
+    uint8_t enabled = s_gestures;
 
-    // 1. 处理按键
-    KeyPressState key_press = KeyPress();
-    if(key_press == KEY_SHORT_PRESSED)
+    for (uint8_t i = 0; i < sizeof(s_gesture_rules) / sizeof(s_gesture_rules[0]); i++)
     {
-        event.type = INPUT_ENTER;
-        event.value = 1;
-        return event; // 优先返回按键
+        const GestureRule *r = &s_gesture_rules[i];
+        if (r->state == s_gesture_state && r->input == input && (r->gesture & enabled) == r->gesture)
+        {
+            rule = r;
+            break;
+        }
     }
-    else if(key_press == KEY_LONG_PRESSED)
+    if (rule == NULL)
     {
+        return event;
+    }
+
+    s_gesture_state = rule->next;
+    if (rule->timeout_ms != GESTURE_KEEP)
+    {
+        s_gesture_armed = (rule->timeout_ms != 0U);
+        s_gesture_deadline = at + rule->timeout_ms;
+    }
+
+    switch (rule->emit)
+    {
+    case GESTURE_EMIT_ENTER:
+        event.type = INPUT_ENTER;
+        event.value = 1;
+        break;
+
+    case GESTURE_EMIT_BACK:
         event.type = INPUT_BACK;
         event.value = 2;
-        return event;
+        break;
+
+    case GESTURE_EMIT_DOUBLE:
+        event.type = INPUT_DOUBLE;
+        event.value = 1;
+        break;
+
+    case GESTURE_EMIT_REPEAT:
+        event.type = INPUT_REPEAT;
+        event.value = 1;
+        break;
+
+    case GESTURE_EMIT_ROTATE:
+        event = *rotation;
+        break;
+
+    case GESTURE_EMIT_ROTATE_HELD:
+        event = *rotation;
+        event.mods |= INPUT_MOD_HELD;
+        if (event.steps < event.value * INPUT_HELD_GAIN)
+        {
+            event.steps = (int16_t)(event.value * INPUT_HELD_GAIN);
+        }
+        if (event.steps > INPUT_ACCEL_MAX_STEPS)
+        {
+            event.steps = INPUT_ACCEL_MAX_STEPS;
+        }
+        break;
+
+    default:
+        break;
     }
+    return event;
+}
 
-    // 2. 处理编码器
-    // 直接调用 Encoder_Roll 获取原始增量 (正数=CW, 负数=CCW)
-    int16_t roll = Encoder_Roll(); 
+uint32_t Input_MsUntilDeadline(void)
+{
+    uint32_t key = KeyPress_MsUntilDeadline();
+    uint32_t enc = Encoder_MsUntilDeadline();
+    uint32_t retry = InputQueue_MsUntilRetry();   // 尾槽里有暂存的旋转，等 UI 取空队列
+    uint32_t replay = InputReplay_MsUntilNext(HAL_GetTick());
+    uint32_t ms = (key < enc) ? key : enc;
 
-    if(roll != 0)
+    if (retry < ms) ms = retry;
+    if (replay < ms) ms = replay;
+    if (s_gesture_armed || s_key_pending != KEY_UNPRESSED)
+    {
+        int32_t left = (s_key_pending != KEY_UNPRESSED) ? 0 : (int32_t)(s_gesture_deadline - HAL_GetTick());
+        uint32_t gesture = (left > 0) ? (uint32_t)left : 0U;
+        if (gesture < ms) ms = gesture;
+    }
+
+    return (ms == UINT32_MAX) ? osWaitForever : ms;
+}
+
+void Input_Wake(void)
+{
+    osThreadFlagsSet(InputTaskHandle, INPUT_FLAG_EDGE);
+}
+
+InputEvent Input_GetEvent(void) // 获取输入事件
+{
+    InputEvent event = {.type = INPUT_NONE};
+    uint32_t now = HAL_GetTick();
+
+    // 1. 按键与手势超时：按发生的先后送入状态机（任务晚醒时，先到期的长按不能排在松开之后）
+    if (s_key_pending == KEY_UNPRESSED)
+    {
+        s_key_pending = KeyPress();
+        s_key_pending_tick = KeyPress_EdgeTick();
+    }
+    while (event.type == INPUT_NONE)
     {
-        if(roll > 0)
+        bool timeout = s_gesture_armed && (int32_t)(now - s_gesture_deadline) >= 0;
+
+        if (timeout && (s_key_pending == KEY_UNPRESSED || (int32_t)(s_key_pending_tick - s_gesture_deadline) >= 0))
+        {
+            s_gesture_armed = false;
+            event = Input_GestureStep(GESTURE_IN_TIMEOUT, s_gesture_deadline, NULL);
+        }
+        else if (s_key_pending != KEY_UNPRESSED)
         {
-            event.type = INPUT_DOWN; // 顺时针 -> 向下/增加
-            event.value = roll;      // 记录转了多少格 (正数)
+            GestureInput input = (s_key_pending == KEY_DOWN) ? GESTURE_IN_DOWN : GESTURE_IN_UP;
+            s_key_pending = KEY_UNPRESSED;
+            if (input == GESTURE_IN_UP)
+            {
+                s_stamp_latched = false; // 松开已消抖，抖动沿都已过去，下一次按下重新记录
+            }
+            event = Input_GestureStep(input, s_key_pending_tick, NULL);
         }
         else
         {
-            event.type = INPUT_UP;   // 逆时针 -> 向上/减少
-            event.value = -roll;     // 记录转了多少格 (取反变正数，方便上层使用)
+            break;
         }
     }
+    if (event.type != INPUT_NONE)
+    {
+        return event; // 优先返回按键
+    }
+
+    // 2. 处理编码器
+    // Encoder_Roll 给出消抖后的格数 (正数=CW, 负数=CCW)，按出格间隔估计转速并加速
+    int16_t roll = Encoder_Roll(); 
+
+    if(roll != 0)
+    {
+        // 顺时针 -> INPUT_DOWN，逆时针 -> INPUT_UP；value 为格数（正数），steps 为加速后的步数
+        InputEvent rotation = InputAccel_Rotation(roll, s_encoder_edge_ms); // 按沿的时刻估计转速，不受任务调度影响
+        event = Input_GestureStep(GESTURE_IN_ROTATE, rotation.time, &rotation);
+    }
 
     return event;
 }
+
+uint32_t Input_TimestampUs(void)
+{
+    return TIM5_TIMESTAMP_US();
+}
+
+void Input_SetPressCapture(bool on)
+{
+    s_stamp_valid = false;
+    s_stamp_latched = false;
+    s_capture = on;
+}
+
+bool Input_PressCaptureEnabled(void)
+{
+    return s_capture;
+}
+
+bool Input_TakePressStamp(uint32_t *stamp_us)
+{
+    bool valid;
+
+    taskENTER_CRITICAL();
+    valid = s_stamp_valid;
+    *stamp_us = s_stamp_us;
+    s_stamp_valid = false;
+    taskEXIT_CRITICAL();
+    return valid;
+}
+
+/* EXTI6：按键沿（按下时刻捕获只取下降沿）
+ * 一次按下只记第一个下降沿：按下与松开的抖动沿（松开抖动可能远在按下之后）都不能覆盖它，
+ * 直到消抖后的松开（Input_GetEvent）才重新记录 */
+static void Input_OnKeyEdge(void)
+{
+    uint32_t now = TIM5_TIMESTAMP_US();
+
+    Key_OnEdgeFromISR();
+    if (!s_capture || s_stamp_latched || HAL_GPIO_ReadPin(GPIOB, GPIO_PIN_6) != GPIO_PIN_RESET)
+    {
+        return;
+    }
+    s_stamp_us = now;
+    s_stamp_valid = true;
+    s_stamp_latched = true;
+}
+
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+    if (GPIO_Pin == GPIO_PIN_6)
+    {
+        Input_OnKeyEdge();
+    }
+    else if (GPIO_Pin == GPIO_PIN_8 || GPIO_Pin == GPIO_PIN_9)
+    {
+        s_encoder_edge_ms = HAL_GetTick();
+    }
+    else
+    {
+        return;
+    }
+
+    LowPower_OnWakeEdge();  // 息屏期间记为唤醒（亮屏时直接返回）
+    if (InputTaskHandle != NULL)
+    {
+        osThreadFlagsSet(InputTaskHandle, INPUT_FLAG_EDGE);
+    }
+}
@@ -0,0 +1,92 @@
+/*
+ * input_accel.c
+ *
+ *  编码器转速估计与加速曲线，见 input_accel.h
+ */
+#include "input_accel.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/* 默认曲线：约每秒 10 格以下逐格，快速拨动时放大到 2/4/8 倍 */
+static const InputAccelPoint s_default_curve[] = {
+    { 0, 1},
+    {10, 2},
+    {20, 4},
+    {35, 8},
+};
+
+static const InputAccelPoint *s_curve = s_default_curve;
+static uint8_t s_curve_len = sizeof(s_default_curve) / sizeof(s_default_curve[0]);
+
+static bool s_started;
+static int8_t s_dir;            // 上一次的方向：1 顺时针，-1 逆时针
+static uint32_t s_last_ms;      // 上一次出格的时刻
+static uint16_t s_rate;         // 平滑后的转速（格/秒）
+
+static uint8_t InputAccel_Gain(uint16_t rate)
+{
+    uint8_t gain = 1;
+
+    for (uint8_t i = 0; i < s_curve_len; i++)
+    {
+        if (rate < s_curve[i].min_rate)
+        {
+            break;
+        }
+        gain = s_curve[i].gain;
+    }
+    return gain;
+}
+
+void InputAccel_SetCurve(const InputAccelPoint *points, uint8_t count)
+{
+    if (points == NULL || count == 0)
+    {
+        s_curve = s_default_curve;
+        s_curve_len = sizeof(s_default_curve) / sizeof(s_default_curve[0]);
+        return;
+    }
+    s_curve = points;
+    s_curve_len = count;
+}
+
+InputEvent InputAccel_Rotation(int16_t detents, uint32_t now_ms)
+{
+    InputEvent event = {.type = INPUT_NONE};
+    int8_t dir;
+    int16_t count;
+    uint32_t dt, steps;
+
+    if (detents == 0)
+    {
+        return event;
+    }
+
+    dir = (detents > 0) ? 1 : -1;
+    count = (detents > 0) ? detents : (int16_t)-detents;
+    dt = now_ms - s_last_ms;
+
+    if (!s_started || dir != s_dir || dt > INPUT_ACCEL_IDLE_MS)
+    {
+        s_rate = 0; // 起步/反向：第一格不加速
+    }
+    else
+    {
+        uint32_t inst = (uint32_t)count * 1000U / ((dt != 0U) ? dt : 1U);
+        if (inst > 1000U) inst = 1000U;
+        s_rate = (uint16_t)((s_rate == 0U) ? inst : (s_rate + inst) / 2U); // 平滑单次抖动
+    }
+    s_started = true;
+    s_dir = dir;
+    s_last_ms = now_ms;
+
+    steps = (uint32_t)count * InputAccel_Gain(s_rate);
+    if (steps > INPUT_ACCEL_MAX_STEPS) steps = INPUT_ACCEL_MAX_STEPS;
+
+    event.type = (dir > 0) ? INPUT_DOWN : INPUT_UP; // 顺时针 -> 向下/增加
+    event.value = count;
+    event.steps = (int16_t)steps;
+    event.rate = s_rate;
+    event.time = now_ms;
+    return event;
+}
@@ -0,0 +1,113 @@
+/*
+ * input_queue.c
+ *
+ *  输入事件投递（合并与背压），见 input_queue.h
+ */
+#include "input_queue.h"
+#include "input_replay.h"
+#include "cmsis_os.h"
+
+extern osMessageQueueId_t InputEventQueueHandle;
+
+static InputEvent s_tail;           // 暂存的旋转事件（尾槽）
+static bool s_tail_valid;
+static InputQueueStats s_stats;
+
+static bool InputQueue_IsRotation(const InputEvent *event)
+{
+    return event->type == INPUT_UP || event->type == INPUT_DOWN;
+}
+
+/* 入队；wait 为 true 时队列满则阻塞等待（背压） */
+static bool InputQueue_Put(const InputEvent *event, bool wait)
+{
+    uint32_t depth = osMessageQueueGetCount(InputEventQueueHandle);
+
+    if (depth > s_stats.max_depth)
+    {
+        s_stats.max_depth = depth;
+    }
+    if (osMessageQueuePut(InputEventQueueHandle, event, 0, 0) == osOK)
+    {
+        s_stats.posted++;
+        return true;
+    }
+
+    s_stats.overflows++;
+    if (!wait)
+    {
+        return false;
+    }
+    if (osMessageQueuePut(InputEventQueueHandle, event, 0, osWaitForever) == osOK)
+    {
+        s_stats.posted++;
+        return true;
+    }
+    s_stats.dropped++;
+    return false;
+}
+
+/* 把尾槽送进队列；wait 为 false 时只在 UI 任务已取空队列时送出 */
+static void InputQueue_PutTail(bool wait)
+{
+    if (!s_tail_valid)
+    {
+        return;
+    }
+    if (!wait && osMessageQueueGetCount(InputEventQueueHandle) != 0U)
+    {
+        return; // 还有未读事件：继续留在尾槽合并
+    }
+    InputQueue_Put(&s_tail, wait);
+    s_tail_valid = false;   // 阻塞投递失败已计入丢弃
+}
+
+void InputQueue_Post(const InputEvent *event)
+{
+    if (event->type == INPUT_NONE)
+    {
+        return;
+    }
+    InputReplay_Record(event);  // 录制中时记下合并前的事件流
+
+    if (!InputQueue_IsRotation(event))
+    {
+        InputQueue_PutTail(true);   // 先送出之前的旋转，保持顺序
+        InputQueue_Put(event, true);
+        return;
+    }
+
+    if (s_tail_valid && s_tail.type == event->type)
+    {
+        int32_t value = (int32_t)s_tail.value + event->value;
+        int32_t steps = (int32_t)s_tail.steps + event->steps;
+
+        s_tail.value = (int16_t)((value > INT16_MAX) ? INT16_MAX : value);
+        s_tail.steps = (int16_t)((steps > INT16_MAX) ? INT16_MAX : steps);
+        s_tail.rate = event->rate;  // 转速与时刻取最新的一次
+        s_tail.time = event->time;
+        s_stats.coalesced++;
+    }
+    else
+    {
+        InputQueue_PutTail(true);   // 换向：之前的旋转先入队
+        s_tail = *event;
+        s_tail_valid = true;
+    }
+    InputQueue_PutTail(false);
+}
+
+void InputQueue_Flush(void)
+{
+    InputQueue_PutTail(false);
+}
+
+uint32_t InputQueue_MsUntilRetry(void)
+{
+    return s_tail_valid ? INPUT_QUEUE_RETRY_MS : UINT32_MAX;
+}
+
+void InputQueue_GetStats(InputQueueStats *out)
+{
+    *out = s_stats;
+}
@@ -0,0 +1,265 @@
+/*
+ * input_replay.c
+ *
+ *  输入录制与回放，见 input_replay.h
+ */
+#include "input_replay.h"
+#include "input_queue.h"
+#include "main.h"
+#include <stdio.h>
+#include <string.h>
+
+#define R(at, type, v)  INPUT_REPLAY_STEP(at, type, v)
+#define D               INPUT_DOWN
+#define U               INPUT_UP
+
+/*
+ * 内置脚本（从主菜单、光标停在 Tools 开始）：
+ *   进入 Test Menu，来回滚动 40 格（下 14、上 14、下 12）后返回；
+ *   打开 Weather，翻 5 张卡片后退出；进入 Games -> Snake，每 1.5 s 转向一次玩 30 s，退出回到主菜单。
+ */
+const InputReplayStep g_InputReplaySession[] = {
+    R(300, D, 1), R(450, D, 1), R(600, D, 1), R(750, D, 1),                 // -> Test Menu
+    R(1100, INPUT_ENTER, 1),
+
+    R(1600, D, 1), R(1720, D, 1), R(1840, D, 1), R(1960, D, 1), R(2080, D, 1), R(2200, D, 1), R(2320, D, 1),
+    R(2440, D, 1), R(2560, D, 1), R(2680, D, 1), R(2800, D, 1), R(2920, D, 1), R(3040, D, 1), R(3160, D, 1),
+    R(3280, U, 1), R(3400, U, 1), R(3520, U, 1), R(3640, U, 1), R(3760, U, 1), R(3880, U, 1), R(4000, U, 1),
+    R(4120, U, 1), R(4240, U, 1), R(4360, U, 1), R(4480, U, 1), R(4600, U, 1), R(4720, U, 1), R(4840, U, 1),
+    R(4960, D, 1), R(5080, D, 1), R(5200, D, 1), R(5320, D, 1), R(5440, D, 1), R(5560, D, 1),
+    R(5680, D, 1), R(5800, D, 1), R(5920, D, 1), R(6040, D, 1), R(6160, D, 1), R(6280, D, 1),
+    R(6800, INPUT_BACK, 2),
+
+    R(7300, D, 1),                                                          // -> Weather
+    R(7700, INPUT_ENTER, 1),
+    R(8700, D, 1), R(9500, D, 1), R(10300, D, 1), R(11100, D, 1), R(11900, D, 1),
+    R(12900, INPUT_ENTER, 1),
+
+    R(13500, U, 1), R(13650, U, 1), R(13800, U, 1), R(13950, U, 1),         // -> Games
+    R(14400, INPUT_ENTER, 1),
+    R(14900, INPUT_ENTER, 1),                                               // -> Snake
+    R(16000, D, 1), R(17500, D, 1), R(19000, U, 1), R(20500, U, 1), R(22000, D, 1),
+    R(23500, D, 1), R(25000, U, 1), R(26500, U, 1), R(28000, D, 1), R(29500, D, 1),
+    R(31000, U, 1), R(32500, U, 1), R(34000, D, 1), R(35500, D, 1), R(37000, U, 1),
+    R(38500, U, 1), R(40000, D, 1), R(41500, D, 1), R(43000, U, 1), R(44500, U, 1),
+    R(44900, INPUT_ENTER, 1),                                               // 退出游戏（结束画面同样按确定退出）
+    R(45400, INPUT_BACK, 2),
+};
+const uint16_t g_InputReplaySessionLen = sizeof(g_InputReplaySession) / sizeof(g_InputReplaySession[0]);
+
+#undef R
+#undef D
+#undef U
+
+/* 录制 */
+static InputReplayStep s_records[INPUT_REPLAY_RECORDS];
+static uint16_t s_rec_head;         // 下一次写入的位置
+static uint16_t s_rec_count;
+static volatile bool s_recording;
+
+/* 回放：脚本为普通数组，录制为环形缓冲区（从 first 开始、按 wrap 回绕） */
+static const InputReplayStep *s_play_steps;
+static uint16_t s_play_count;
+static uint16_t s_play_first;
+static uint16_t s_play_wrap;
+static uint16_t s_play_next;
+static uint32_t s_play_base;        // 第一条的时刻（录制为绝对时刻，脚本为 0）
+static uint32_t s_play_start;       // 开始回放的 HAL 节拍
+static volatile bool s_playing;
+
+static InputReplayStats s_stats;
+
+static const InputReplayStep *InputReplay_RecordAt(uint16_t index)
+{
+    uint16_t oldest = (uint16_t)((s_rec_head + INPUT_REPLAY_RECORDS - s_rec_count) % INPUT_REPLAY_RECORDS);
+
+    return &s_records[(oldest + index) % INPUT_REPLAY_RECORDS];
+}
+
+void InputReplay_RecordStart(void)
+{
+    s_rec_head = 0;
+    s_rec_count = 0;
+    s_recording = true;
+}
+
+void InputReplay_RecordStop(void)
+{
+    if (!s_recording)
+    {
+        return;
+    }
+    s_recording = false;
+    if (s_rec_count > 0 && InputReplay_RecordAt((uint16_t)(s_rec_count - 1U))->type == INPUT_ENTER)
+    {
+        s_rec_head = (uint16_t)((s_rec_head + INPUT_REPLAY_RECORDS - 1U) % INPUT_REPLAY_RECORDS);
+        s_rec_count--;  // 选中“停止录制”的那次确定，回放时不应再触发
+    }
+    s_stats.recordings++;
+}
+
+bool InputReplay_Recording(void)
+{
+    return s_recording;
+}
+
+void InputReplay_Record(const InputEvent *event)
+{
+    InputReplayStep *rec;
+
+    if (!s_recording || s_playing)
+    {
+        return;
+    }
+
+    rec = &s_records[s_rec_head];
+    rec->at_ms = (event->time != 0U) ? event->time : HAL_GetTick();
+    rec->value = event->value;
+    rec->steps = event->steps;
+    rec->type = (uint8_t)event->type;
+    rec->mods = event->mods;
+
+    s_rec_head = (uint16_t)((s_rec_head + 1U) % INPUT_REPLAY_RECORDS);
+    if (s_rec_count < INPUT_REPLAY_RECORDS)
+    {
+        s_rec_count++;
+    }
+    s_stats.recorded++;
+}
+
+uint16_t InputReplay_RecordCount(void)
+{
+    return s_rec_count;
+}
+
+uint16_t InputReplay_FormatRecords(uint16_t first, char *buf, uint32_t size)
+{
+    uint32_t base, len = 0;
+    uint16_t n = 0;
+    char item[40];
+
+    if (size == 0)
+    {
+        return 0;
+    }
+    buf[0] = '\0';
+    if (first >= s_rec_count)
+    {
+        return 0;
+    }
+
+    base = InputReplay_RecordAt(0)->at_ms;
+    while (first + n < s_rec_count)
+    {
+        const InputReplayStep *rec = InputReplay_RecordAt((uint16_t)(first + n));
+        int w = snprintf(item, sizeof(item), "%s%lu/%u/%d/%d/%u", (n == 0U) ? "" : " ",
+                         (unsigned long)(rec->at_ms - base), (unsigned)rec->type,
+                         (int)rec->value, (int)rec->steps, (unsigned)rec->mods);
+
+        if (w <= 0 || len + (uint32_t)w >= size)
+        {
+            break;
+        }
+        memcpy(buf + len, item, (size_t)w + 1U);
+        len += (uint32_t)w;
+        n++;
+    }
+    return n;
+}
+
+static void InputReplay_Begin(const InputReplayStep *steps, uint16_t count, uint16_t first, uint16_t wrap,
+                              uint32_t base)
+{
+    InputReplay_Stop();
+    if (count == 0)
+    {
+        return;
+    }
+    s_play_steps = steps;
+    s_play_count = count;
+    s_play_first = first;
+    s_play_wrap = wrap;
+    s_play_next = 0;
+    s_play_base = base;
+    s_play_start = HAL_GetTick();
+    s_playing = true;   // 最后置位：InputTask 看到时其余字段已就绪
+}
+
+void InputReplay_Play(const InputReplayStep *steps, uint16_t count)
+{
+    InputReplay_Begin(steps, count, 0, count, 0);   // 脚本时刻从回放开始算起
+}
+
+bool InputReplay_PlayRecording(void)
+{
+    uint16_t oldest = (uint16_t)((s_rec_head + INPUT_REPLAY_RECORDS - s_rec_count) % INPUT_REPLAY_RECORDS);
+
+    if (s_recording || s_rec_count == 0)
+    {
+        return false;
+    }
+    InputReplay_Begin(s_records, s_rec_count, oldest, INPUT_REPLAY_RECORDS, s_records[oldest].at_ms);
+    return true;
+}
+
+void InputReplay_Stop(void)
+{
+    if (s_playing)
+    {
+        s_playing = false;
+        s_stats.aborted++;
+    }
+}
+
+bool InputReplay_Playing(void)
+{
+    return s_playing;
+}
+
+/* 距第 next 条事件的毫秒数，0 表示已到点 */
+static uint32_t InputReplay_Due(uint32_t now_ms)
+{
+    const InputReplayStep *st = &s_play_steps[(s_play_first + s_play_next) % s_play_wrap];
+    uint32_t due = st->at_ms - s_play_base;
+    uint32_t elapsed = now_ms - s_play_start;
+
+    return (elapsed >= due) ? 0U : (due - elapsed);
+}
+
+uint32_t InputReplay_Poll(uint32_t now_ms)
+{
+    while (s_playing)
+    {
+        const InputReplayStep *st;
+        uint32_t wait = InputReplay_Due(now_ms);
+
+        if (wait != 0U)
+        {
+            return wait;
+        }
+
+        st = &s_play_steps[(s_play_first + s_play_next) % s_play_wrap];
+        InputEvent event = {.type = (InputType)st->type, .value = st->value, .steps = st->steps,
+                             .time = now_ms, .mods = st->mods};
+        InputQueue_Post(&event);
+        s_stats.played++;
+
+        if (++s_play_next >= s_play_count)
+        {
+            s_playing = false;
+            s_stats.replays++;
+            s_stats.last_ms = now_ms - s_play_start;
+        }
+    }
+    return UINT32_MAX;
+}
+
+uint32_t InputReplay_MsUntilNext(uint32_t now_ms)
+{
+    return s_playing ? InputReplay_Due(now_ms) : UINT32_MAX;
+}
+
+void InputReplay_GetStats(InputReplayStats *out)
+{
+    *out = s_stats;
+}
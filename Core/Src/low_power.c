@@ -0,0 +1,168 @@
+/*
+ * low_power.c
+ *
+ *  息屏期间的 Tickless Idle + STOP 模式，见 low_power.h
+ */
+#include "low_power.h"
+#include "main.h"
+#include "rtc.h"
+#include "cmsis_os.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* RTC 时钟：LSI 约 32 kHz，ck_spre = 32000 / 128 / 250 = 1 Hz，亚秒分辨率 4 ms（分频值与 F411_RTOS.ioc / MX_RTC_Init 一致） */
+#define LOWPOWER_RTC_SYNC_PREDIV    249U
+#define LOWPOWER_WUT_HZ             (32000U / 16U)  // 唤醒定时器时钟 RTCCLK/16
+
+extern void SystemClock_Config(void);
+
+static volatile bool s_display_sleeping = false;
+static volatile uint32_t s_hold_count = 0;
+static volatile uint32_t s_last_wake_tick = 0;
+static volatile bool s_wake_pending = false;    // 已被 EXTI 唤醒、面板尚未点亮
+static uint32_t s_sleep_start_tick = 0;
+static LowPower_Stats s_stats;
+
+/* 等待影子寄存器与 RTC 同步（STOP 期间不更新）；清 RSF 需要先解除写保护 */
+static void LowPower_RtcSync(void)
+{
+    __HAL_RTC_WRITEPROTECTION_DISABLE(&hrtc);
+    HAL_RTC_WaitForSynchro(&hrtc);
+    __HAL_RTC_WRITEPROTECTION_ENABLE(&hrtc);
+}
+
+/* RTC 当日毫秒数（只用于计算 STOP 实际时长） */
+static uint32_t LowPower_RtcMillis(void)
+{
+    RTC_TimeTypeDef time;
+    RTC_DateTypeDef date;
+
+    HAL_RTC_GetTime(&hrtc, &time, RTC_FORMAT_BIN);
+    HAL_RTC_GetDate(&hrtc, &date, RTC_FORMAT_BIN);  // 读日期解锁影子寄存器
+
+    return ((uint32_t)time.Hours * 3600U + (uint32_t)time.Minutes * 60U + time.Seconds) * 1000U
+         + (LOWPOWER_RTC_SYNC_PREDIV - time.SubSeconds) * 1000U / (LOWPOWER_RTC_SYNC_PREDIV + 1U);
+}
+
+void LowPower_Init(void)
+{
+    /* RTC（LSI 时钟、唤醒中断）由 MX_RTC_Init 配置；唤醒用的 EXTI 线由 Input_Init 配置，亮屏期间也使能 */
+    HAL_PWREx_EnableFlashPowerDown();   // STOP 期间关闭 Flash
+}
+
+void LowPower_SetDisplaySleeping(bool sleeping)
+{
+    uint32_t now = HAL_GetTick();
+
+    if (sleeping == s_display_sleeping) return;
+
+    if (sleeping)
+    {
+        s_sleep_start_tick = now;
+        s_display_sleeping = true;
+    }
+    else
+    {
+        s_display_sleeping = false;
+        s_stats.sleep_ms += now - s_sleep_start_tick;
+
+        if (s_wake_pending)
+        {
+            s_wake_pending = false;
+            s_stats.wake_latency_ms = now - s_last_wake_tick;
+            if (s_stats.wake_latency_ms > s_stats.wake_latency_max_ms)
+            {
+                s_stats.wake_latency_max_ms = s_stats.wake_latency_ms;
+            }
+        }
+    }
+}
+
+void LowPower_Hold(void)
+{
+    taskENTER_CRITICAL();
+    s_hold_count++;
+    taskEXIT_CRITICAL();
+}
+
+void LowPower_Release(void)
+{
+    taskENTER_CRITICAL();
+    if (s_hold_count > 0) s_hold_count--;
+    taskEXIT_CRITICAL();
+}
+
+void LowPower_OnWakeEdge(void)
+{
+    if (!s_display_sleeping) return;
+
+    s_last_wake_tick = HAL_GetTick();
+    if (!s_wake_pending)
+    {
+        s_wake_pending = true;
+        s_stats.wakes++;
+    }
+}
+
+void LowPower_SuppressTicksAndSleep(uint32_t xExpectedIdleTime)
+{
+    uint32_t sleep_ms, slept_ms, rtc_start;
+
+    /* 亮屏或有网络事务：只停 CPU 时钟，节拍中断照常唤醒 */
+    if (!s_display_sleeping || s_hold_count != 0)
+    {
+        __DSB();
+        __WFI();
+        __ISB();
+        return;
+    }
+
+    sleep_ms = xExpectedIdleTime * portTICK_PERIOD_MS;
+    if (sleep_ms > LOWPOWER_STOP_MAX_MS) sleep_ms = LOWPOWER_STOP_MAX_MS;
+
+    __disable_irq();
+    __DSB();
+    __ISB();
+
+    /* 关中断后再确认一次：期间可能有中断让任务就绪 */
+    if (eTaskConfirmSleepModeStatus() == eAbortSleep)
+    {
+        __enable_irq();
+        return;
+    }
+
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;  // FreeRTOS 节拍
+    HAL_SuspendTick();                          // HAL 时基 (TIM2)
+
+    rtc_start = LowPower_RtcMillis();
+    HAL_RTCEx_SetWakeUpTimer_IT(&hrtc, sleep_ms * LOWPOWER_WUT_HZ / 1000U - 1U, RTC_WAKEUPCLOCK_RTCCLK_DIV16);
+
+    HAL_PWR_EnterSTOPMode(PWR_LOWPOWERREGULATOR_ON, PWR_STOPENTRY_WFI);
+
+    /* 退出 STOP 后系统时钟为 HSI 16 MHz：重新锁定 PLL（同时重新初始化 TIM2 时基） */
+    SystemClock_Config();
+    HAL_RTCEx_DeactivateWakeUpTimer(&hrtc);
+
+    LowPower_RtcSync();
+    slept_ms = LowPower_RtcMillis() - rtc_start;
+    if ((int32_t)slept_ms < 0) slept_ms += 24U * 3600U * 1000U;     // 跨零点
+    if (slept_ms > sleep_ms) slept_ms = sleep_ms;                   // 补偿不能超过预期空闲时间
+
+    uwTick += slept_ms;
+    vTaskStepTick(slept_ms / portTICK_PERIOD_MS);
+
+    s_stats.stop_entries++;
+    s_stats.stop_ms += slept_ms;
+
+    HAL_ResumeTick();
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+    /* 开中断后挂起的 EXTI/RTC 中断才执行，此时时钟与节拍已恢复 */
+    __enable_irq();
+}
+
+LowPower_Stats LowPower_GetStats(void)
+{
+    return s_stats;
+}
@@ -0,0 +1,79 @@
+/*
+ * menu_driver.c
+ *
+ *  菜单显示后端的 OLED (SSD1306) 实现，见 MENU.h 的 MENU_DriverOps。
+ *  换屏幕时提供另一份 MENU_Driver 定义即可，MENU.c 无需改动。
+ */
+#include "MENU.h"
+#include "OLED.h"
+#include "OLED_Data.h"
+#include "ui_overlay.h"
+#include <string.h>
+
+static void MENU_OLED_Clear(void)
+{
+    OLED_Clear();
+}
+
+static void MENU_OLED_Display(void)
+{
+    Overlay_Present(); // 整屏推送，FPS/倒计时等小部件在传输时由覆盖层叠加
+}
+
+static uint8_t MENU_OLED_DrawText(int16_t x, int16_t y, const char *str, uint8_t font)
+{
+    if (font == 0)
+    {
+        font = OLED_8X16;
+    }
+    OLED_ShowString(x, y, (char *)str, font);
+    return (uint8_t)strlen(str);
+}
+
+static void MENU_OLED_InvertRect(int16_t x, int16_t y, int16_t width, int16_t height)
+{
+    OLED_ReverseArea(x, y, (uint8_t)width, (uint8_t)height);
+}
+
+static void MENU_OLED_Frame(int16_t x, int16_t y, int16_t width, int16_t height)
+{
+    OLED_DrawRectangle(x, y, (uint8_t)width, (uint8_t)height, OLED_UNFILLED);
+}
+
+static uint8_t MENU_OLED_MeasureText(const char *str)
+{
+    return (uint8_t)strlen(str); // 等宽字体：宽度 = 字符数 * MENU_FONT_W
+}
+
+static uint16_t MENU_OLED_RenderStrip(const char *str, uint8_t *strip, uint16_t strip_w)
+{
+    uint16_t x = 0;
+
+    /* 8x16 字模按页存放（上页 8 字节 + 下页 8 字节），逐字拷贝到条带的两页 */
+    for (; *str != '\0' && x + MENU_FONT_W <= strip_w; str++)
+    {
+        char c = (*str >= ' ' && *str <= '~') ? *str : ' '; // 字模库只含可见 ASCII
+        const uint8_t *glyph = OLED_F8x16[c - ' '];
+
+        memcpy(&strip[x], &glyph[0], MENU_FONT_W);
+        memcpy(&strip[strip_w + x], &glyph[MENU_FONT_W], MENU_FONT_W);
+        x += MENU_FONT_W;
+    }
+    return x;
+}
+
+static void MENU_OLED_BlitStrip(int16_t x, int16_t y, uint8_t width, const uint8_t *strip, uint16_t strip_w, uint16_t src_x)
+{
+    OLED_ShowImagePart(x, y, width, MENU_FONT_H, strip, strip_w, src_x);
+}
+
+const MENU_DriverOps MENU_Driver = {
+    .clear = MENU_OLED_Clear,
+    .display = MENU_OLED_Display,
+    .draw_text = MENU_OLED_DrawText,
+    .invert_rect = MENU_OLED_InvertRect,
+    .frame = MENU_OLED_Frame,
+    .measure_text = MENU_OLED_MeasureText,
+    .render_strip = MENU_OLED_RenderStrip,
+    .blit_strip = MENU_OLED_BlitStrip,
+};
@@ -0,0 +1,297 @@
+/*
+ * stopwatch.c
+ *
+ *  毫秒秒表，见 stopwatch.h
+ */
+#include "stopwatch.h"
+#include "ui_screen.h"
+#include "input.h"
+#include "MENU.h"
+#include "OLED.h"
+#include "main.h"
+#include <stdio.h>
+#include <string.h>
+
+/* 布局 */
+#define STOPWATCH_TIME_LEN  9                                       // "MM:SS.mmm"
+#define STOPWATCH_TIME_X    ((128 - STOPWATCH_TIME_LEN * MENU_FONT_W) / 2)
+#define STOPWATCH_TIME_Y    16
+#define STOPWATCH_LAP_X     5
+#define STOPWATCH_LAP_Y     32      // 两行计次（32、48）
+#define STOPWATCH_LAP_ROWS  2
+
+/* 按下沿时刻的有效期：短按在松开时才产生事件，长于长按阈值的记录不属于这次短按 */
+#define STOPWATCH_STAMP_MAX_US  1000000U
+
+typedef struct
+{
+    bool running;
+    uint32_t start_us;          // 本段计时起点（微秒计数）
+    uint32_t start_tick;        // 同一时刻的 HAL 节拍，用于推算微秒计数的回绕圈数
+    uint64_t banked_us;         // 之前各段（暂停前）的累计时长
+
+    uint64_t laps[STOPWATCH_LAPS];  // 各次计次的分段时长，环形
+    uint8_t lap_head;               // 下一次写入的位置
+    uint32_t lap_count;             // 累计计次数（编号）
+    uint64_t last_lap_us;           // 上一次计次时的总时长
+    uint8_t scroll;                 // 暂停时翻看：0 = 最新的两次
+
+    char shown[STOPWATCH_TIME_LEN + 1];     // 屏幕上的时间文本
+    bool laps_dirty;
+    StopwatchStats stats;
+} StopwatchState;
+
+static StopwatchState s_sw;
+
+/* 从本段起点到 (us, tick) 的微秒数：32 位计数回绕的圈数取与节拍差最接近的值 */
+static uint64_t Stopwatch_Since(uint32_t us, uint32_t tick)
+{
+    uint32_t fine = us - s_sw.start_us;
+    int64_t coarse = (int64_t)(tick - s_sw.start_tick) * 1000;
+    int64_t wraps = (coarse - (int64_t)fine + 0x80000000LL) >> 32;
+
+    return (uint64_t)fine + ((wraps > 0) ? ((uint64_t)wraps << 32) : 0U);
+}
+
+static uint64_t Stopwatch_ElapsedAt(uint32_t us)
+{
+    return s_sw.banked_us + (s_sw.running ? Stopwatch_Since(us, HAL_GetTick()) : 0U);
+}
+
+/* 开始/计次的时刻：优先用按下沿，并记录界面处理延迟 */
+static uint32_t Stopwatch_PressTime(void)
+{
+    uint32_t now = Input_TimestampUs();
+    uint32_t stamp;
+
+    if (Input_TakePressStamp(&stamp) && (now - stamp) < STOPWATCH_STAMP_MAX_US)
+    {
+        s_sw.stats.stamped++;
+        s_sw.stats.lag_last_us = now - stamp;
+        if (s_sw.stats.lag_last_us > s_sw.stats.lag_max_us)
+        {
+            s_sw.stats.lag_max_us = s_sw.stats.lag_last_us;
+        }
+        return stamp;
+    }
+    s_sw.stats.fallback++;
+    return now;
+}
+
+static void Stopwatch_Start(uint32_t at_us)
+{
+    s_sw.start_us = at_us;
+    s_sw.start_tick = HAL_GetTick();
+    s_sw.running = true;
+}
+
+static void Stopwatch_Pause(uint32_t at_us)
+{
+    s_sw.banked_us = Stopwatch_ElapsedAt(at_us);
+    s_sw.running = false;
+    s_sw.scroll = 0;
+}
+
+static void Stopwatch_Lap(uint32_t at_us)
+{
+    uint64_t total = Stopwatch_ElapsedAt(at_us);
+
+    s_sw.laps[s_sw.lap_head] = total - s_sw.last_lap_us;
+    s_sw.lap_head = (uint8_t)((s_sw.lap_head + 1U) % STOPWATCH_LAPS);
+    s_sw.lap_count++;
+    s_sw.last_lap_us = total;
+    s_sw.stats.laps++;
+    s_sw.laps_dirty = true;
+}
+
+static void Stopwatch_Clear(void)
+{
+    s_sw.running = false;
+    s_sw.banked_us = 0;
+    s_sw.lap_head = 0;
+    s_sw.lap_count = 0;
+    s_sw.last_lap_us = 0;
+    s_sw.scroll = 0;
+    s_sw.laps_dirty = true;
+}
+
+static uint8_t Stopwatch_LapsKept(void)
+{
+    return (s_sw.lap_count < STOPWATCH_LAPS) ? (uint8_t)s_sw.lap_count : STOPWATCH_LAPS;
+}
+
+/* 分钟超过两位时只显示低两位 */
+static void Stopwatch_FormatTime(uint64_t us, char *buf)
+{
+    uint32_t ms = (uint32_t)(us / 1000U);
+
+    snprintf(buf, STOPWATCH_TIME_LEN + 1, "%02lu:%02lu.%03lu",
+             (unsigned long)((ms / 60000U) % 100U),
+             (unsigned long)((ms / 1000U) % 60U),
+             (unsigned long)(ms % 1000U));
+}
+
+/* 计次区域：最新的（或翻看到的）两次，新的在上 */
+static void Stopwatch_DrawLaps(void)
+{
+    char time[STOPWATCH_TIME_LEN + 1];
+    char line[10 + 1 + STOPWATCH_TIME_LEN + 1];  // 编号最多 10 位（uint32_t）+ 空格 + 时间
+
+    OLED_ClearArea(0, STOPWATCH_LAP_Y, 128, 64 - STOPWATCH_LAP_Y);
+    for (uint8_t row = 0; row < STOPWATCH_LAP_ROWS; row++)
+    {
+        uint8_t back = s_sw.scroll + row;
+
+        if (back >= Stopwatch_LapsKept())
+        {
+            break;
+        }
+        Stopwatch_FormatTime(s_sw.laps[(s_sw.lap_head + STOPWATCH_LAPS - 1U - back) % STOPWATCH_LAPS], time);
+        snprintf(line, sizeof(line), "%3lu %s", (unsigned long)(s_sw.lap_count - back), time);
+        OLED_ShowString(STOPWATCH_LAP_X, STOPWATCH_LAP_Y + row * 16, line, OLED_8X16);
+    }
+    s_sw.laps_dirty = false;
+}
+
+static void Stopwatch_Enter(void *ctx)
+{
+    (void)ctx;
+    Input_SetPressCapture(true);
+}
+
+static void Stopwatch_Exit(void *ctx)
+{
+    (void)ctx;
+    Input_SetPressCapture(false);
+}
+
+static uint32_t Stopwatch_Frame(void *ctx, bool full)
+{
+    char buf[STOPWATCH_TIME_LEN + 1];
+    uint8_t first = 0, last = STOPWATCH_TIME_LEN;
+    (void)ctx;
+
+    Stopwatch_FormatTime(Stopwatch_ElapsedAt(Input_TimestampUs()), buf);
+
+    if (full)
+    {
+        OLED_Clear();
+        OLED_ShowString((128 - 9 * MENU_FONT_W) / 2, 0, "Stopwatch", OLED_8X16);
+        OLED_ShowString(STOPWATCH_TIME_X, STOPWATCH_TIME_Y, buf, OLED_8X16);
+        Stopwatch_DrawLaps();
+        strcpy(s_sw.shown, buf);
+        MENU_Display();
+        return s_sw.running ? 0U : UI_SCREEN_IDLE;
+    }
+
+    // 只重画变化的那几位数字（运行中通常只有毫秒的后两三位）
+    while (first < STOPWATCH_TIME_LEN && buf[first] == s_sw.shown[first])
+    {
+        first++;
+    }
+    if (first < STOPWATCH_TIME_LEN)
+    {
+        while (buf[last - 1U] == s_sw.shown[last - 1U])
+        {
+            last--;
+        }
+        strcpy(s_sw.shown, buf);
+        buf[last] = '\0';
+
+        OLED_ClearArea(STOPWATCH_TIME_X + first * MENU_FONT_W, STOPWATCH_TIME_Y, (last - first) * MENU_FONT_W, 16);
+        OLED_ShowString(STOPWATCH_TIME_X + first * MENU_FONT_W, STOPWATCH_TIME_Y, &buf[first], OLED_8X16);
+        OLED_UpdateArea(STOPWATCH_TIME_X + first * MENU_FONT_W, STOPWATCH_TIME_Y, (last - first) * MENU_FONT_W, 16);
+    }
+    if (s_sw.laps_dirty)
+    {
+        Stopwatch_DrawLaps();
+        OLED_UpdateArea(0, STOPWATCH_LAP_Y, 128, 64 - STOPWATCH_LAP_Y);
+    }
+    MENU_RefreshOverlay();
+    return s_sw.running ? 0U : UI_SCREEN_IDLE;
+}
+
+static void Stopwatch_Input(void *ctx, const InputEvent *event)
+{
+    uint32_t stamp;
+    (void)ctx;
+
+    switch (event->type)
+    {
+    case INPUT_ENTER:
+        if (s_sw.running)
+        {
+            Stopwatch_Lap(Stopwatch_PressTime());
+        }
+        else
+        {
+            Stopwatch_Start(Stopwatch_PressTime()); // 从零开始或暂停后继续
+            s_sw.scroll = 0;
+            s_sw.laps_dirty = true;
+        }
+        break;
+
+    case INPUT_UP:
+    case INPUT_DOWN:
+        if (s_sw.running)
+        {
+            Stopwatch_Pause(Input_TimestampUs());
+            s_sw.laps_dirty = true;
+        }
+        else if (event->type == INPUT_DOWN && s_sw.scroll + STOPWATCH_LAP_ROWS < Stopwatch_LapsKept())
+        {
+            s_sw.scroll++;      // 更早的计次
+            s_sw.laps_dirty = true;
+        }
+        else if (event->type == INPUT_UP && s_sw.scroll > 0)
+        {
+            s_sw.scroll--;
+            s_sw.laps_dirty = true;
+        }
+        break;
+
+    case INPUT_BACK:
+        (void)Input_TakePressStamp(&stamp);     // 长按的按下沿不用于计时
+        if (!s_sw.running && (s_sw.banked_us != 0U || s_sw.lap_count != 0U))
+        {
+            Stopwatch_Clear();
+        }
+        else
+        {
+            Screen_Pop();
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+static const UI_App Stopwatch_App = {
+    .name = "stopwatch",
+    .onEnter = Stopwatch_Enter,
+    .onFrame = Stopwatch_Frame,
+    .onInput = Stopwatch_Input,
+    .onExit = Stopwatch_Exit,
+    .transition = UI_TRANSITION_SLIDE,
+};
+
+void Stopwatch_Open(void)
+{
+    Screen_Push(&Stopwatch_App, NULL);
+}
+
+bool Stopwatch_Running(void)
+{
+    return s_sw.running;
+}
+
+uint64_t Stopwatch_ElapsedUs(void)
+{
+    return Stopwatch_ElapsedAt(Input_TimestampUs());
+}
+
+void Stopwatch_GetStats(StopwatchStats *out)
+{
+    *out = s_sw.stats;
+}
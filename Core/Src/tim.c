@@ -127,4 +127,26 @@ void HAL_TIM_Encoder_MspDeInit(TIM_HandleTypeDef* tim_encoderHandle)
 
 /* USER CODE BEGIN 1 */
 
+/**
+ * @brief TIM5：32 位自由运行微秒计数器（秒表、按键按下时刻），约 71.6 分钟回绕
+ * @note  APB1 分频不为 1 时定时器时钟为 PCLK1 的两倍（当前 96 MHz），分频到 1 MHz
+ */
+void TIM5_TimestampInit(void)
+{
+  uint32_t tim_clk = HAL_RCC_GetPCLK1Freq();
+
+  if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1)
+  {
+    tim_clk *= 2U;
+  }
+
+  __HAL_RCC_TIM5_CLK_ENABLE();
+  TIM5->CR1 = 0;
+  TIM5->PSC = (tim_clk / 1000000U) - 1U;
+  TIM5->ARR = 0xFFFFFFFFU;
+  TIM5->EGR = TIM_EGR_UG;   // 立即装载分频值
+  TIM5->CNT = 0;
+  TIM5->CR1 = TIM_CR1_CEN;
+}
+
 /* USER CODE END 1 */
@@ -12,26 +12,26 @@
 #include <string.h>
 #include <stdlib.h>
 #include "MENU.h"
+#include "menu_tree.h"
 #include "OLED.h"
-
-extern osMessageQueueId_t InputEventQueueHandle;
+#include "ui_overlay.h"
+#include "ui_popup.h"
+#include "ui_screen.h"
 
 /* ========= 倒计时功能相关变量（从 MENU.c 迁移到此） ========= */
-uint8_t timer_enabled = 0;               // 定时器启用标志 (0=关闭, 1=启用)
 uint16_t timer_seconds = 60;             // 定时器时间(秒)
-uint16_t timer_current = 0;              // 当前定时器剩余时间
-uint32_t timer_start_time = 0;           // 定时器开始时间
+static TimerSvcId timer_id = TIMER_SVC_NONE;    // 运行中的倒计时槽位
+static TimerSvcView timer_view;          // 覆盖层上显示的剩余秒数
 
 /**
- * @brief 启动定时器
+ * @brief 启动定时器（正在运行的倒计时重新开始）
  * @param seconds 定时器秒数
  */
 void MENU_StartTimer(uint16_t seconds)
 {
-    timer_enabled = 1;
+    MENU_StopTimer();
     timer_seconds = seconds;
-    timer_current = seconds;
-    timer_start_time = HAL_GetTick();
+    timer_id = TimerSvc_Start("Timer", (uint32_t)seconds * 1000U, false);
 }
 
 /**
@@ -39,99 +39,72 @@ void MENU_StartTimer(uint16_t seconds)
  */
 void MENU_StopTimer(void)
 {
-    timer_enabled = 0;
-    timer_current = 0;
+    TimerSvc_Stop(timer_id);
+    timer_id = TIMER_SVC_NONE;
+}
+
+bool MENU_TimerRunning(void)
+{
+    return TimerSvc_State(timer_id) == TIMER_SVC_RUNNING;
+}
+
+uint16_t MENU_TimerRemaining(void)
+{
+    return (uint16_t)TimerSvc_RemainingSeconds(timer_id);
+}
+
+TimerSvcId MENU_TimerId(void)
+{
+    return MENU_TimerRunning() ? timer_id : TIMER_SVC_NONE;
 }
 
 /**
- * @brief 更新定时器状态
- * @return 1表示定时器结束，0表示继续
+ * @brief 取走所有到点事件：倒计时弹出"时间到"，其他计时以名称提示
+ * @note  到点由软件定时器回调标记，这里只消费事件，不再按时间轮询判断
  */
-uint8_t MENU_UpdateTimer(void)
+void MENU_ServiceTimers(void)
 {
-    if (!timer_enabled) return 0;
-
-    uint32_t current_time = HAL_GetTick();
-    uint32_t elapsed_seconds = (current_time - timer_start_time) / 1000;
+    TimerSvcId id;
 
-    if (elapsed_seconds >= timer_seconds) {
-        // 定时器结束
-        timer_enabled = 0;
-        timer_current = 0;
-        return 1;
+    while ((id = TimerSvc_TakeExpired()) != TIMER_SVC_NONE)
+    {
+        if (id == timer_id) {
+            timer_id = TIMER_SVC_NONE;
+            MENU_ShowTimeUpAlert();
+        } else {
+            Popup_Show(TimerSvc_Label(id), POPUP_MODAL, 0);
+        }
     }
-
-    timer_current = timer_seconds - elapsed_seconds;
-    return 0;
 }
 
 /**
- * @brief 显示倒计时
- * @param x X坐标
- * @param y Y坐标
+ * @brief 把倒计时写入覆盖层（右上角小部件），定时器未启用时隐藏
+ * @note  只在显示的秒数或状态变化时重新格式化，静态页面等待输入时也能逐秒刷新
  */
-void MENU_ShowTimer(int16_t x, int16_t y)
+void MENU_ShowTimer(void)
 {
-    if (!timer_enabled) return;
-
     char timer_str[16];
-    uint16_t minutes = timer_current / 60;
-    uint16_t seconds = timer_current % 60;
 
-    if (minutes > 0) {
-        sprintf(timer_str, "%02d:%02d", minutes, seconds);
-    } else {
-        sprintf(timer_str, "00:%02d", seconds);
+    if (!TimerSvc_Watch(timer_id, &timer_view)) {
+        return;
+    }
+    if (timer_view.state != TIMER_SVC_RUNNING) {
+        Overlay_SetText(OVERLAY_TIMER, NULL);
+        return;
     }
 
-    menu_command_callback(SHOW_STRING, x, y, timer_str, OLED_6X8); // 使用小字体显示定时器
+    sprintf(timer_str, "%02lu:%02lu", (unsigned long)(timer_view.remaining_s / 60),
+            (unsigned long)(timer_view.remaining_s % 60));
+    Overlay_SetText(OVERLAY_TIMER, timer_str);
 }
 
 /**
- * @brief 显示"时间到"提示
+ * @brief 弹出"时间到"提示（非阻塞）
+ * @note  模态弹窗经弹窗层叠加显示，任意输入确认；底层页面继续绘制与动画
  */
 void MENU_ShowTimeUpAlert(void)
 {
-    // 清除屏幕
-    menu_command_callback(BUFFER_CLEAR);
-
-    // 显示"时间到"提示
-    menu_command_callback(SHOW_STRING, 32, 20, "TIME UP!", OLED_8X16);
-
-    // 绘制简洁边框
-    OLED_DrawRectangle(5, 15, 118, 35, OLED_UNFILLED);
-
-    menu_command_callback(BUFFER_DISPLAY);
-
-    // 闪烁提示效果（减少闪烁次数）
-    for (int i = 0; i < 2; i++) {
-        osDelay(300);  // 使用 osDelay 让出 CPU
-
-        // 反转显示区域创建闪烁效果
-        OLED_ReverseArea(6, 16, 116, 33);
-        OLED_Update();
-
-        osDelay(300);  // 使用 osDelay 让出 CPU
-
-        // 恢复正常显示
-        OLED_ReverseArea(6, 16, 116, 33);
-        OLED_Update();
-    }
-
-    // 等待按键确认
-    while (1)
-    {
-        InputEvent event = MENU_ReceiveInputEvent();
-        if (event.type == INPUT_ENTER ||
-            event.type == INPUT_BACK ||
-            event.type == INPUT_UP ||
-            event.type == INPUT_DOWN)
-        {
-            MENU_UpdateActivity(); // 更新活动时间
-            break;
-        }
-        osDelay(50);  // 使用 osDelay 让出 CPU
-    }
+    Popup_Show("TIME UP!", POPUP_MODAL, 0);
 }
 
 /* 月份字符串转数字 */
@@ -239,354 +212,179 @@ bool SNTP_GetTimeString(char* buf, size_t buf_size) {
     return true;
 }
 
-/**
- * @brief 定时器设置菜单 - 标准菜单格式
- */
-void MENU_TimerSetting(void)
-{
-
-    static MENU_OptionTypeDef MENU_OptionList[] = {
-        {"<<<", NULL},                    // 返回
-        {"Time: 60s", NULL},              // 时间调节
-        {"Start Timer", NULL},            // 启动定时器
-        {"Stop Timer", NULL},             // 停止定时器
-        {"..", NULL}                      // 结束标记
-    };
+/* 定时器设置页：时间与按钮文本运行时改写（MENU_State_Timer[i].Text），使用带状态侧表的页面 */
+#define MENU_TIMER_ITEMS(ITEM, SUBMENU, VAR)                                                 \
+    ITEM("<<<", NULL)                       /* 返回 */                                       \
+    ITEM("Time: 60s", NULL)                 /* 时间调节 */                                   \
+    ITEM("Start Timer", NULL)               /* 启动定时器 */                                 \
+    ITEM("Stop Timer", NULL)                /* 停止定时器 */
 
-    static MENU_HandleTypeDef MENU = {
-        .OptionList = MENU_OptionList,
-        .Option_Max_i = 3,                // 手动设置最大索引值（不包括".."）
-        .isRun = 1                        // 默认运行状态为开启
-    };
+MENU_PAGE_DEFINE_DYNAMIC(Timer, &MENU_Page_Tools, MENU_TIMER_ITEMS);
 
-    // 动态字符串缓冲区
-    static char time_str[32];
-    static char start_str[32];
-    static char stop_str[32] = "Stop Timer";
+/* 定时器设置页的时间文本：调节模式下加箭头 */
+static void MENU_TimerFormatTime(char *buf, uint8_t adjusting)
+{
+    const char *arrow = adjusting ? " >" : "";
+    uint16_t minutes = timer_seconds / 60;
+    uint16_t seconds = timer_seconds % 60;
+
+    if (timer_seconds < 60) {
+        sprintf(buf, "Time: %ds%s", timer_seconds, arrow);
+    } else if (seconds == 0) {
+        sprintf(buf, "Time: %dm%s", minutes, arrow);
+    } else {
+        sprintf(buf, "Time: %dm%ds%s", minutes, seconds, arrow);
+    }
+}
 
-    // 时间调节模式标志
-    static uint8_t time_adjust_mode = 0;  // 0=正常模式, 1=时间调节模式
+/* 定时器设置页：在菜单页应用之上改写时间/按钮文本并拦截确定键，
+   由 Screen_Run 驱动（到点弹窗、息屏、事件驱动等待与其他页面一致），静止时不再逐帧重画 */
+static MENU_HandleTypeDef timer_menu = {
+    .Page = &MENU_Page_Timer,
+};
+static char timer_time_str[32];
+static char timer_start_str[32];
+static uint8_t timer_adjust_mode = 0;   // 0=正常模式, 1=时间调节模式（离开页面即复位）
+static uint8_t timer_dirty = 1;         // 文本需要重新格式化
+static TimerSvcView timer_page_view;    // 按钮上倒计时的显示状态（与覆盖层的 timer_view 各自比较）
+
+static void MENU_TimerPageEnter(void *ctx)
+{
+    static uint8_t first_run = 1;
+    MENU_HandleTypeDef *hMENU = (MENU_HandleTypeDef *)ctx;
 
-    // 手动更新菜单选项内容
-    while (1)
-    {
-        // 静态变量跟踪上次的状态和时间值，避免不必要的更新
-        static uint8_t last_time_adjust_mode = 0xFF; // 初始无效值
-        static uint16_t last_seconds_shown = 0xFFFF; // 初始无效值
-        static uint8_t last_selection = 0xFF;        // 初始无效值
-
-        // 只有在时间值、调整模式或选中项变化时才更新字符串
-    if (last_seconds_shown != timer_seconds ||
-            last_time_adjust_mode != time_adjust_mode ||
-            last_selection != MENU.Catch_i) {
-
-            last_seconds_shown = timer_seconds;
-            last_time_adjust_mode = time_adjust_mode;
-            last_selection = MENU.Catch_i;
-
-            // 更新时间显示，如果在时间调节模式则添加箭头标识
-            if (time_adjust_mode && MENU.Catch_i == 1) {
-                // 在时间调节模式下显示箭头
-                if (timer_seconds < 60) {
-                    sprintf(time_str, "Time: %ds >", timer_seconds);
-                } else {
-                    uint16_t minutes = timer_seconds / 60;
-                    uint16_t seconds = timer_seconds % 60;
-                    if (seconds == 0) {
-                        sprintf(time_str, "Time: %dm >", minutes);
-                    } else {
-                        sprintf(time_str, "Time: %dm%ds >", minutes, seconds);
-                    }
-                }
-            } else {
-                // 正常模式下不显示箭头
-                if (timer_seconds < 60) {
-                    sprintf(time_str, "Time: %ds", timer_seconds);
-                } else {
-                    uint16_t minutes = timer_seconds / 60;
-                    uint16_t seconds = timer_seconds % 60;
-                    if (seconds == 0) {
-                        sprintf(time_str, "Time: %dm", minutes);
-                    } else {
-                        sprintf(time_str, "Time: %dm%ds", minutes, seconds);
-                    }
-                }
-            }
-        }
+    MENU_State_Timer[1].Text = timer_time_str;
+    MENU_State_Timer[2].Text = timer_start_str;
+    MENU_State_Timer[3].Text = "Stop Timer";
 
-        // 启动按钮显示（只有状态变化或定时器变化时才更新）
-        static uint8_t last_timer_enabled = 0xFF; // 初始无效值
-        static uint16_t last_timer_value = 0xFFFF; // 初始无效值
+    // 仅在第一次进入时初始化菜单，之后保留选中项
+    if (first_run) {
+        MENU_HandleInit(hMENU);
+        first_run = 0;
+    }
+    hMENU->AnimationUpdateEvent = 1;     // 光标重新定位（动画槽位离开时已释放）
+    hMENU->FlingVelocity = 0;
 
-        // 仅当状态变化或定时器变化时才更新
-    if (last_timer_enabled != timer_enabled ||
-            (timer_enabled && last_timer_value != timer_current)) {
+    timer_adjust_mode = 0;
+    timer_dirty = 1;
+    timer_page_view.state = 0xFF;             // 初始无效值保证首帧格式化
+}
 
-            last_timer_enabled = timer_enabled;
-            last_timer_value = timer_current;
+static uint32_t MENU_TimerPageFrame(void *ctx, bool full)
+{
+    MENU_HandleTypeDef *hMENU = (MENU_HandleTypeDef *)ctx;
 
-            if (timer_enabled) {
-                sprintf(start_str, "Running (%ds)", timer_current);
-            } else {
-                sprintf(start_str, "Start Timer");
-            }
-        }
+    // 运行按钮显示剩余秒数：只有显示的秒数或运行状态变化时才更新（跳秒由 MENU_NextDeadline 唤醒）
+    if (TimerSvc_Watch(MENU_TimerId(), &timer_page_view)) {
+        timer_dirty = 1;
+    }
 
-        // 更新选项字符串指针 - 这些指针赋值操作性能开销很小，可以保留
-        MENU_OptionList[1].String = time_str;
-        MENU_OptionList[2].String = start_str;
-        MENU_OptionList[3].String = stop_str;
-
-    // 仅在字符串内容实际发生变化时才更新光标（减少动画触发次数）
-        // 使用静态数组保存上次的字符串长度
-        static uint8_t last_str_lengths[4] = {0};
-        static uint8_t need_update = 0;
-
-        // 只计算当前选中项的长度，避免不必要的计算
-        uint8_t current_item = MENU.Catch_i;
-        if (current_item <= 3) {
-            uint8_t current_length = 0;
-
-            // 根据选中项计算长度
-            switch (current_item) {
-                case 1:
-                    current_length = strlen(time_str);
-                    break;
-                case 2:
-                    current_length = strlen(start_str);
-                    break;
-                case 3:
-                    current_length = strlen(stop_str);
-                    break;
-                default:
-                    current_length = strlen(MENU_OptionList[0].String);
-                    break;
-            }
+    if (timer_dirty) {
+        uint8_t selected_len = MENU_State_Timer[hMENU->Catch_i].StrLen;
 
-            // 只有长度变化时才触发更新
-            if (last_str_lengths[current_item] != current_length) {
-                last_str_lengths[current_item] = current_length;
-                MENU.OptionList[current_item].StrLen = current_length;
-                MENU.AnimationUpdateEvent = 1;
-                need_update = 1;
-            }
+        MENU_TimerFormatTime(timer_time_str, timer_adjust_mode);
+        if (timer_page_view.state == TIMER_SVC_RUNNING) {
+            sprintf(timer_start_str, "Running (%lus)", (unsigned long)timer_page_view.remaining_s);
+        } else {
+            sprintf(timer_start_str, "Start Timer");
         }
 
-        // 仅在第一次循环时初始化菜单
-        static uint8_t first_run = 1;
-    if (first_run) {
-            // 手动初始化关键字段，避免使用MENU_HandleInit以保留状态
-            MENU.AnimationUpdateEvent = 1; // 动画更新事件
-            MENU.isRun = 1;                // 运行标志
-            MENU.Option_Max_i = 3;         // 选项列表长度（不包括".."）
-            MENU.Catch_i = 1;              // 选中下标默认为1,(因为MENU.OptionList[0]为"<<<")
-            MENU.Cursor_i = 1;             // 光标下标对应选中项
-            MENU.Show_i = 0;               // 显示(遍历)起始下标
-            MENU.Show_i_Previous = 0;      // 上一次循环的显示下标
-            MENU.Wheel_Event = 0;          // 初始化滚轮事件
-
-            first_run = 0;
+        for (uint8_t i = 0; i <= hMENU->Option_Max_i; i++) {
+            MENU_State_Timer[i].StrLen = MENU_MeasureOption(&MENU_Page_Timer.OptionList[i], &MENU_State_Timer[i]);
         }
-
-        // 更新定时器状态
-        if (MENU_UpdateTimer()) {
-            // 定时器结束，显示"时间到"提示
-            MENU_ShowTimeUpAlert();
-        } else if (timer_enabled) {
-            // 定时器运行中，每250ms更新一次显示（降低更新频率提高性能）
-            static uint16_t last_timer_shown = 0;
-            static uint32_t last_update_time = 0;
-            uint32_t current_time = HAL_GetTick();
-
-            // 降低更新频率至250ms一次，大幅提升性能
-            if ((current_time - last_update_time >= 250) && (last_timer_shown != timer_current)) {
-                last_timer_shown = timer_current;
-                last_update_time = current_time;
-
-                // 更新启动按钮显示内容
-                sprintf(start_str, "Running (%ds)", timer_current);
-                MENU_OptionList[2].String = start_str;
-
-                // 仅当当前选中时更新光标宽度
-                if (MENU.Catch_i == 2) {
-                    MENU.OptionList[2].StrLen = strlen(start_str);
-                    MENU.AnimationUpdateEvent = 1;
-                }
-            }
+        // 选中项宽度变化时光标跟随
+        if (MENU_State_Timer[hMENU->Catch_i].StrLen != selected_len) {
+            hMENU->AnimationUpdateEvent = 1;
         }
+        timer_dirty = 0;
+    }
+
+    return MENU_PageFrame(ctx, full);
+}
 
-        /* ========= 使用 FreeRTOS 输入事件队列替代 menu_command_callback(GET_EVENT_*) ========= */
-        if (InputEventQueueHandle)
-        {
-            InputEvent evt;
-            /* 一帧内把队列事件全部消费掉，按产生顺序处理 */
-            while (osMessageQueueGet(InputEventQueueHandle, &evt, NULL, 0) == osOK)
+static void MENU_TimerPageInput(void *ctx, const InputEvent *event)
+{
+    MENU_HandleTypeDef *hMENU = (MENU_HandleTypeDef *)ctx;
+
+    switch (event->type)
+    {
+        case INPUT_ENTER: /* 确定：选项都没有子页面/函数，全部在这里处理 */
+            switch (hMENU->Catch_i)
             {
-                switch (evt.type)
-                {
-                    case INPUT_ENTER: /* 确定 */
-                    {
-                        MENU_UpdateActivity();
-
-                        switch (MENU.Catch_i)
-                        {
-                            case 0: // 返回
-                                time_adjust_mode = 0; // 退出时重置模式
-                                return;
-
-                            case 1: // 时间调节 - 切换时间调节模式
-                                time_adjust_mode = !time_adjust_mode;
-                                break;
-
-                            case 2: // 启动定时器
-                                if (!timer_enabled) {
-                                    MENU_StartTimer(timer_seconds);
-                                    // 更新启动按钮显示内容
-                                    sprintf(start_str, "Running (%ds)", timer_current);
-                                    MENU_OptionList[2].String = start_str;
-                                    // 更新字符串长度并触发光标更新
-                                    MENU.OptionList[2].StrLen = strlen(start_str);
-                                    MENU.AnimationUpdateEvent = 1;
-                                }
-                                time_adjust_mode = 0; // 启动定时器后退出调节模式
-                                break;
-
-                            case 3: // 停止定时器
-                                if (timer_enabled) {
-                                    MENU_StopTimer();
-                                    // 更新启动按钮显示内容
-                                    sprintf(start_str, "Start Timer");
-                                    MENU_OptionList[2].String = start_str;
-                                    // 更新字符串长度并触发光标更新
-                                    MENU.OptionList[2].StrLen = strlen(start_str);
-                                    MENU.AnimationUpdateEvent = 1;
-                                }
-                                break;
-                        }
-                    }
+                case 0: // 返回
+                    Screen_Pop();
                     break;
 
-                    case INPUT_BACK: /* 返回 */
-                    {
-                        MENU_UpdateActivity();
-                        // 如果在时间调节模式，先退出调节模式
-                        if (time_adjust_mode) {
-                            time_adjust_mode = 0;
-                        } else {
-                            return;
-                        }
-                    }
+                case 1: // 时间调节 - 切换时间调节模式
+                    timer_adjust_mode = !timer_adjust_mode;
+                    timer_dirty = 1;
                     break;
 
-                    case INPUT_UP:   /* 编码器逆时针 */
-                    case INPUT_DOWN: /* 编码器顺时针 */
-                    {
-                        /* 统一成 wheel_event：正数=向下/增加，负数=向上/减少 */
-                        int16_t wheel_event = 0;
-                        if (evt.type == INPUT_DOWN) {
-                            wheel_event = evt.value;
-                        } else {
-                            wheel_event = -evt.value;
-                        }
-
-                        if (wheel_event)
-                        {
-                            MENU_UpdateActivity();
-
-                            // 如果在时间调节模式且选中时间调节项，则调节时间
-                            if (time_adjust_mode && MENU.Catch_i == 1)
-                            {
-                                // 基于当前时间值优化调整步长
-                                int16_t step = 5; // 默认步长5秒
-
-                                // 时间越大，步长越大，提升用户体验
-                                if (timer_seconds >= 300) {       // >5分钟
-                                    step = 30;                    // 30秒步长
-                                } else if (timer_seconds >= 120) { // >2分钟
-                                    step = 15;                    // 15秒步长
-                                } else if (timer_seconds >= 60) {  // >1分钟
-                                    step = 10;                    // 10秒步长
-                                }
-
-                                int32_t new_timer_time = timer_seconds + (wheel_event * step);
-
-                                // 限制范围 (5-600秒 = 10分钟)
-                                if (new_timer_time < 5) new_timer_time = 5;
-                                if (new_timer_time > 600) new_timer_time = 600;
-
-                                // 只有时间真的变化时才更新
-                                if (timer_seconds != new_timer_time) {
-                                    timer_seconds = new_timer_time;
-                                    // 让静态变量追踪系统识别到时间变化
-                                    last_seconds_shown = 0xFFFF; // 强制下次循环更新时间显示
-                                }
-                            }
-                            else
-                            {
-                                // 正常菜单滚动模式：交给 MENU_UpdateIndex 统一处理循环、显示窗口等
-                                MENU.Wheel_Event = wheel_event;
-                                MENU_UpdateIndex(&MENU);
-                                MENU.Wheel_Event = 0;
-                                MENU.AnimationUpdateEvent = 1;
-                            }
-                        }
+                case 2: // 启动定时器（按钮文本由 TimerSvc_Watch 检测到启动后更新）
+                    if (!MENU_TimerRunning()) {
+                        MENU_StartTimer(timer_seconds);
                     }
+                    timer_adjust_mode = 0; // 启动定时器后退出调节模式
+                    timer_dirty = 1;
                     break;
 
-                    default:
-                        break;
-                }
+                case 3: // 停止定时器
+                    MENU_StopTimer();
+                    break;
             }
-        }
-
-        // 检查自动息屏（仅在无输入时会逐步进入睡眠）
-        MENU_CheckAutoSleep();
-
-        // 优化：只在必要时更新长度，使用静态变量跟踪是否需要完全更新
-        static uint8_t full_update_needed = 1; // 第一次需要完全更新
-        static uint8_t update_counter = 0;     // 计数器，定期完全更新
-
-        if (full_update_needed || need_update || ++update_counter >= 10) {
-            // 仅更新当前显示的项目长度，减少计算
-            int start_i = MENU.Show_i;
-            int end_i = MENU.Show_i + CURSOR_CEILING + 1;
-
-            if (end_i > MENU.Option_Max_i) end_i = MENU.Option_Max_i;
-            if (start_i < 0) start_i = 0;
+            break;
 
-            for (int i = start_i; i <= end_i; i++) {
-                MENU.OptionList[i].StrLen = MENU_ShowOption(0, 0, &MENU.OptionList[i]);
+        case INPUT_BACK: /* 返回：在时间调节模式时先退出调节模式 */
+            if (timer_adjust_mode) {
+                timer_adjust_mode = 0;
+                timer_dirty = 1;
+            } else {
+                MENU_PageInput(ctx, event);
             }
+            break;
 
-            // 已经更新，重置标志
-            full_update_needed = 0;
-            need_update = 0;
-            update_counter = 0;
-        }
-
-        // 如果屏幕未睡眠，则正常显示菜单
-    if (!screen_sleeping) {
-            menu_command_callback(BUFFER_CLEAR);
-
-            MENU_ShowOptionList(&MENU);
-            MENU_ShowCursor(&MENU);
-            MENU_DrawScrollBar(&MENU);
-
-            menu_command_callback(BUFFER_DISPLAY);
-        }
+        case INPUT_UP:   /* 编码器逆时针 */
+        case INPUT_DOWN: /* 编码器顺时针 */
+            // 如果在时间调节模式且选中时间调节项，则调节时间；否则按普通菜单滚动
+            if (timer_adjust_mode && hMENU->Catch_i == 1) {
+                // 每步 5 秒：慢转逐步精确，快速旋转由输入层加速
+                int16_t wheel_event = (event->type == INPUT_DOWN) ? event->steps : (int16_t)-event->steps;
+                int32_t new_timer_time = timer_seconds + (wheel_event * TIMER_STEP_SECONDS);
+
+                // 限制范围 (5-600秒 = 10分钟)
+                if (new_timer_time < 5) new_timer_time = 5;
+                if (new_timer_time > 600) new_timer_time = 600;
+
+                if (timer_seconds != new_timer_time) {
+                    timer_seconds = (uint16_t)new_timer_time;
+                    timer_dirty = 1;
+                }
+            } else {
+                MENU_PageInput(ctx, event);
+            }
+            break;
 
-        // 动态调整延时，减少CPU占用
-        static uint32_t last_frame_time = 0;
-        uint32_t current_time = HAL_GetTick();
-        uint32_t frame_time = current_time - last_frame_time;
+        default:
+            MENU_PageInput(ctx, event);
+            break;
+    }
+}
 
-        // 目标帧率约40FPS (25ms/帧)
-        if (frame_time < 20) {
-            osDelay(20 - frame_time); // RTOS延时让出CPU
-        } else {
-            osDelay(1); // 最小延时保证其他任务能执行
-        }
+static const UI_App MENU_TimerPageApp = {
+    .name = "timer",
+    .onEnter = MENU_TimerPageEnter,
+    .onFrame = MENU_TimerPageFrame,
+    .onInput = MENU_TimerPageInput,
+    .onExit = MENU_PageExit,
+    .onResume = MENU_PageResume,
+    .transition = UI_TRANSITION_PUSH,
+};
 
-        last_frame_time = HAL_GetTick();
-    }
+/**
+ * @brief 定时器设置菜单（压栈，不阻塞）
+ * @note  文本只在设定值、调节模式或倒计时显示的秒数（TimerSvc_Watch）变化时重新格式化
+ */
+void MENU_TimerSetting(void)
+{
+    Screen_Push(&MENU_TimerPageApp, &timer_menu);
 }
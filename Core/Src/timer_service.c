@@ -0,0 +1,238 @@
+/*
+ * timer_service.c
+ *
+ *  倒计时 / 提醒服务，见 timer_service.h
+ */
+#include "timer_service.h"
+#include "app_events.h"
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+typedef struct
+{
+    osTimerId_t timer;
+    volatile uint8_t state;     // TimerSvcState，到点回调改写
+    volatile uint8_t pending;   // 未取走的到点次数（周期提醒可能累积）
+    bool repeat;
+    uint32_t start_ms;          // 本周期起点（HAL_GetTick），周期提醒到点时前移一个周期
+    uint32_t duration_ms;
+    char label[TIMER_SVC_LABEL_MAX + 1];
+} TimerSvcSlot;
+
+static TimerSvcSlot s_slots[TIMER_SVC_MAX];
+
+static TimerSvcSlot *TimerSvc_Slot(TimerSvcId id)
+{
+    if (id < 0 || id >= TIMER_SVC_MAX || s_slots[id].state == TIMER_SVC_IDLE)
+    {
+        return NULL;
+    }
+    return &s_slots[id];
+}
+
+/* 定时器服务任务中运行：只改写状态字，显示与提示交给 UI 任务 */
+static void TimerSvc_Expired(void *argument)
+{
+    TimerSvcSlot *slot = &s_slots[(uintptr_t)argument];
+
+    if (slot->state != TIMER_SVC_RUNNING)
+    {
+        return; // 停止命令与到点交错
+    }
+    if (slot->repeat)
+    {
+        osTimerStart(slot->timer, slot->duration_ms); // 服务任务内不阻塞地重新计时
+    }
+    taskENTER_CRITICAL(); // 与 UI 任务的 TimerSvc_TakeExpired 读改写同一计数
+    if (slot->repeat)
+    {
+        slot->start_ms += slot->duration_ms;
+    }
+    else
+    {
+        slot->state = TIMER_SVC_EXPIRED;
+    }
+    if (slot->pending < UINT8_MAX)
+    {
+        slot->pending++;
+    }
+    taskEXIT_CRITICAL();
+    if (g_appEventFlags)
+    {
+        osEventFlagsSet(g_appEventFlags, APP_EVT_TIMER_DONE);
+    }
+}
+
+void TimerSvc_Init(void)
+{
+    memset(s_slots, 0, sizeof(s_slots));
+    for (uintptr_t i = 0; i < TIMER_SVC_MAX; i++)
+    {
+        s_slots[i].timer = osTimerNew(TimerSvc_Expired, osTimerOnce, (void *)i, NULL);
+    }
+}
+
+TimerSvcId TimerSvc_Start(const char *label, uint32_t duration_ms, bool repeat)
+{
+    TimerSvcSlot *slot;
+    TimerSvcId id;
+
+    if (duration_ms == 0)
+    {
+        return TIMER_SVC_NONE;
+    }
+    for (id = 0; id < TIMER_SVC_MAX; id++)
+    {
+        if (s_slots[id].state == TIMER_SVC_IDLE && s_slots[id].timer != NULL)
+        {
+            break;
+        }
+    }
+    if (id >= TIMER_SVC_MAX)
+    {
+        return TIMER_SVC_NONE;
+    }
+
+    slot = &s_slots[id];
+    strncpy(slot->label, (label != NULL) ? label : "", TIMER_SVC_LABEL_MAX);
+    slot->label[TIMER_SVC_LABEL_MAX] = '\0';
+    slot->repeat = repeat;
+    slot->duration_ms = duration_ms;
+    slot->pending = 0;
+    slot->start_ms = HAL_GetTick();
+    slot->state = TIMER_SVC_RUNNING;
+
+    if (osTimerStart(slot->timer, duration_ms) != osOK)
+    {
+        slot->state = TIMER_SVC_IDLE;
+        return TIMER_SVC_NONE;
+    }
+    return id;
+}
+
+void TimerSvc_Stop(TimerSvcId id)
+{
+    TimerSvcSlot *slot = TimerSvc_Slot(id);
+
+    if (slot == NULL)
+    {
+        return;
+    }
+    slot->state = TIMER_SVC_IDLE; // 先改状态：停止命令排队期间到点的回调直接忽略
+    osTimerStop(slot->timer);
+    slot->pending = 0;
+}
+
+void TimerSvc_StopAll(void)
+{
+    for (TimerSvcId id = 0; id < TIMER_SVC_MAX; id++)
+    {
+        TimerSvc_Stop(id);
+    }
+}
+
+TimerSvcState TimerSvc_State(TimerSvcId id)
+{
+    TimerSvcSlot *slot = TimerSvc_Slot(id);
+
+    return (slot != NULL) ? (TimerSvcState)slot->state : TIMER_SVC_IDLE;
+}
+
+const char *TimerSvc_Label(TimerSvcId id)
+{
+    /* 不检查状态：刚取走到点事件的一次性计时已释放，名称仍可用于提示 */
+    return (id >= 0 && id < TIMER_SVC_MAX) ? s_slots[id].label : "";
+}
+
+uint32_t TimerSvc_RemainingMs(TimerSvcId id)
+{
+    TimerSvcSlot *slot = TimerSvc_Slot(id);
+    uint32_t elapsed;
+
+    if (slot == NULL || slot->state != TIMER_SVC_RUNNING)
+    {
+        return 0;
+    }
+    elapsed = HAL_GetTick() - slot->start_ms;
+    return (elapsed >= slot->duration_ms) ? 0 : (slot->duration_ms - elapsed);
+}
+
+uint32_t TimerSvc_RemainingSeconds(TimerSvcId id)
+{
+    return (TimerSvc_RemainingMs(id) + 999U) / 1000U;
+}
+
+bool TimerSvc_Watch(TimerSvcId id, TimerSvcView *view)
+{
+    TimerSvcView now = {(uint8_t)TimerSvc_State(id), TimerSvc_RemainingSeconds(id)};
+
+    if (now.state == view->state && now.remaining_s == view->remaining_s)
+    {
+        return false;
+    }
+    *view = now;
+    return true;
+}
+
+uint32_t TimerSvc_MsUntilChange(TimerSvcId id)
+{
+    uint32_t ms;
+
+    if (TimerSvc_State(id) != TIMER_SVC_RUNNING)
+    {
+        return UINT32_MAX;
+    }
+    ms = TimerSvc_RemainingMs(id);
+    if (ms == 0)
+    {
+        return 1; // 已到点，等定时器服务任务的回调（不忙等）
+    }
+    return (ms % 1000U == 0U) ? 1000U : (ms % 1000U);
+}
+
+uint32_t TimerSvc_MsUntilExpiry(void)
+{
+    uint32_t best = UINT32_MAX;
+
+    for (TimerSvcId id = 0; id < TIMER_SVC_MAX; id++)
+    {
+        if (TimerSvc_State(id) == TIMER_SVC_RUNNING)
+        {
+            uint32_t ms = TimerSvc_RemainingMs(id);
+            if (ms < best) best = ms;
+        }
+    }
+    return (best == 0) ? 1 : best; // 已到点，等定时器服务任务的回调（与 TimerSvc_MsUntilChange 一致）
+}
+
+TimerSvcId TimerSvc_TakeExpired(void)
+{
+    for (TimerSvcId id = 0; id < TIMER_SVC_MAX; id++)
+    {
+        TimerSvcSlot *slot = &s_slots[id];
+        bool taken = false;
+
+        taskENTER_CRITICAL();
+        if (slot->state != TIMER_SVC_IDLE && slot->pending > 0)
+        {
+            slot->pending--;
+            if (slot->state == TIMER_SVC_EXPIRED)
+            {
+                slot->state = TIMER_SVC_IDLE;
+            }
+            taken = true;
+        }
+        taskEXIT_CRITICAL();
+        if (taken)
+        {
+            return id;
+        }
+    }
+    if (g_appEventFlags)
+    {
+        osEventFlagsClear(g_appEventFlags, APP_EVT_TIMER_DONE); // 待处理计数才是依据，标志只用于唤醒等待者
+    }
+    return TIMER_SVC_NONE;
+}
@@ -0,0 +1,246 @@
+/*
+ * ui_anim.c
+ *
+ *  Q16 定点补间/弹簧动画引擎，见 ui_anim.h
+ */
+#include "ui_anim.h"
+#include <stddef.h>
+
+#define UI_ANIM_SETTLE_POS  (Q16_ONE / 16)      // 距目标小于 1/16 像素
+#define UI_ANIM_SETTLE_VEL  (Q16_ONE / 256)     // 且速度小于 1/256 像素/ms 时视为静止
+
+typedef enum
+{
+    UI_ANIM_TWEEN = 0,
+    UI_ANIM_SPRING,
+} UI_AnimKind;
+
+typedef struct
+{
+    bool used;
+    bool settled;
+    uint8_t kind;               // UI_AnimKind
+    uint8_t ease;               // UI_AnimEase（补间）
+    q16_t value;                // 当前值
+    q16_t target;               // 目标值
+    q16_t from;                 // 补间起点
+    q16_t velocity;             // 弹簧速度 (Q16 / ms)
+    uint16_t duration_ms;       // 补间时长
+    uint16_t elapsed_ms;        // 补间已播放时间
+    int32_t stiffness;          // 弹簧刚度 (Q24 / ms^2)
+    int32_t damping;            // 弹簧阻尼 (Q16 / ms)
+} UI_AnimSlot;
+
+static UI_AnimSlot s_slots[UI_ANIM_SLOTS];
+static uint32_t s_last_ms;
+static bool s_clock_started;
+
+static UI_AnimSlot *UI_Anim_Slot(UI_AnimId id)
+{
+    if (id == UI_ANIM_NONE || id > UI_ANIM_SLOTS) return NULL;
+    if (!s_slots[id - 1].used) return NULL;
+    return &s_slots[id - 1];
+}
+
+/* 缓动曲线：p 为进度 [0, 1]，返回值同为 Q16 */
+static q16_t UI_Anim_Ease(uint8_t ease, q16_t p)
+{
+    q16_t inv = Q16_ONE - p;
+
+    switch (ease)
+    {
+    case UI_EASE_OUT_QUAD:
+        return Q16_ONE - (q16_t)(((int64_t)inv * inv) >> 16);
+
+    case UI_EASE_OUT_CUBIC:
+        return Q16_ONE - (q16_t)(((((int64_t)inv * inv) >> 16) * inv) >> 16);
+
+    case UI_EASE_LINEAR:
+    default:
+        return p;
+    }
+}
+
+/* 开始一段动画：之前全部静止时界面可能已阻塞了很久，公共时钟从下一次 UI_Anim_Update 重新计时，
+   空闲的间隔不能算进新动画的第一帧 */
+static void UI_Anim_Wake(void)
+{
+    if (UI_Anim_AllSettled()) s_clock_started = false;
+}
+
+static void UI_Anim_Settle(UI_AnimSlot *s)
+{
+    s->value = s->target;
+    s->velocity = 0;
+    s->settled = true;
+}
+
+static void UI_Anim_StepTween(UI_AnimSlot *s, uint32_t dt)
+{
+    q16_t p;
+
+    if ((uint32_t)s->elapsed_ms + dt >= s->duration_ms)
+    {
+        UI_Anim_Settle(s);
+        return;
+    }
+
+    s->elapsed_ms = (uint16_t)(s->elapsed_ms + dt);
+    p = (q16_t)(((int64_t)s->elapsed_ms << 16) / s->duration_ms);
+    s->value = s->from + (q16_t)(((int64_t)(s->target - s->from) * UI_Anim_Ease(s->ease, p)) >> 16);
+}
+
+/* 半隐式欧拉，固定 1 ms 步长：步长与帧率无关，结果只取决于流逝的时间 */
+static void UI_Anim_StepSpring(UI_AnimSlot *s, uint32_t dt)
+{
+    while (dt--)
+    {
+        q16_t err = s->value - s->target;
+        q16_t acc = -(q16_t)(((int64_t)err * s->stiffness) >> 24)
+                    - (q16_t)(((int64_t)s->velocity * s->damping) >> 16);
+
+        s->velocity += acc;
+        s->value += s->velocity;
+
+        err = s->value - s->target;
+        if (err < UI_ANIM_SETTLE_POS && err > -UI_ANIM_SETTLE_POS &&
+            s->velocity < UI_ANIM_SETTLE_VEL && s->velocity > -UI_ANIM_SETTLE_VEL)
+        {
+            UI_Anim_Settle(s);
+            return;
+        }
+    }
+}
+
+UI_AnimId UI_Anim_Alloc(q16_t initial)
+{
+    for (uint8_t i = 0; i < UI_ANIM_SLOTS; i++)
+    {
+        if (!s_slots[i].used)
+        {
+            s_slots[i] = (UI_AnimSlot){.used = true, .settled = true, .value = initial, .target = initial};
+            return (UI_AnimId)(i + 1);
+        }
+    }
+    return UI_ANIM_NONE;
+}
+
+void UI_Anim_Free(UI_AnimId *id)
+{
+    UI_AnimSlot *s = UI_Anim_Slot(*id);
+
+    if (s != NULL) s->used = false;
+    *id = UI_ANIM_NONE;
+}
+
+void UI_Anim_Set(UI_AnimId id, q16_t value)
+{
+    UI_AnimSlot *s = UI_Anim_Slot(id);
+
+    if (s == NULL) return;
+    s->target = value;
+    UI_Anim_Settle(s);
+}
+
+void UI_Anim_TweenTo(UI_AnimId id, q16_t target, uint16_t duration_ms, UI_AnimEase ease)
+{
+    UI_AnimSlot *s = UI_Anim_Slot(id);
+
+    if (s == NULL || s->target == target) return;
+
+    UI_Anim_Wake();
+    s->kind = UI_ANIM_TWEEN;
+    s->ease = (uint8_t)ease;
+    s->from = s->value;
+    s->target = target;
+    s->velocity = 0;
+    s->duration_ms = duration_ms;
+    s->elapsed_ms = 0;
+    s->settled = false;
+
+    if (duration_ms == 0) UI_Anim_Settle(s);
+}
+
+void UI_Anim_SpringTo(UI_AnimId id, q16_t target, q16_t omega, q16_t zeta)
+{
+    UI_AnimSlot *s = UI_Anim_Slot(id);
+    int64_t omega_ms;
+
+    if (s == NULL || s->target == target) return;
+
+    UI_Anim_Wake();
+    if (s->kind != UI_ANIM_SPRING) s->velocity = 0;    // 补间没有速度，从静止开始
+
+    /* 换算到毫秒：k = omega^2，c = 2 * zeta * omega */
+    omega_ms = (int64_t)omega / 1000;
+    s->kind = UI_ANIM_SPRING;
+    s->stiffness = (int32_t)((omega_ms * omega_ms) >> 8);
+    s->damping = (int32_t)((2 * (int64_t)zeta * omega_ms) >> 16);
+    s->target = target;
+    s->settled = false;
+}
+
+q16_t UI_Anim_Value(UI_AnimId id)
+{
+    UI_AnimSlot *s = UI_Anim_Slot(id);
+    return (s != NULL) ? s->value : 0;
+}
+
+q16_t UI_Anim_Target(UI_AnimId id)
+{
+    UI_AnimSlot *s = UI_Anim_Slot(id);
+    return (s != NULL) ? s->target : 0;
+}
+
+bool UI_Anim_IsSettled(UI_AnimId id)
+{
+    UI_AnimSlot *s = UI_Anim_Slot(id);
+    return (s == NULL) || s->settled;
+}
+
+void UI_Anim_Update(uint32_t now_ms)
+{
+    uint32_t dt = s_clock_started ? (now_ms - s_last_ms) : 0;
+
+    s_last_ms = now_ms;
+    s_clock_started = true;
+
+    if (dt == 0) return;
+    if (dt > UI_ANIM_MAX_STEP_MS) dt = UI_ANIM_MAX_STEP_MS;
+
+    for (uint8_t i = 0; i < UI_ANIM_SLOTS; i++)
+    {
+        UI_AnimSlot *s = &s_slots[i];
+
+        if (!s->used || s->settled) continue;
+
+        if (s->kind == UI_ANIM_SPRING)
+        {
+            UI_Anim_StepSpring(s, dt);
+        }
+        else
+        {
+            UI_Anim_StepTween(s, dt);
+        }
+    }
+}
+
+bool UI_Anim_AllSettled(void)
+{
+    for (uint8_t i = 0; i < UI_ANIM_SLOTS; i++)
+    {
+        if (s_slots[i].used && !s_slots[i].settled) return false;
+    }
+    return true;
+}
+
+uint8_t UI_Anim_InUse(void)
+{
+    uint8_t n = 0;
+
+    for (uint8_t i = 0; i < UI_ANIM_SLOTS; i++)
+    {
+        if (s_slots[i].used) n++;
+    }
+    return n;
+}
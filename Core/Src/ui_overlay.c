@@ -0,0 +1,134 @@
+#include "ui_overlay.h"
+#include "ui_popup.h"
+#include "ui_profiler.h"
+#include "OLED.h"
+#include <string.h>
+
+#define OVERLAY_CHAR_W      6       // 6x8 字体宽度
+
+typedef struct
+{
+    int16_t x, y;                               // 左上角（固定位置）
+    uint8_t len;                                // 当前字符数，0 表示隐藏
+    uint8_t shown_len;                          // 屏上已显示的字符数（缩短时需擦除多出的部分）
+    bool dirty;                                 // 内容变化、尚未发送
+    char text[OVERLAY_TEXT_MAX + 1];
+    uint8_t bitmap[OVERLAY_TEXT_MAX * OVERLAY_CHAR_W];  // 预渲染字模，每列一个字节（8 行）
+} OverlayWidget;
+
+static OverlayWidget overlay_widgets[OVERLAY_COUNT] = {
+    [OVERLAY_FPS]   = {.x = 0,  .y = 0},
+    [OVERLAY_TIMER] = {.x = 90, .y = 5},
+    [OVERLAY_NET]   = {.x = 0,  .y = 56},
+};
+
+void Overlay_SetText(OverlayId id, const char *text)
+{
+    OverlayWidget *w;
+    size_t len;
+
+    if (id >= OVERLAY_COUNT) return;
+    w = &overlay_widgets[id];
+
+    if (text == NULL) text = "";
+    len = strlen(text);
+    if (len > OVERLAY_TEXT_MAX) len = OVERLAY_TEXT_MAX;
+
+    if (len == w->len && memcmp(w->text, text, len) == 0) return;   // 内容未变
+
+    memcpy(w->text, text, len);
+    w->text[len] = '\0';
+    w->len = (uint8_t)len;
+    w->dirty = true;
+
+    /* 预渲染字模：传输时只做移位合成，不再查字库 */
+    for (size_t i = 0; i < len; i++)
+    {
+        char c = text[i];
+        if (c < ' ' || c > '~') c = ' ';
+        memcpy(&w->bitmap[i * OVERLAY_CHAR_W], OLED_F6x8[c - ' '], OVERLAY_CHAR_W);
+    }
+}
+
+void Overlay_Compose(uint8_t page, uint8_t *line)
+{
+    for (uint8_t id = 0; id < OVERLAY_COUNT; id++)
+    {
+        const OverlayWidget *w = &overlay_widgets[id];
+        uint8_t shift = (uint8_t)(w->y & 7);
+        uint8_t top = (uint8_t)(w->y / 8);
+        uint8_t keep, bits;
+        int16_t width = w->len * OVERLAY_CHAR_W;
+
+        if (w->len == 0) continue;
+
+        /* 与 OLED_ShowImage 一致：先清除字符区域，再叠加字模 */
+        for (int16_t i = 0; i < width && w->x + i < 128; i++)
+        {
+            uint8_t col = w->bitmap[i];
+            if (page == top)
+            {
+                keep = (uint8_t)~(0xFF << shift);
+                bits = (uint8_t)(col << shift);
+            }
+            else if (shift != 0 && page == top + 1)
+            {
+                keep = (uint8_t)(0xFF << shift);
+                bits = (uint8_t)(col >> (8 - shift));
+            }
+            else
+            {
+                break;
+            }
+            line[w->x + i] = (uint8_t)((line[w->x + i] & keep) | bits);
+        }
+    }
+
+    Profiler_Compose(page, line);
+    Popup_Compose(page, line); // 弹窗在最上层
+}
+
+void Overlay_Present(void)
+{
+    OLED_SetComposeHook(Overlay_Compose);
+    OLED_Update();
+    OLED_SetComposeHook(NULL);
+
+    for (uint8_t id = 0; id < OVERLAY_COUNT; id++)
+    {
+        overlay_widgets[id].shown_len = overlay_widgets[id].len;
+        overlay_widgets[id].dirty = false;
+    }
+    Popup_Presented();
+}
+
+void Overlay_Refresh(void)
+{
+    OLED_SetComposeHook(Overlay_Compose);
+    for (uint8_t id = 0; id < OVERLAY_COUNT; id++)
+    {
+        OverlayWidget *w = &overlay_widgets[id];
+        uint8_t chars;
+
+        if (!w->dirty) continue;
+
+        /* 覆盖新旧两次内容中较宽者：缩短时露出的部分恢复为底层显存 */
+        chars = (w->len > w->shown_len) ? w->len : w->shown_len;
+        if (chars > 0)
+        {
+            OLED_UpdateArea(w->x, w->y, (uint8_t)(chars * OVERLAY_CHAR_W), 8);
+        }
+        w->shown_len = w->len;
+        w->dirty = false;
+    }
+    OLED_SetComposeHook(NULL);
+}
+
+bool Overlay_IsDirty(void)
+{
+    for (uint8_t id = 0; id < OVERLAY_COUNT; id++)
+    {
+        if (overlay_widgets[id].dirty) return true;
+    }
+    return false;
+}
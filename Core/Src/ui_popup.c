@@ -0,0 +1,291 @@
+/*
+ * ui_popup.c
+ *
+ *  弹窗 / 提示条层，见 ui_popup.h
+ */
+#include "ui_popup.h"
+#include "ui_overlay.h"
+#include "ui_anim.h"
+#include "OLED.h"
+#include "OLED_Data.h"
+#include <string.h>
+
+#define POPUP_X             8       // 文本框左上角横坐标
+#define POPUP_W             112     // 文本框宽度
+#define POPUP_OFFSCREEN_Y   64      // 滑入起点/滑出终点（屏幕下方）
+
+#define POPUP_MODAL_H       28      // 对话框高度，居中
+#define POPUP_TOAST_H       20      // 提示条高度，贴近底部
+#define POPUP_TOAST_Y       42
+
+#define POPUP_BLINK_MS      300     // 对话框出现后反色闪烁两次
+#define POPUP_BLINK_COUNT   4
+
+typedef enum
+{
+    POPUP_IDLE = 0,
+    POPUP_IN,       // 滑入
+    POPUP_SHOWN,    // 停留
+    POPUP_OUT,      // 滑出
+} PopupPhase;
+
+typedef struct
+{
+    char text[POPUP_TEXT_MAX + 1];
+    uint8_t kind;                   // PopupKind
+    uint32_t duration_ms;
+} PopupMsg;
+
+static PopupMsg s_queue[POPUP_QUEUE_LEN];
+static uint8_t s_head, s_count;
+
+static PopupMsg s_cur;
+static uint8_t s_phase = POPUP_IDLE;
+static uint32_t s_shown_at;
+static UI_AnimId s_anim;
+static uint32_t s_cols[POPUP_W];    // 预渲染位图：每列一个 32 位字，bit n 为第 n 行
+static uint8_t s_height;
+static int16_t s_y;                 // 当前位置
+static bool s_inverted;             // 闪烁中的反色状态
+
+/* 屏上已显示的状态（用于计算脏区域） */
+static bool s_drawn;
+static int16_t s_drawn_y;
+static uint8_t s_drawn_h;
+static bool s_drawn_inverted;
+
+static void Popup_Render(void)
+{
+    size_t len = strlen(s_cur.text);
+    uint8_t text_row, x0;
+
+    s_height = (s_cur.kind == POPUP_MODAL) ? POPUP_MODAL_H : POPUP_TOAST_H;
+    text_row = (uint8_t)((s_height - 16) / 2);
+    x0 = (uint8_t)((POPUP_W - len * 8) / 2);
+
+    /* 边框 */
+    for (uint8_t x = 0; x < POPUP_W; x++)
+    {
+        s_cols[x] = (1UL << 0) | (1UL << (s_height - 1));
+    }
+    s_cols[0] = s_cols[POPUP_W - 1] = (s_height >= 32) ? 0xFFFFFFFFUL : ((1UL << s_height) - 1);
+
+    /* 8x16 字模按页存放：上页 8 字节 + 下页 8 字节 */
+    for (size_t i = 0; i < len; i++)
+    {
+        char c = s_cur.text[i];
+        const uint8_t *glyph;
+
+        if (c < ' ' || c > '~') c = ' ';
+        glyph = OLED_F8x16[c - ' '];
+        for (uint8_t k = 0; k < 8; k++)
+        {
+            uint32_t col = (uint32_t)glyph[k] | ((uint32_t)glyph[8 + k] << 8);
+            s_cols[x0 + i * 8 + k] |= col << text_row;
+        }
+    }
+}
+
+static int16_t Popup_RestY(void)
+{
+    return (s_cur.kind == POPUP_MODAL) ? (int16_t)((64 - POPUP_MODAL_H) / 2) : POPUP_TOAST_Y;
+}
+
+static void Popup_Dismiss(void)
+{
+    s_phase = POPUP_OUT;
+    s_inverted = false;
+    UI_Anim_TweenTo(s_anim, Q16_FROM_INT(POPUP_OFFSCREEN_Y), POPUP_SLIDE_MS, UI_EASE_OUT_CUBIC);
+}
+
+bool Popup_Show(const char *text, PopupKind kind, uint32_t duration_ms)
+{
+    PopupMsg *m;
+
+    if (s_count >= POPUP_QUEUE_LEN)
+    {
+        return false;
+    }
+
+    m = &s_queue[(s_head + s_count) % POPUP_QUEUE_LEN];
+    strncpy(m->text, text, POPUP_TEXT_MAX);
+    m->text[POPUP_TEXT_MAX] = '\0';
+    m->kind = (uint8_t)kind;
+    m->duration_ms = duration_ms;
+    s_count++;
+    return true;
+}
+
+bool Popup_IsActive(void)
+{
+    return s_phase != POPUP_IDLE || s_count > 0;
+}
+
+bool Popup_HandleInput(const InputEvent *event)
+{
+    if (event->type == INPUT_NONE || s_cur.kind != POPUP_MODAL)
+    {
+        return false;
+    }
+    if (s_phase == POPUP_IN || s_phase == POPUP_SHOWN)
+    {
+        Popup_Dismiss(); // 任意输入确认
+        return true;
+    }
+    return false;
+}
+
+uint32_t Popup_Tick(uint32_t now_ms)
+{
+    uint32_t t, next;
+
+    if (s_phase == POPUP_IDLE)
+    {
+        if (s_count == 0)
+        {
+            return UINT32_MAX;
+        }
+
+        /* 取下一条，从屏幕下方滑入 */
+        s_cur = s_queue[s_head];
+        s_head = (uint8_t)((s_head + 1) % POPUP_QUEUE_LEN);
+        s_count--;
+        Popup_Render();
+
+        if (s_anim == UI_ANIM_NONE)
+        {
+            s_anim = UI_Anim_Alloc(0);
+        }
+        UI_Anim_Set(s_anim, Q16_FROM_INT(POPUP_OFFSCREEN_Y));
+        UI_Anim_TweenTo(s_anim, Q16_FROM_INT(Popup_RestY()), POPUP_SLIDE_MS, UI_EASE_OUT_CUBIC);
+        s_phase = POPUP_IN;
+        s_drawn = false; // 新内容：整块重发
+    }
+
+    UI_Anim_Update(now_ms);
+    s_y = (s_anim != UI_ANIM_NONE) ? Q16_ROUND(UI_Anim_Value(s_anim)) : Popup_RestY();
+
+    switch (s_phase)
+    {
+    case POPUP_IN:
+        if (!UI_Anim_IsSettled(s_anim))
+        {
+            return 0;
+        }
+        s_phase = POPUP_SHOWN;
+        s_shown_at = now_ms;
+        /* fall through */
+
+    case POPUP_SHOWN:
+        t = now_ms - s_shown_at;
+        next = UINT32_MAX;
+
+        if (s_cur.duration_ms != 0)
+        {
+            if (t >= s_cur.duration_ms)
+            {
+                Popup_Dismiss();
+                return 0;
+            }
+            next = s_cur.duration_ms - t;
+        }
+
+        if (s_cur.kind == POPUP_MODAL && t < POPUP_BLINK_MS * POPUP_BLINK_COUNT)
+        {
+            uint32_t to_toggle = POPUP_BLINK_MS - (t % POPUP_BLINK_MS);
+            s_inverted = ((t / POPUP_BLINK_MS) & 1U) != 0U;
+            if (to_toggle < next) next = to_toggle;
+        }
+        else
+        {
+            s_inverted = false;
+        }
+        return next;
+
+    case POPUP_OUT:
+        if (!UI_Anim_IsSettled(s_anim))
+        {
+            return 0;
+        }
+        s_phase = POPUP_IDLE;
+        return (s_count > 0) ? 0 : UINT32_MAX; // 排队中的下一条马上滑入
+
+    default:
+        return UINT32_MAX;
+    }
+}
+
+void Popup_Compose(uint8_t page, uint8_t *line)
+{
+    uint64_t mask;
+    uint32_t box, interior;
+    uint8_t m;
+
+    if (s_phase == POPUP_IDLE || s_y >= 64)
+    {
+        return;
+    }
+
+    box = (s_height >= 32) ? 0xFFFFFFFFUL : ((1UL << s_height) - 1);
+    mask = (uint64_t)box << s_y;
+    m = (uint8_t)(mask >> (page * 8));
+    if (m == 0)
+    {
+        return;
+    }
+
+    interior = box & ~(1UL | (1UL << (s_height - 1)));
+    for (uint8_t x = 0; x < POPUP_W; x++)
+    {
+        uint32_t col = s_cols[x];
+        uint8_t bits;
+
+        if (s_inverted && x > 0 && x < POPUP_W - 1)
+        {
+            col ^= interior;
+        }
+        bits = (uint8_t)(((uint64_t)col << s_y) >> (page * 8));
+        line[POPUP_X + x] = (uint8_t)((line[POPUP_X + x] & ~m) | bits); // 不透明：框内先清除
+    }
+}
+
+void Popup_Refresh(void)
+{
+    bool visible = (s_phase != POPUP_IDLE) && (s_y < 64);
+    int16_t top = 64, bottom = 0;
+
+    if (visible == s_drawn &&
+        (!visible || (s_y == s_drawn_y && s_height == s_drawn_h && s_inverted == s_drawn_inverted)))
+    {
+        return;
+    }
+
+    /* 脏区域：旧位置与新位置的并集（滑走后露出的部分由显存恢复） */
+    if (s_drawn)
+    {
+        top = s_drawn_y;
+        bottom = s_drawn_y + s_drawn_h;
+    }
+    if (visible)
+    {
+        if (s_y < top) top = s_y;
+        if (s_y + s_height > bottom) bottom = s_y + s_height;
+    }
+    if (bottom > 64) bottom = 64;
+
+    if (top < bottom)
+    {
+        OLED_SetComposeHook(Overlay_Compose);
+        OLED_UpdateArea(POPUP_X, top, POPUP_W, (uint8_t)(bottom - top));
+        OLED_SetComposeHook(NULL);
+    }
+    Popup_Presented();
+}
+
+void Popup_Presented(void)
+{
+    s_drawn = (s_phase != POPUP_IDLE) && (s_y < 64);
+    s_drawn_y = s_y;
+    s_drawn_h = s_height;
+    s_drawn_inverted = s_inverted;
+}
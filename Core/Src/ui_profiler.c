@@ -0,0 +1,293 @@
+/*
+ * ui_profiler.c
+ *
+ *  帧耗时分析器，见 ui_profiler.h
+ */
+#include "ui_profiler.h"
+#include "main.h"
+#include <stdio.h>
+#include <string.h>
+
+/* 高精度计时：目标板用 DWT 周期计数器（随内核时钟，100 MHz 时 10 ns 分辨率）；
+   主机端没有 DWT，退化为假时钟的毫秒数 */
+#ifdef DWT
+#define PROFILER_CYCLES()           (DWT->CYCCNT)
+#define PROFILER_CYCLES_PER_US()    (SystemCoreClock / 1000000U)
+#else
+#define PROFILER_CYCLES()           (HAL_GetTick() * 1000U)
+#define PROFILER_CYCLES_PER_US()    1U
+#endif
+
+/* 超过此时长的阶段改用 HAL 节拍计时：周期计数器约 40 s 回绕，STOP 模式下也不计数 */
+#define PROFILER_TICK_FALLBACK_MS   100U
+
+#define PROFILER_GRAPH_X            24      // 折线左上角（FPS 数字右侧）
+#define PROFILER_GRAPH_US_PER_PX    2000U   // 每像素高度代表的耗时，满格 16 ms
+
+typedef struct
+{
+    uint32_t buckets[PROFILER_BUCKETS];
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t sum_us;            // 拷机时 32 位微秒数一个多小时就会溢出
+} ProfilerHist;
+
+/* 各桶的上界（微秒），最后一桶为溢出：低段细分，便于区分 SPI 发送与绘制的毫秒级差异 */
+static const uint16_t s_edges[PROFILER_BUCKETS - 1] = {
+    250, 500, 1000, 1500, 2000, 3000, 4000, 5000,
+    6500, 8000, 10000, 12500, 16000, 20000, 33000,
+};
+
+static const char *const s_names[PROFILER_PHASES] = {"in", "lay", "ras", "tx", "idle"};
+
+static ProfilerHist s_hist[PROFILER_PHASES + 1];    // 各阶段 + 整帧
+static ProfilerHist s_input;                        // 输入延迟
+static uint16_t s_spark[PROFILER_SPARK_LEN];        // 最近各帧的忙碌时间（微秒，饱和）
+static uint8_t s_spark_head;                        // 下一次写入的位置（也是最旧的一列）
+static bool s_graph;
+
+/* 当前帧 */
+static uint32_t s_frame_us[PROFILER_PHASES];
+static uint8_t s_phase = PROFILER_IDLE;
+static uint32_t s_phase_cycles;
+static uint32_t s_phase_tick;
+static bool s_started;
+static bool s_presented;
+
+/* FPS：每 1000 ms 窗口内发送的帧数 */
+static uint32_t s_fps_frames;
+static uint32_t s_fps_tick;
+static uint32_t s_fps;
+
+static void Profiler_Record(ProfilerHist *h, uint32_t us)
+{
+    uint8_t b = 0;
+
+    while (b < PROFILER_BUCKETS - 1 && us > s_edges[b])
+    {
+        b++;
+    }
+    h->buckets[b]++;
+    if (h->count == 0 || us < h->min_us)
+    {
+        h->min_us = us;
+    }
+    if (us > h->max_us)
+    {
+        h->max_us = us;
+    }
+    h->count++;
+    h->sum_us += us;
+}
+
+/* 取第 pct 百分位所在桶的上界；落在溢出桶时用最大值 */
+static uint32_t Profiler_Percentile(const ProfilerHist *h, uint32_t pct)
+{
+    uint32_t target = (h->count * pct + 99U) / 100U;
+    uint32_t seen = 0;
+    uint32_t us = h->max_us;
+
+    for (uint8_t b = 0; b < PROFILER_BUCKETS - 1; b++)
+    {
+        seen += h->buckets[b];
+        if (seen >= target)
+        {
+            us = s_edges[b];
+            break;
+        }
+    }
+    if (us > h->max_us) us = h->max_us;
+    if (us < h->min_us) us = h->min_us;
+    return us;
+}
+
+/* 把上一次切换到现在的时间记到当前阶段 */
+static void Profiler_Charge(void)
+{
+    uint32_t cycles = PROFILER_CYCLES();
+    uint32_t tick = HAL_GetTick();
+    uint32_t us;
+
+    if (tick - s_phase_tick >= PROFILER_TICK_FALLBACK_MS)
+    {
+        us = (tick - s_phase_tick) * 1000U;
+    }
+    else
+    {
+        us = (cycles - s_phase_cycles) / PROFILER_CYCLES_PER_US();
+    }
+    s_frame_us[s_phase] += us;
+    s_phase_cycles = cycles;
+    s_phase_tick = tick;
+}
+
+void Profiler_Init(void)
+{
+#ifdef DWT
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    Profiler_Reset();
+}
+
+void Profiler_Reset(void)
+{
+    memset(s_hist, 0, sizeof(s_hist));
+    memset(&s_input, 0, sizeof(s_input));
+    memset(s_spark, 0, sizeof(s_spark));
+    s_spark_head = 0;
+    s_started = false;
+}
+
+void Profiler_FrameBegin(void)
+{
+    uint32_t busy = 0;
+
+    Profiler_Charge();
+    if (s_started && s_presented)
+    {
+        for (uint8_t p = 0; p < PROFILER_PHASES; p++)
+        {
+            Profiler_Record(&s_hist[p], s_frame_us[p]);
+            if (p != PROFILER_IDLE)
+            {
+                busy += s_frame_us[p];
+            }
+        }
+        Profiler_Record(&s_hist[PROFILER_FRAME], busy);
+
+        s_spark[s_spark_head] = (uint16_t)((busy > 0xFFFFU) ? 0xFFFFU : busy);
+        s_spark_head = (uint8_t)((s_spark_head + 1U) % PROFILER_SPARK_LEN);
+    }
+
+    memset(s_frame_us, 0, sizeof(s_frame_us));
+    s_phase = PROFILER_INPUT;
+    s_started = true;
+    s_presented = false;
+}
+
+ProfilerPhase Profiler_Phase(ProfilerPhase phase)
+{
+    ProfilerPhase prev = (ProfilerPhase)s_phase;
+
+    if (phase != prev && phase < PROFILER_PHASES)
+    {
+        Profiler_Charge();
+        s_phase = (uint8_t)phase;
+    }
+    return prev;
+}
+
+void Profiler_Presented(void)
+{
+    uint32_t now = HAL_GetTick();
+
+    s_presented = true;
+    s_fps_frames++;
+    if (now - s_fps_tick >= 1000U)
+    {
+        s_fps = s_fps_frames;
+        s_fps_frames = 0;
+        s_fps_tick = now;
+    }
+}
+
+uint32_t Profiler_Fps(void)
+{
+    return s_fps;
+}
+
+static void Profiler_Summarize(const ProfilerHist *h, ProfilerStats *out)
+{
+    memset(out, 0, sizeof(*out));
+    if (h->count == 0)
+    {
+        return;
+    }
+
+    out->count = h->count;
+    out->min_us = h->min_us;
+    out->avg_us = (uint32_t)(h->sum_us / h->count);
+    out->p95_us = Profiler_Percentile(h, 95);
+    out->p99_us = Profiler_Percentile(h, 99);
+    out->max_us = h->max_us;
+}
+
+void Profiler_GetStats(ProfilerPhase phase, ProfilerStats *out)
+{
+    if (phase > PROFILER_FRAME)
+    {
+        memset(out, 0, sizeof(*out));
+        return;
+    }
+    Profiler_Summarize(&s_hist[phase], out);
+}
+
+void Profiler_InputLatency(uint32_t ms)
+{
+    Profiler_Record(&s_input, (ms > UINT32_MAX / 1000U) ? UINT32_MAX : ms * 1000U);
+}
+
+void Profiler_GetInputStats(ProfilerStats *out)
+{
+    Profiler_Summarize(&s_input, out);
+}
+
+int Profiler_Format(char *buf, uint32_t size)
+{
+    ProfilerStats st;
+    int len;
+
+    /* 整帧：min/avg/p95/p99/max；各阶段：avg/p99（微秒） */
+    Profiler_GetStats(PROFILER_FRAME, &st);
+    len = snprintf(buf, size, "frames=%lu fps=%lu frame_us=%lu/%lu/%lu/%lu/%lu",
+                   (unsigned long)st.count, (unsigned long)s_fps,
+                   (unsigned long)st.min_us, (unsigned long)st.avg_us, (unsigned long)st.p95_us,
+                   (unsigned long)st.p99_us, (unsigned long)st.max_us);
+
+    for (uint8_t p = 0; p < PROFILER_PHASES && len > 0 && (uint32_t)len < size; p++)
+    {
+        Profiler_GetStats((ProfilerPhase)p, &st);
+        len += snprintf(buf + len, size - (uint32_t)len, " %s=%lu/%lu",
+                        s_names[p], (unsigned long)st.avg_us, (unsigned long)st.p99_us);
+    }
+
+    /* 输入延迟：avg/p99/max */
+    Profiler_GetInputStats(&st);
+    if (len > 0 && (uint32_t)len < size)
+    {
+        len += snprintf(buf + len, size - (uint32_t)len, " input=%lu/%lu/%lu",
+                        (unsigned long)st.avg_us, (unsigned long)st.p99_us, (unsigned long)st.max_us);
+    }
+    return len;
+}
+
+void Profiler_SetGraph(bool on)
+{
+    s_graph = on;
+}
+
+bool Profiler_GraphEnabled(void)
+{
+    return s_graph;
+}
+
+void Profiler_Compose(uint8_t page, uint8_t *line)
+{
+    if (!s_graph || page != 0)
+    {
+        return;
+    }
+
+    /* 从最旧到最新逐列画柱，柱从底部向上长 */
+    for (uint8_t i = 0; i < PROFILER_SPARK_LEN; i++)
+    {
+        uint32_t us = s_spark[(s_spark_head + i) % PROFILER_SPARK_LEN];
+        uint32_t h = (us + PROFILER_GRAPH_US_PER_PX - 1U) / PROFILER_GRAPH_US_PER_PX;
+
+        if (h > 8U) h = 8U;
+        line[PROFILER_GRAPH_X + i] = (uint8_t)(0xFFU << (8U - h));
+    }
+}
@@ -0,0 +1,209 @@
+/*
+ * ui_screen.c
+ *
+ *  屏幕栈与统一帧循环，见 ui_screen.h
+ */
+#include "ui_screen.h"
+#include "MENU.h"
+#include "time_task.h"
+#include "config_store.h"
+#include "ui_popup.h"
+#include "ui_profiler.h"
+#include "main.h"
+#include "cmsis_os.h"
+
+typedef struct
+{
+    const UI_App *app;
+    void *ctx;
+} UI_Screen;
+
+static UI_Screen s_stack[UI_SCREEN_DEPTH];
+static uint8_t s_depth = 0;
+static bool s_full = true;      // 下一帧整屏重画
+
+/* 栈顶变化后，按新栈顶界面使能输入手势 */
+static void Screen_ApplyGestures(void)
+{
+    Input_SetGestures((s_depth > 0) ? s_stack[s_depth - 1].app->gestures : 0U);
+}
+
+bool Screen_Push(const UI_App *app, void *ctx)
+{
+    if (s_depth >= UI_SCREEN_DEPTH)
+    {
+        return false;
+    }
+
+    if (s_depth > 0 && !screen_sleeping)
+    {
+        Transition_Arm(app->transition, false); // 当前画面作为过渡的旧画面
+    }
+
+    s_stack[s_depth].app = app;
+    s_stack[s_depth].ctx = ctx;
+    s_depth++;
+    s_full = true;
+    Screen_ApplyGestures();
+
+    if (app->onEnter != NULL)
+    {
+        app->onEnter(ctx);
+    }
+    return true;
+}
+
+void Screen_Pop(void)
+{
+    UI_Screen *top;
+
+    if (s_depth == 0)
+    {
+        return;
+    }
+
+    top = &s_stack[--s_depth];
+    if (top->app->onExit != NULL)
+    {
+        top->app->onExit(top->ctx);
+    }
+
+    s_full = true;
+    Screen_ApplyGestures();
+    if (s_depth > 0)
+    {
+        if (!screen_sleeping)
+        {
+            Transition_Arm(top->app->transition, true); // 返回：按退出界面的过渡反向播放
+        }
+        top = &s_stack[s_depth - 1];
+        if (top->app->onResume != NULL)
+        {
+            top->app->onResume(top->ctx);
+        }
+    }
+}
+
+void Screen_Reset(void)
+{
+    while (s_depth > 0)
+    {
+        UI_Screen *top = &s_stack[--s_depth];
+        if (top->app->onExit != NULL)
+        {
+            top->app->onExit(top->ctx);
+        }
+    }
+    Transition_Cancel();
+    s_full = true;
+    Screen_ApplyGestures();
+}
+
+uint8_t Screen_Depth(void)
+{
+    return s_depth;
+}
+
+void Screen_Invalidate(void)
+{
+    s_full = true;
+}
+
+void Screen_Run(void)
+{
+    while (s_depth > 0)
+    {
+        UI_Screen *top;
+        InputEvent event;
+        uint32_t wait = 0;
+        uint32_t popup_wait;
+
+        // 1) 息屏判定：超时则关闭面板并阻塞，直到输入或倒计时到点才返回（面板保留原画面）
+        MENU_CheckAutoSleep();
+        Profiler_FrameBegin(); // 每一轮为一帧，从这里开始计时（息屏阻塞计入上一帧的空闲）
+
+        // 2) 定时器：取走软件定时器回调标记的到点事件，排队模态弹窗（不阻塞，页面照常运行）
+        MENU_ServiceTimers();
+
+        // 3) 输入：先处理事件再绘制，等待中到来的输入在同一轮就能显示；模态弹窗优先
+        event = MENU_ReceiveInputEvent();
+        if (event.type != INPUT_NONE)
+        {
+            MENU_UpdateActivity();
+            top = &s_stack[s_depth - 1];
+            if (!Popup_HandleInput(&event))
+            {
+                top->app->onInput(top->ctx, &event); // 输入引起的变化由屏幕自己增量重画
+            }
+            if (s_depth == 0)
+            {
+                break;
+            }
+        }
+
+        // 4) 绘制：仅在屏幕未睡眠时；弹窗在页面之后按自己的脏区域刷新
+        Profiler_Phase(PROFILER_RASTER);
+        if (!screen_sleeping && Transition_IsRunning())
+        {
+            if (Transition_Step(HAL_GetTick()))
+            {
+                MENU_Present(); // 过渡中：只合成两张离屏画面，不重画界面
+            }
+            else
+            {
+                s_full = true;  // 过渡结束：本轮整屏重画，界面自己的动画从这里继续
+            }
+        }
+        if (!screen_sleeping && !Transition_IsRunning())
+        {
+            bool full = s_full;
+
+            s_full = false;
+            top = &s_stack[s_depth - 1];
+            wait = top->app->onFrame(top->ctx, full);
+
+            if (Transition_IsArmed())
+            {
+                Transition_Start(HAL_GetTick()); // 新界面的第一帧只画进显存，作为过渡终点
+            }
+        }
+        if (Transition_IsRunning())
+        {
+            wait = 0;
+        }
+        Profiler_Phase(PROFILER_LAYOUT);
+        popup_wait = Popup_Tick(HAL_GetTick()); // 绘制中新加入的弹窗（如联网提示）在本轮开始滑入
+        if (!screen_sleeping && !Transition_IsRunning())
+        {
+            Profiler_Phase(PROFILER_TRANSFER);
+            Popup_Refresh();
+            Profiler_Phase(PROFILER_LAYOUT);
+        }
+        if (popup_wait < wait)
+        {
+            wait = popup_wait;
+        }
+
+        Config_FlushIfNeeded();
+
+        if (event.type != INPUT_NONE && event.time != 0U)
+        {
+            Profiler_InputLatency(HAL_GetTick() - event.time); // 输入沿到画面送出
+        }
+        Profiler_Phase(PROFILER_IDLE);
+        // 5) 等待：画面静止时阻塞到输入或下一个截止时间，动画播放中按帧间隔继续
+        if (wait == 0)
+        {
+            osDelay(UI_FRAME_MS);  // 使用 osDelay 让出 CPU
+        }
+        else
+        {
+            uint32_t timeout = MENU_NextDeadline();
+            if (wait < timeout)
+            {
+                timeout = wait;
+            }
+            MENU_WaitInput(timeout);
+        }
+    }
+}
@@ -0,0 +1,185 @@
+/*
+ * ui_transition.c
+ *
+ *  屏幕过渡合成，见 ui_transition.h
+ */
+#include "ui_transition.h"
+#include <string.h>
+
+extern uint8_t OLED_DisplayBuf[8][128];     // OLED 显存
+
+#define SCREEN_W    128
+#define SCREEN_PAGES 8
+
+typedef enum
+{
+    TRANSITION_IDLE = 0,
+    TRANSITION_ARMED,
+    TRANSITION_RUNNING,
+} TransitionPhase;
+
+static uint8_t s_from[SCREEN_PAGES][SCREEN_W];  // 旧画面
+static uint8_t s_to[SCREEN_PAGES][SCREEN_W];    // 新画面
+static uint8_t s_phase = TRANSITION_IDLE;
+static uint8_t s_kind;
+static bool s_backward;
+static uint32_t s_start_ms;
+
+/* 4x4 Bayer 阈值：level 个格子以下的像素已换成新画面 */
+static const uint8_t s_bayer[4][4] = {
+    { 0,  8,  2, 10},
+    {12,  4, 14,  6},
+    { 3, 11,  1,  9},
+    {15,  7, 13,  5},
+};
+
+/* 缓出三次曲线，返回 0 ~ SCREEN_W */
+static int16_t Transition_Progress(uint32_t elapsed)
+{
+    uint32_t r, r3;
+
+    if (elapsed >= UI_TRANSITION_MS)
+    {
+        return SCREEN_W;
+    }
+    r = ((UI_TRANSITION_MS - elapsed) << 8) / UI_TRANSITION_MS;    // 剩余比例，Q8
+    r3 = (r * r * r) >> 16;
+    return (int16_t)(SCREEN_W - ((r3 * SCREEN_W) >> 8));
+}
+
+/* 左侧 split 列取 left 的 [left_x, ...)，其余取 right 的 [0, ...)：每页两次拷贝 */
+static void Transition_Join(uint8_t (*left)[SCREEN_W], int16_t left_x,
+                            uint8_t (*right)[SCREEN_W], int16_t split)
+{
+    for (uint8_t page = 0; page < SCREEN_PAGES; page++)
+    {
+        memcpy(&OLED_DisplayBuf[page][0], &left[page][left_x], (size_t)split);
+        memcpy(&OLED_DisplayBuf[page][split], &right[page][0], (size_t)(SCREEN_W - split));
+    }
+}
+
+static void Transition_Dither(int16_t progress)
+{
+    uint8_t level = (uint8_t)((progress * 16) / SCREEN_W);
+    uint8_t mask[4];
+
+    /* 每列的掩码只取决于 x & 3：8 行正好是两次 4 行周期 */
+    for (uint8_t c = 0; c < 4; c++)
+    {
+        uint8_t m = 0;
+        for (uint8_t r = 0; r < 8; r++)
+        {
+            if (s_bayer[r & 3][c] < level)
+            {
+                m |= (uint8_t)(1U << r);
+            }
+        }
+        mask[c] = m;
+    }
+
+    for (uint8_t page = 0; page < SCREEN_PAGES; page++)
+    {
+        for (uint8_t x = 0; x < SCREEN_W; x++)
+        {
+            uint8_t m = mask[x & 3];
+            OLED_DisplayBuf[page][x] = (uint8_t)((s_to[page][x] & m) | (s_from[page][x] & (uint8_t)~m));
+        }
+    }
+}
+
+void Transition_Arm(UI_TransitionKind kind, bool backward)
+{
+    if (kind == UI_TRANSITION_NONE)
+    {
+        return;
+    }
+
+    /* 过渡中再次切换：以当前合成结果为旧画面，接着过渡到下一个界面；
+       新画面还没画出来就又切换时，保留原来的旧画面 */
+    if (s_phase != TRANSITION_ARMED)
+    {
+        memcpy(s_from, OLED_DisplayBuf, sizeof(s_from));
+    }
+    s_kind = (uint8_t)kind;
+    s_backward = backward;
+    s_phase = TRANSITION_ARMED;
+}
+
+bool Transition_IsArmed(void)
+{
+    return s_phase == TRANSITION_ARMED;
+}
+
+void Transition_Start(uint32_t now_ms)
+{
+    if (s_phase != TRANSITION_ARMED)
+    {
+        return;
+    }
+
+    memcpy(s_to, OLED_DisplayBuf, sizeof(s_to));
+    s_start_ms = now_ms;
+    s_phase = TRANSITION_RUNNING;
+}
+
+bool Transition_IsRunning(void)
+{
+    return s_phase == TRANSITION_RUNNING;
+}
+
+bool Transition_Step(uint32_t now_ms)
+{
+    int16_t p;
+
+    if (s_phase != TRANSITION_RUNNING)
+    {
+        return false;
+    }
+
+    p = Transition_Progress(now_ms - s_start_ms);
+    if (p >= SCREEN_W)
+    {
+        memcpy(OLED_DisplayBuf, s_to, sizeof(s_to));
+        s_phase = TRANSITION_IDLE;
+        return false;
+    }
+
+    switch (s_kind)
+    {
+    case UI_TRANSITION_SLIDE:
+        if (!s_backward)
+        {
+            Transition_Join(s_from, 0, s_to, SCREEN_W - p);     // 新画面从右侧盖上
+        }
+        else
+        {
+            Transition_Join(s_to, 0, s_from, p);                // 旧画面向右滑走
+        }
+        break;
+
+    case UI_TRANSITION_PUSH:
+        if (!s_backward)
+        {
+            Transition_Join(s_from, p, s_to, SCREEN_W - p);     // 整体左移
+        }
+        else
+        {
+            Transition_Join(s_to, SCREEN_W - p, s_from, p);     // 整体右移
+        }
+        break;
+
+    default:
+        Transition_Dither(p);
+        break;
+    }
+    return true;
+}
+
+void Transition_Cancel(void)
+{
+    if (s_phase == TRANSITION_RUNNING)
+    {
+        memcpy(OLED_DisplayBuf, s_to, sizeof(s_to));
+    }
+    s_phase = TRANSITION_IDLE;
+}
@@ -0,0 +1,205 @@
+/*
+ * ui_widget.c
+ *
+ *  设置/信息页面控件，见 ui_widget.h
+ */
+#include "ui_widget.h"
+#include "ui_screen.h"
+#include "MENU.h"
+#include "OLED.h"
+#include "config_store.h"
+#include <stdio.h>
+#include <string.h>
+
+/* 布局 */
+#define WIDGET_X        5       // 左边距
+#define WIDGET_LINE_H   16      // 文本行高
+#define WIDGET_VALUE_Y  20      // 数值行
+#define WIDGET_BAR_Y    35      // 进度条/开关图形
+#define WIDGET_HINT_Y   48      // 底部提示
+#define WIDGET_BAR_W    118     // 进度条宽度
+#define WIDGET_BAR_H    8       // 进度条高度
+
+typedef struct
+{
+    const UI_Widget *def;
+    int32_t entry_value;        // 进入时的值，退出时比较决定是否保存
+    int32_t shown_value;        // 屏幕上显示的值
+} UI_WidgetState;
+
+static UI_WidgetState s_states[UI_SCREEN_DEPTH];   // 按所在栈深度分配
+
+static void Widget_FormatValue(const UI_Widget *w, int32_t value, char *buf)
+{
+    if (w->format != NULL)
+    {
+        w->format(value, buf);
+    }
+    else if (w->kind == UI_WIDGET_TOGGLE)
+    {
+        strcpy(buf, value ? "ON" : "OFF");
+    }
+    else
+    {
+        snprintf(buf, UI_WIDGET_TEXT_MAX, "%ld", (long)value);
+    }
+}
+
+/* 数值区域（WIDGET_VALUE_Y ~ WIDGET_HINT_Y - 1）：标签、右对齐的数值与控件图形 */
+static void Widget_DrawValue(const UI_Widget *w, int32_t value)
+{
+    char buf[UI_WIDGET_TEXT_MAX];
+
+    OLED_ClearArea(0, WIDGET_VALUE_Y, 128, WIDGET_HINT_Y - WIDGET_VALUE_Y);
+
+    OLED_ShowString(WIDGET_X, WIDGET_VALUE_Y, (char *)w->label, OLED_8X16);
+    Widget_FormatValue(w, value, buf);
+    OLED_ShowString(128 - WIDGET_X - (int16_t)strlen(buf) * MENU_FONT_W, WIDGET_VALUE_Y, buf, OLED_8X16);
+
+    switch (w->kind)
+    {
+    case UI_WIDGET_SLIDER:
+        if (w->max > w->min)
+        {
+            MENU_DrawProgressBar(WIDGET_X, WIDGET_BAR_Y, WIDGET_BAR_W, WIDGET_BAR_H,
+                                 (uint8_t)(((value - w->min) * 100) / (w->max - w->min)));
+        }
+        break;
+
+    case UI_WIDGET_TOGGLE:
+        // 拨动开关：外框 + 滑块，打开时滑块在右
+        OLED_DrawRectangle(WIDGET_X, WIDGET_BAR_Y, 20, 9, OLED_UNFILLED);
+        OLED_DrawRectangle(WIDGET_X + (value ? 11 : 2), WIDGET_BAR_Y + 2, 7, 5, OLED_FILLED);
+        break;
+
+    default:
+        break; // 数值微调只显示数字
+    }
+}
+
+static void Widget_DrawFull(UI_WidgetState *st)
+{
+    const UI_Widget *w = st->def;
+    char buf[UI_WIDGET_TEXT_MAX];
+
+    if (w->title != NULL)
+    {
+        OLED_ShowString((128 - (int16_t)strlen(w->title) * MENU_FONT_W) / 2, 0, (char *)w->title, OLED_8X16);
+    }
+
+    if (w->kind == UI_WIDGET_TEXT)
+    {
+        for (uint8_t row = 0; row < UI_WIDGET_LINES && w->line != NULL; row++)
+        {
+            const char *text = w->line(row, buf);
+            if (text != NULL)
+            {
+                OLED_ShowString(WIDGET_X, (row + 1) * WIDGET_LINE_H, (char *)text, OLED_8X16);
+            }
+        }
+        return;
+    }
+
+    st->shown_value = w->get();
+    Widget_DrawValue(w, st->shown_value);
+    if (w->hint != NULL)
+    {
+        OLED_ShowString(WIDGET_X, WIDGET_HINT_Y, (char *)w->hint, OLED_8X16);
+    }
+}
+
+static void Widget_Enter(void *ctx)
+{
+    UI_WidgetState *st = (UI_WidgetState *)ctx;
+
+    if (st->def->kind != UI_WIDGET_TEXT)
+    {
+        st->entry_value = st->def->get();
+    }
+}
+
+static uint32_t Widget_Frame(void *ctx, bool full)
+{
+    UI_WidgetState *st = (UI_WidgetState *)ctx;
+    const UI_Widget *w = st->def;
+
+    if (full)
+    {
+        OLED_Clear();
+        Widget_DrawFull(st);
+        MENU_Display();
+        return UI_SCREEN_IDLE;
+    }
+
+    // 数值变化：只重画数值区域并局部刷新
+    if (w->kind != UI_WIDGET_TEXT)
+    {
+        int32_t value = w->get();
+        if (value != st->shown_value)
+        {
+            st->shown_value = value;
+            Widget_DrawValue(w, value);
+            OLED_UpdateArea(0, WIDGET_VALUE_Y, 128, WIDGET_HINT_Y - WIDGET_VALUE_Y);
+        }
+    }
+    MENU_RefreshOverlay(); // 倒计时跳秒时只刷新小部件区域
+    return UI_SCREEN_IDLE; // 静止：阻塞到输入或下一次跳秒/息屏
+}
+
+static void Widget_Input(void *ctx, const InputEvent *event)
+{
+    UI_WidgetState *st = (UI_WidgetState *)ctx;
+    const UI_Widget *w = st->def;
+    int32_t value, delta;
+
+    if (event->type == INPUT_ENTER || event->type == INPUT_BACK)
+    {
+        if (w->kind != UI_WIDGET_TEXT && w->get() != st->entry_value)
+        {
+            Config_MarkDirty(); // 有修改才保存（延迟落盘）
+        }
+        Screen_Pop();
+        return;
+    }
+
+    if ((event->type != INPUT_UP && event->type != INPUT_DOWN) || w->kind == UI_WIDGET_TEXT)
+    {
+        return;
+    }
+
+    // 下滚(顺时针) = 增加；数值微调使用输入层按转速加速后的步数，滑块与开关逐格；按住旋转时都按放大的步数
+    delta = (w->kind == UI_WIDGET_SPINNER || (event->mods & INPUT_MOD_HELD)) ? event->steps : event->value;
+    delta = ((event->type == INPUT_DOWN) ? delta : -delta) * w->step;
+
+    value = w->get() + delta;
+    if (value < w->min) value = w->min;
+    if (value > w->max) value = w->max;
+    if (value != w->get())
+    {
+        w->set(value);
+    }
+}
+
+static const UI_App Widget_App = {
+    .name = "widget",
+    .onEnter = Widget_Enter,
+    .onFrame = Widget_Frame,
+    .onInput = Widget_Input,
+    .transition = UI_TRANSITION_SLIDE,
+    .gestures = INPUT_GESTURE_PRESS_ROTATE,
+};
+
+bool Widget_Push(const UI_Widget *widget)
+{
+    UI_WidgetState *st;
+
+    if (Screen_Depth() >= UI_SCREEN_DEPTH)
+    {
+        return false;
+    }
+
+    st = &s_states[Screen_Depth()];
+    memset(st, 0, sizeof(*st));
+    st->def = widget;
+    return Screen_Push(&Widget_App, st);
+}
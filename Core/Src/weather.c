@@ -7,9 +7,9 @@
 
 #include "weather.h"
 
-#include "MENU.h"     // 使用 MENU_ReceiveInputEvent / MENU_UpdateActivity
+#include "MENU.h"     // 使用 MENU_Display / MENU_RefreshOverlay
 #include "OLED.h"
-#include "cmsis_os.h"
+#include "ui_screen.h"
 
 #include <string.h>
 #include <stdio.h>
@@ -19,9 +19,6 @@
 /* 可支持的最大城市数（后续从 API 加城市也方便） */
 #define WEATHER_MAX_CITIES 10
 
-/* 动画速度（独立于 MENU.c，避免耦合） */
-#define WEATHER_ANIMATION_SPEED 0.30f
-
 static WeatherData_t s_weather_list[WEATHER_MAX_CITIES];
 static uint8_t s_weather_count = 0;
 
@@ -94,7 +91,7 @@ bool Weather_AddCity(const WeatherData_t* w)
     return Weather_SetCity((size_t)s_weather_count, w);
 }
 
-/* 绘制单个天气卡片（offset_x: 0 为居中，±128 用于左右滑动） */
+/* 绘制单个天气卡片（offset_x: 0 为居中） */
 static void Weather_DrawCard(const WeatherData_t *w, int16_t offset_x)
 {
     if (!w) return;
@@ -138,98 +135,75 @@ static void Weather_DrawIndicator(uint8_t current, uint8_t total)
     }
 }
 
-void Weather_Run(void)
+/* 天气全屏界面：屏幕栈上的应用，由 Screen_Run 驱动；卡片只在切换、进入和弹窗之后重画一次，
+   静止时阻塞等待输入，不再每 10 ms 重画 */
+static uint8_t s_weather_idx = 0;
+
+static void Weather_Enter(void *ctx)
 {
+    (void)ctx;
     if (s_weather_count == 0) {
         Weather_InitDefault();
     }
+    s_weather_idx = 0;
+}
 
-    uint8_t current_idx = 0;
-    uint8_t from_idx = 0;         // 动画开始时的旧页面
-    uint8_t to_idx = 0;           // 动画目标页面（current_idx 同步为 to_idx）
-    int16_t anim_offset = 0;      // 动画偏移量
-    int16_t target_offset = 0;    // 目标偏移量（始终为 0）
-    uint8_t is_animating = 0;     // 是否正在动画中
-    int8_t swipe_dir = 0;         // 滑动方向 (-1=左, 1=右)
-
-    while (1)
-    {
-        InputEvent event = MENU_ReceiveInputEvent();
-
-        if (event.type == INPUT_ENTER || event.type == INPUT_BACK) {
-            MENU_UpdateActivity();
-            return;
-        }
-
-        /* 旋转切换城市（动画期间不响应，避免状态叠加） */
-        if (!is_animating) {
-            if (event.type == INPUT_DOWN) { // 顺时针 -> 下一个城市
-                if (s_weather_count > 1) {
-                    from_idx = current_idx;
-                    to_idx = (uint8_t)((current_idx + 1) % s_weather_count); // 环形：最后一个也能到第一个
-                    current_idx = to_idx;
-                    swipe_dir = -1;      // 新卡片从右往左滑入
-                    is_animating = 1;
-                    anim_offset = 128;   // 新卡片从右边进入
-                    MENU_UpdateActivity();
-                }
-            } else if (event.type == INPUT_UP) { // 逆时针 -> 上一个城市
-                if (s_weather_count > 1) {
-                    from_idx = current_idx;
-                    to_idx = (uint8_t)((current_idx + s_weather_count - 1) % s_weather_count); // 环形：第一个也能到最后一个
-                    current_idx = to_idx;
-                    swipe_dir = 1;       // 新卡片从左往右滑入
-                    is_animating = 1;
-                    anim_offset = -128;  // 新卡片从左边进入
-                    MENU_UpdateActivity();
-                }
-            }
-        }
+static uint32_t Weather_Frame(void *ctx, bool full)
+{
+    (void)ctx;
 
-        /* 动画更新：确保至少移动 1 像素，避免卡死 */
-        if (is_animating) {
-            int16_t diff = (int16_t)(target_offset - anim_offset);
-            if (diff > 2 || diff < -2) {
-                int16_t step = (int16_t)((float)diff * WEATHER_ANIMATION_SPEED);
-                if (step == 0) step = (diff > 0) ? 1 : -1;
-                anim_offset = (int16_t)(anim_offset + step);
-            } else {
-                anim_offset = target_offset;
-                is_animating = 0;
-                swipe_dir = 0;
-            }
-        }
+    if (!full) {
+        MENU_RefreshOverlay(); // 卡片不变，只刷新状态小部件
+        return UI_SCREEN_IDLE;
+    }
 
-        /* 绘制界面 */
-        OLED_Clear();
+    OLED_Clear();
+    if (s_weather_count == 0) {
+        OLED_ShowString(10, 24, "No city data", OLED_6X8);
+    } else {
+        Weather_DrawCard(&s_weather_list[s_weather_idx], 0);
+        Weather_DrawIndicator(s_weather_idx, s_weather_count);
+    }
+    MENU_Display(); // 过渡已就绪时只画进显存，作为过渡终点
+    return UI_SCREEN_IDLE;
+}
 
-        if (s_weather_count == 0) {
-            OLED_ShowString(10, 24, "No city data", OLED_6X8);
-            OLED_Update();
-            osDelay(50);
-            continue;
-        }
+static void Weather_Input(void *ctx, const InputEvent *event)
+{
+    (void)ctx;
 
-        if (is_animating && swipe_dir != 0) {
-            /* current_idx 此时是新页面（to_idx） */
-            Weather_DrawCard(&s_weather_list[to_idx], anim_offset);
-
-            /* 旧页面（from_idx）滑出：根据方向放到相反侧 */
-            if (swipe_dir == -1) {
-                // 新从右进(128->0)，旧从中间滑到左侧(0->-128)
-                Weather_DrawCard(&s_weather_list[from_idx], (int16_t)(anim_offset - 128));
-            } else if (swipe_dir == 1) {
-                // 新从左进(-128->0)，旧从中间滑到右侧(0->128)
-                Weather_DrawCard(&s_weather_list[from_idx], (int16_t)(anim_offset + 128));
-            }
-        } else {
-            Weather_DrawCard(&s_weather_list[current_idx], 0);
-        }
+    if (event->type == INPUT_ENTER || event->type == INPUT_BACK) {
+        Transition_Cancel(); // 显存留下完整的当前卡片，菜单从它淡入
+        Screen_Pop();
+        return;
+    }
 
-        Weather_DrawIndicator(current_idx, s_weather_count);
-        OLED_Update();
-        osDelay(10); //
+    /* 旋转切换城市：屏上画面作为旧画面，新卡片只画一次，滑动由过渡合成（动画期间不响应） */
+    if (Transition_IsRunning() || s_weather_count <= 1) {
+        return;
     }
+    if (event->type == INPUT_DOWN) { // 顺时针 -> 下一个城市，新卡片从右边推入
+        Transition_Arm(UI_TRANSITION_PUSH, false);
+        s_weather_idx = (uint8_t)((s_weather_idx + 1) % s_weather_count); // 环形：最后一个也能到第一个
+        Screen_Invalidate();
+    } else if (event->type == INPUT_UP) { // 逆时针 -> 上一个城市，新卡片从左边推入
+        Transition_Arm(UI_TRANSITION_PUSH, true);
+        s_weather_idx = (uint8_t)((s_weather_idx + s_weather_count - 1) % s_weather_count); // 环形：第一个也能到最后一个
+        Screen_Invalidate();
+    }
+}
+
+static const UI_App Weather_App = {
+    .name = "weather",
+    .onEnter = Weather_Enter,
+    .onFrame = Weather_Frame,
+    .onInput = Weather_Input,
+    .transition = UI_TRANSITION_FADE,
+};
+
+void Weather_Open(void)
+{
+    Screen_Push(&Weather_App, NULL);
 }
 
 
@@ -0,0 +1,12 @@
+/*
+ * FreeRTOS.h (主机桩)
+ *
+ *  主机端只有一个线程，内核类型与配置都用不到；保留头文件供 input.c 包含。
+ */
+
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+#include <stdint.h>
+
+#endif /* HOST_FREERTOS_H */
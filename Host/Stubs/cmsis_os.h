@@ -0,0 +1,76 @@
+/*
+ * cmsis_os.h (主机桩)
+ *
+ *  主机端构建用的 CMSIS-RTOS2 子集。主机端只有一个线程：
+ *  osDelay / 带超时的阻塞读取不会真正睡眠，而是推进 host_port 的假时钟，
+ *  并回调 HostPort 的空闲钩子（由基准/回归程序注入输入或结束运行）。
+ */
+
+#ifndef HOST_CMSIS_OS_H
+#define HOST_CMSIS_OS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef enum
+{
+    osOK = 0,
+    osError = -1,
+    osErrorTimeout = -2,
+    osErrorResource = -3,
+    osErrorParameter = -4
+} osStatus_t;
+
+#define osWaitForever 0xFFFFFFFFU
+
+typedef struct HostMessageQueue *osMessageQueueId_t;
+
+typedef struct
+{
+    const char *name;
+} osMessageQueueAttr_t;
+
+osMessageQueueId_t osMessageQueueNew(uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t *attr);
+osStatus_t osMessageQueuePut(osMessageQueueId_t mq_id, const void *msg_ptr, uint8_t msg_prio, uint32_t timeout);
+osStatus_t osMessageQueueGet(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio, uint32_t timeout);
+uint32_t osMessageQueueGetCount(osMessageQueueId_t mq_id);
+osStatus_t osMessageQueueReset(osMessageQueueId_t mq_id);
+
+/* 事件标志：只实现查询/置位/清除，不支持阻塞等待 */
+#define osFlagsError 0x80000000U
+
+typedef struct HostEventFlags *osEventFlagsId_t;
+
+uint32_t osEventFlagsGet(osEventFlagsId_t ef_id);
+uint32_t osEventFlagsSet(osEventFlagsId_t ef_id, uint32_t flags);
+uint32_t osEventFlagsClear(osEventFlagsId_t ef_id, uint32_t flags);
+
+osStatus_t osDelay(uint32_t ticks);
+
+/* 线程：主机端没有 InputTask，线程标志只是空操作（输入层由回归程序的空闲钩子驱动） */
+typedef struct HostThread *osThreadId_t;
+
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags);
+
+/* 软件定时器：到点回调在推进假时钟时（osDelay、阻塞读取、HostPort_Advance）同步执行 */
+typedef void (*osTimerFunc_t)(void *argument);
+
+typedef enum
+{
+    osTimerOnce = 0,
+    osTimerPeriodic = 1
+} osTimerType_t;
+
+typedef struct HostTimer *osTimerId_t;
+
+typedef struct
+{
+    const char *name;
+} osTimerAttr_t;
+
+osTimerId_t osTimerNew(osTimerFunc_t func, osTimerType_t type, void *argument, const osTimerAttr_t *attr);
+osStatus_t osTimerStart(osTimerId_t timer_id, uint32_t ticks);
+osStatus_t osTimerStop(osTimerId_t timer_id);
+uint32_t osTimerIsRunning(osTimerId_t timer_id);
+
+#endif /* HOST_CMSIS_OS_H */
@@ -0,0 +1,130 @@
+/*
+ * stm32f4xx_hal.h (主机桩)
+ *
+ *  主机端构建用的最小 HAL 替身：只声明 Core/Src 中可移植模块
+ *  (OLED / MENU / weather / games / time_task / config_store / input) 用到的类型和函数，
+ *  实现在 Host/host_port.c 中。
+ */
+
+#ifndef HOST_STM32F4XX_HAL_H
+#define HOST_STM32F4XX_HAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef enum
+{
+    HAL_OK = 0x00U,
+    HAL_ERROR = 0x01U,
+    HAL_BUSY = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+typedef enum
+{
+    GPIO_PIN_RESET = 0,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+typedef struct
+{
+    uint32_t id;
+} GPIO_TypeDef;
+
+typedef struct
+{
+    uint32_t id;
+} SPI_HandleTypeDef;
+
+typedef struct
+{
+    uint32_t id;
+} TIM_HandleTypeDef;
+
+extern GPIO_TypeDef HostGPIOA, HostGPIOB, HostGPIOC;
+#define GPIOA (&HostGPIOA)
+#define GPIOB (&HostGPIOB)
+#define GPIOC (&HostGPIOC)
+
+#define GPIO_PIN_0   ((uint16_t)0x0001)
+#define GPIO_PIN_1   ((uint16_t)0x0002)
+#define GPIO_PIN_6   ((uint16_t)0x0040)
+#define GPIO_PIN_8   ((uint16_t)0x0100)
+#define GPIO_PIN_9   ((uint16_t)0x0200)
+#define GPIO_PIN_13  ((uint16_t)0x2000)
+
+#define HAL_MAX_DELAY 0xFFFFFFFFU
+
+/* 寄存器访问宏（与 CMSIS 相同） */
+#define SET_BIT(REG, BIT)     ((REG) |= (BIT))
+#define WRITE_REG(REG, VAL)   ((REG) = (VAL))
+#define MODIFY_REG(REG, CLEARMASK, SETMASK)  WRITE_REG((REG), (((REG) & (~(CLEARMASK))) | (SETMASK)))
+
+/* TIM5：32 位 1 MHz 自由运行计数（按下时刻捕获），CNT 由 host_port 随假时钟更新 */
+typedef struct
+{
+    volatile uint32_t CNT;
+} TIM_TypeDef;
+
+/* EXTI / SYSCFG：Input_Init 配置中断线，主机端只是普通变量；沿由 host_port 直接调用回调注入 */
+typedef struct
+{
+    volatile uint32_t MEMRMP;
+    volatile uint32_t PMC;
+    volatile uint32_t EXTICR[4];
+} SYSCFG_TypeDef;
+
+typedef struct
+{
+    volatile uint32_t IMR;
+    volatile uint32_t EMR;
+    volatile uint32_t RTSR;
+    volatile uint32_t FTSR;
+    volatile uint32_t SWIER;
+    volatile uint32_t PR;
+} EXTI_TypeDef;
+
+extern TIM_TypeDef HostTIM5;
+extern SYSCFG_TypeDef HostSYSCFG;
+extern EXTI_TypeDef HostEXTI;
+#define TIM5    (&HostTIM5)
+#define SYSCFG  (&HostSYSCFG)
+#define EXTI    (&HostEXTI)
+
+#define SYSCFG_EXTICR2_EXTI6        0x0F00U
+#define SYSCFG_EXTICR2_EXTI6_PB     0x0100U
+#define SYSCFG_EXTICR3_EXTI8        0x000FU
+#define SYSCFG_EXTICR3_EXTI9        0x00F0U
+#define SYSCFG_EXTICR3_EXTI8_PA     0x0000U
+#define SYSCFG_EXTICR3_EXTI9_PA     0x0000U
+
+#define EXTI_IMR_MR6    (1U << 6)
+#define EXTI_IMR_MR8    (1U << 8)
+#define EXTI_IMR_MR9    (1U << 9)
+#define EXTI_RTSR_TR6   (1U << 6)
+#define EXTI_RTSR_TR8   (1U << 8)
+#define EXTI_RTSR_TR9   (1U << 9)
+#define EXTI_FTSR_TR6   (1U << 6)
+#define EXTI_FTSR_TR8   (1U << 8)
+#define EXTI_FTSR_TR9   (1U << 9)
+#define EXTI_PR_PR6     (1U << 6)
+#define EXTI_PR_PR8     (1U << 8)
+#define EXTI_PR_PR9     (1U << 9)
+
+typedef enum
+{
+    EXTI9_5_IRQn = 23
+} IRQn_Type;
+
+#define __HAL_RCC_SYSCFG_CLK_ENABLE()   ((void)0)
+
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority);
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn);
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin);
+
+#endif /* HOST_STM32F4XX_HAL_H */
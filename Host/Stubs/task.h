@@ -0,0 +1,13 @@
+/*
+ * task.h (主机桩)
+ *
+ *  单线程、没有中断：临界区为空操作。
+ */
+
+#ifndef HOST_TASK_H
+#define HOST_TASK_H
+
+#define taskENTER_CRITICAL()    ((void)0)
+#define taskEXIT_CRITICAL()     ((void)0)
+
+#endif /* HOST_TASK_H */
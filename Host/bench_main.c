@@ -0,0 +1,556 @@
+/*
+ * bench_main.c
+ *
+ *  主机端渲染基准：在 Linux 上运行 OLED.c / MENU.c 的标准工作负载，
+ *  统计每次操作耗时 (ns/op)，重复多轮取 min/median/mean/stddev，
+ *  并可输出 JSON 以便逐提交对比回归。总线字节数 / 命令数 / 冗余数据字节由
+ *  SSD1306 模型 (ssd1306_emu) 统计，并校验面板内容与显存一致。
+ *
+ *  用法：bench [--json FILE] [--reps N] [--min-time-ms MS] [--filter SUBSTR]
+ */
+
+#include "host_port.h"
+#include "ssd1306_emu.h"
+#include "OLED.h"
+#include "OLED_Data.h"
+#include "MENU.h"
+#include "menu_tree.h"
+#include "time_task.h"
+#include "ui_overlay.h"
+#include "ui_transition.h"
+#include "ui_screen.h"
+#include "input.h"
+#include "input_queue.h"
+#include "input_replay.h"
+#include "cmsis_os.h"
+
+extern uint8_t OLED_DisplayBuf[8][128];
+extern osMessageQueueId_t InputEventQueueHandle;
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef BENCH_GIT_REV
+#define BENCH_GIT_REV "unknown"
+#endif
+
+#define BENCH_MAX_REPS      100
+#define BENCH_DEFAULT_REPS  15
+#define BENCH_FRAME_MS      10U   // 每帧推进的假时间，与菜单循环的 osDelay(10) 一致
+
+typedef struct
+{
+    const char *name;
+    const char *desc;
+    void (*setup)(void);
+    void (*run)(void);      // 执行一次操作
+} BenchCase;
+
+typedef struct
+{
+    uint64_t iterations;    // 每轮迭代次数
+    double ns_per_op[BENCH_MAX_REPS];
+    double min, median, mean, stddev;
+    double spi_bytes_per_op;
+    double cmd_bytes_per_op;        // 以下由 SSD1306 模型统计
+    double data_bytes_per_op;
+    double commands_per_op;
+    double redundant_bytes_per_op;  // 与 GDDRAM 原值相同、本可不发的数据字节
+    uint32_t protocol_errors;
+    bool panel_ok;                  // 最后一轮结束时面板 == OLED_DisplayBuf
+} BenchResult;
+
+static uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* ========= 工作负载：菜单 ========= */
+
+/* 主菜单与长菜单直接使用固件的页面表（menu_tree.h） */
+
+/* 附带变量的选项（设置类页面）：稳态帧数值不变，格式化结果应被缓存复用 */
+static uint16_t s_bound_u16 = 120;
+static int8_t s_bound_i8 = -5;
+static float s_bound_float = 23.5f;
+static char s_bound_str[] = "Online";
+
+#define BENCH_BOUND_ITEMS(ITEM, SUBMENU, VAR)   \
+    ITEM("<<<", NULL)                           \
+    VAR("Sleep:%us", &s_bound_u16, UINT16)      \
+    VAR("Offset:%d", &s_bound_i8, INT8)         \
+    VAR("Temp:%.1fC", &s_bound_float, FLOAT)    \
+    VAR("WiFi:%s", s_bound_str, STRING)
+
+MENU_PAGE_DEFINE_DYNAMIC(BenchBound, NULL, BENCH_BOUND_ITEMS);
+
+/* 超宽选中项：滚动字幕只在文本变化时光栅化，其余帧拷贝条带窗口 */
+#define BENCH_MARQUEE_ITEMS(ITEM, SUBMENU, VAR)                 \
+    ITEM("<<<", NULL)                                           \
+    ITEM("Weather: light rain, NW 12km/h", NULL)                \
+    ITEM("Short", NULL)
+
+MENU_PAGE_DEFINE_DYNAMIC(BenchMarquee, NULL, BENCH_MARQUEE_ITEMS);
+
+/* 虚拟列表：一万项只在绘制可见行时生成文本，单帧开销应与 15 项的长菜单相当 */
+#define BENCH_HUGE_ITEMS 10000U
+
+static uint16_t bench_huge_count(void *ctx)
+{
+    (void)ctx;
+    return BENCH_HUGE_ITEMS;
+}
+
+static const char *bench_huge_item(void *ctx, uint16_t index, char *buf)
+{
+    (void)ctx;
+    snprintf(buf, MENU_OPTION_TEXT_MAX, "Log #%05u", (unsigned)index);
+    return buf;
+}
+
+static const MENU_ListSource s_huge_source = {
+    .count = bench_huge_count,
+    .get_item = bench_huge_item,
+};
+
+MENU_PAGE_DEFINE_LIST(BenchHuge, NULL, &s_huge_source);
+
+static MENU_HandleTypeDef s_menu;
+static uint32_t s_frame_no;
+
+/* 与菜单页面 onFrame 的渲染部分一致 */
+static void bench_menu_render(MENU_HandleTypeDef *hMENU)
+{
+    MENU_Driver.clear();
+    MENU_ShowOptionList(hMENU);
+    MENU_ShowCursor(hMENU);
+    MENU_DrawScrollBar(hMENU);
+    MENU_Display();
+    HostPort_Advance(BENCH_FRAME_MS);
+}
+
+static void setup_menu_frame(void)
+{
+    MENU_HandleRelease(&s_menu);
+    memset(&s_menu, 0, sizeof(s_menu));
+    s_menu.Page = &MENU_Page_Main;
+    MENU_HandleInit(&s_menu);
+    s_frame_no = 0;
+}
+
+static void run_menu_frame(void)
+{
+    bench_menu_render(&s_menu);
+}
+
+static void setup_scroll(void)
+{
+    MENU_HandleRelease(&s_menu);
+    memset(&s_menu, 0, sizeof(s_menu));
+    s_menu.Page = &MENU_Page_TestLong;
+    MENU_HandleInit(&s_menu);
+    s_frame_no = 0;
+}
+
+static void run_scroll(void)
+{
+    /* 每 6 帧向下滚动一格（循环），其余帧播放光标/列表/滚动条动画 */
+    if ((s_frame_no++ % 6U) == 0U)
+    {
+        s_menu.Wheel_Event = 1;
+        MENU_UpdateIndex(&s_menu);
+        s_menu.AnimationUpdateEvent = 1;
+    }
+    bench_menu_render(&s_menu);
+}
+
+static void setup_bound_frame(void)
+{
+    MENU_HandleRelease(&s_menu);
+    memset(&s_menu, 0, sizeof(s_menu));
+    s_menu.Page = &MENU_Page_BenchBound;
+    MENU_HandleInit(&s_menu);
+    s_frame_no = 0;
+}
+
+static void run_bound_frame(void)
+{
+    /* 每 100 帧（约 1 s）改变一个数值，其余帧内容不变 */
+    if ((++s_frame_no % 100U) == 0U)
+    {
+        s_bound_u16++;
+    }
+    bench_menu_render(&s_menu);
+}
+
+static void setup_marquee(void)
+{
+    MENU_HandleRelease(&s_menu);
+    memset(&s_menu, 0, sizeof(s_menu));
+    s_menu.Page = &MENU_Page_BenchMarquee;
+    MENU_HandleInit(&s_menu);
+    s_frame_no = 0;
+}
+
+static void run_marquee(void)
+{
+    bench_menu_render(&s_menu);
+}
+
+static void setup_virtual_list(void)
+{
+    MENU_HandleRelease(&s_menu);
+    memset(&s_menu, 0, sizeof(s_menu));
+    s_menu.Page = &MENU_Page_BenchHuge;
+    MENU_HandleInit(&s_menu);
+    s_frame_no = 0;
+}
+
+static void run_virtual_list(void)
+{
+    /* 与 scroll_anim 相同的节奏，但每次跳 97 项，遍历整个列表 */
+    if ((s_frame_no++ % 6U) == 0U)
+    {
+        s_menu.Wheel_Event = 97;
+        MENU_UpdateIndex(&s_menu);
+        s_menu.AnimationUpdateEvent = 1;
+    }
+    bench_menu_render(&s_menu);
+}
+
+/* ========= 工作负载：绘图 ========= */
+
+static void setup_none(void)
+{
+}
+
+static void run_text_page(void)
+{
+    static char line[] = "The quick brown fox!";
+
+    OLED_Clear();
+    OLED_ShowString(0, 0, "Text Page 8x16", OLED_8X16);
+    for (int16_t y = 16; y < 64; y += 8)
+    {
+        line[0] = (char)('A' + (y / 8));
+        OLED_ShowString(0, y, line, OLED_6X8);
+    }
+    OLED_Printf(0, 56, OLED_6X8, "%3d%% %5lu", 42, 123456UL);
+    OLED_Update();
+}
+
+static void run_arcs_circles(void)
+{
+    OLED_Clear();
+    OLED_DrawCircle(20, 20, 18, OLED_UNFILLED);
+    OLED_DrawCircle(60, 20, 14, OLED_FILLED);
+    OLED_DrawEllipse(100, 20, 24, 12, OLED_UNFILLED);
+    OLED_DrawArc(30, 50, 12, -90, 90, OLED_UNFILLED);
+    OLED_DrawArc(80, 50, 12, 30, 150, OLED_FILLED);
+    OLED_Update();
+}
+
+static void run_image_blit(void)
+{
+    OLED_Clear();
+    /* 16x16 图像在非页对齐位置反复绘制，覆盖移位/裁剪路径 */
+    for (int16_t y = -4; y < 64; y += 13)
+    {
+        for (int16_t x = -6; x < 128; x += 19)
+        {
+            OLED_ShowImage(x, y, 16, 16, Diode);
+        }
+    }
+    OLED_Update();
+}
+
+static void run_full_update(void)
+{
+    OLED_Update();
+}
+
+static void run_area_update(void)
+{
+    /* 右上角 30x8 的小部件（如计时器）变化，只刷新它所在的区域 */
+    static uint32_t n;
+    OLED_ClearArea(90, 0, 30, 8);
+    OLED_Printf(90, 0, OLED_6X8, "%02lu:%02lu", (unsigned long)(n / 60 % 60), (unsigned long)(n % 60));
+    n++;
+    OLED_UpdateArea(90, 0, 30, 8);
+}
+
+static void setup_overlay_tick(void)
+{
+    /* 静态页面 + 运行中的倒计时：每秒只局部刷新覆盖层小部件 */
+    MENU_StartTimer(3600);
+    run_text_page();
+    MENU_UpdateOverlay();
+    Overlay_Present();
+}
+
+static void run_overlay_tick(void)
+{
+    HostPort_Advance(1000);
+    if (!MENU_TimerRunning())
+    {
+        MENU_StartTimer(3600);              // 倒计时走完后重新开始，保持每次操作都有跳秒
+    }
+    MENU_RefreshOverlay();
+}
+
+/* ========= 工作负载：屏幕过渡 ========= */
+
+static UI_TransitionKind s_transition_kind;
+
+/* 旧画面为文本页、新画面为图形页，各画一次存入离屏缓冲 */
+static void bench_transition_begin(void)
+{
+    run_text_page();
+    Transition_Arm(s_transition_kind, false);
+    run_arcs_circles();
+    Transition_Start(HostPort_Now());
+}
+
+static void setup_transition_push(void)
+{
+    s_transition_kind = UI_TRANSITION_PUSH;
+    bench_transition_begin();
+}
+
+static void setup_transition_fade(void)
+{
+    s_transition_kind = UI_TRANSITION_FADE;
+    bench_transition_begin();
+}
+
+static void run_transition(void)
+{
+    /* 每帧推进 10 ms；过渡结束后重画两张画面重新开始（这部分开销摊到 18 帧里） */
+    HostPort_Advance(10);
+    if (!Transition_Step(HostPort_Now()))
+    {
+        bench_transition_begin();
+    }
+    OLED_Update();
+}
+
+/* ========= 工作负载：输入回放 ========= */
+
+/* 回放结束后再运行一段，让最后一次返回的过渡与动画播放完 */
+#define BENCH_REPLAY_SETTLE_MS  1000U
+
+static uint32_t s_replay_done_ms;
+
+static void bench_replay_hook(uint32_t elapsed_ms)
+{
+    (void)elapsed_ms;
+    InputQueue_Flush();
+    InputReplay_Poll(HostPort_Now());
+    if (InputReplay_Playing())
+    {
+        s_replay_done_ms = HostPort_Now();
+    }
+    else if (HostPort_Now() - s_replay_done_ms >= BENCH_REPLAY_SETTLE_MS)
+    {
+        HostPort_Exit();
+    }
+}
+
+static void run_replay_session(void)
+{
+    /* 一次操作 = 完整回放一遍内置脚本（约 46 s 假时间）：主菜单帧循环、天气与贪吃蛇的独立循环都在内 */
+    InputEvent discard;
+
+    while (osMessageQueueGet(InputEventQueueHandle, &discard, NULL, 0) == osOK);
+    Screen_Reset();
+    OLED_Clear();
+    InputReplay_Play(g_InputReplaySession, g_InputReplaySessionLen);
+    s_replay_done_ms = HostPort_Now();
+    HostPort_SetIdleHook(bench_replay_hook);
+    HostPort_Run(MENU_RunMainMenu);
+    HostPort_SetIdleHook(NULL);
+    Screen_Reset();
+}
+
+static const BenchCase s_cases[] = {
+    {"menu_frame",    "main menu: clear + list + cursor + scrollbar + display", setup_menu_frame, run_menu_frame},
+    {"bound_frame",   "settings list with bound u16/i8/float/string values",   setup_bound_frame, run_bound_frame},
+    {"scroll_anim",   "15-item list scrolling one row every 6 frames",         setup_scroll,     run_scroll},
+    {"marquee",       "selected 30-char label scrolling as a marquee",         setup_marquee,    run_marquee},
+    {"virtual_list",  "10000-item virtual list jumping 97 rows every 6 frames", setup_virtual_list, run_virtual_list},
+    {"text_page",     "full page of 6x8/8x16 text + printf",                   setup_none,       run_text_page},
+    {"arcs_circles",  "circles, ellipse and arcs (filled/unfilled)",           setup_none,       run_arcs_circles},
+    {"image_blit",    "48 unaligned 16x16 image blits with clipping",          setup_none,       run_image_blit},
+    {"oled_update",   "full 1 KB framebuffer transfer",                        setup_none,       run_full_update},
+    {"area_update",   "30x8 widget redraw + OLED_UpdateArea",                  setup_none,       run_area_update},
+    {"overlay_tick",  "countdown tick on a static page via overlay refresh",  setup_overlay_tick, run_overlay_tick},
+    {"transition_push", "push transition frame composed from two cached screens", setup_transition_push, run_transition},
+    {"transition_fade", "ordered-dither fade frame composed from two cached screens", setup_transition_fade, run_transition},
+    {"replay_session", "scripted session: test menu, weather cards, 30 s of snake", setup_none, run_replay_session},
+};
+
+/* ========= 统计 ========= */
+
+static int cmp_double(const void *a, const void *b)
+{
+    double da = *(const double *)a, db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+static void bench_run_case(const BenchCase *c, int reps, double min_time_ms, BenchResult *r)
+{
+    memset(r, 0, sizeof(*r));
+
+    /* 预热 + 标定：迭代次数翻倍直到单轮耗时 >= min_time_ms */
+    c->setup();
+    uint64_t iters = 1;
+    for (;;)
+    {
+        uint64_t t0 = bench_now_ns();
+        for (uint64_t i = 0; i < iters; i++) c->run();
+        double ms = (double)(bench_now_ns() - t0) / 1e6;
+        if (ms >= min_time_ms || iters >= (1ULL << 30)) break;
+        iters *= 2;
+    }
+    r->iterations = iters;
+
+    HostSpiStats spi_total = {0};
+    SSD1306Emu_Stats bus_total = {0};
+    for (int rep = 0; rep < reps; rep++)
+    {
+        c->setup();
+        HostPort_ResetSpiStats();
+        SSD1306Emu_ResetStats();
+        uint64_t t0 = bench_now_ns();
+        for (uint64_t i = 0; i < iters; i++) c->run();
+        uint64_t dt = bench_now_ns() - t0;
+        HostSpiStats s = HostPort_GetSpiStats();
+        SSD1306Emu_Stats b = SSD1306Emu_GetStats();
+        spi_total.cmd_bytes += s.cmd_bytes;
+        spi_total.data_bytes += s.data_bytes;
+        bus_total.cmd_bytes += b.cmd_bytes;
+        bus_total.data_bytes += b.data_bytes;
+        bus_total.commands += b.commands;
+        bus_total.redundant_bytes += b.redundant_bytes;
+        bus_total.protocol_errors += b.protocol_errors;
+        r->ns_per_op[rep] = (double)dt / (double)iters;
+    }
+
+    uint8_t panel[SSD1306_EMU_PAGES][SSD1306_EMU_WIDTH];
+    SSD1306Emu_RenderPanel(panel);
+    r->panel_ok = (memcmp(panel, OLED_DisplayBuf, sizeof(panel)) == 0);
+    if (!r->panel_ok)
+    {
+        /* 菜单帧：显存叠加覆盖层小部件后应与面板一致 */
+        uint8_t composed[SSD1306_EMU_PAGES][SSD1306_EMU_WIDTH];
+        memcpy(composed, OLED_DisplayBuf, sizeof(composed));
+        for (uint8_t page = 0; page < SSD1306_EMU_PAGES; page++) Overlay_Compose(page, composed[page]);
+        r->panel_ok = (memcmp(panel, composed, sizeof(panel)) == 0);
+    }
+
+    double sorted[BENCH_MAX_REPS];
+    memcpy(sorted, r->ns_per_op, sizeof(double) * (size_t)reps);
+    qsort(sorted, (size_t)reps, sizeof(double), cmp_double);
+
+    double sum = 0.0;
+    for (int i = 0; i < reps; i++) sum += sorted[i];
+    r->mean = sum / reps;
+    double var = 0.0;
+    for (int i = 0; i < reps; i++) var += (sorted[i] - r->mean) * (sorted[i] - r->mean);
+    r->stddev = (reps > 1) ? sqrt(var / (reps - 1)) : 0.0;
+    r->min = sorted[0];
+    r->median = (reps % 2) ? sorted[reps / 2] : (sorted[reps / 2 - 1] + sorted[reps / 2]) / 2.0;
+    double ops = (double)iters * reps;
+    r->spi_bytes_per_op = (double)(spi_total.cmd_bytes + spi_total.data_bytes) / ops;
+    r->cmd_bytes_per_op = (double)bus_total.cmd_bytes / ops;
+    r->data_bytes_per_op = (double)bus_total.data_bytes / ops;
+    r->commands_per_op = (double)bus_total.commands / ops;
+    r->redundant_bytes_per_op = (double)bus_total.redundant_bytes / ops;
+    r->protocol_errors = bus_total.protocol_errors;
+}
+
+static void bench_write_json(FILE *f, int reps, const BenchResult *results, const int *selected, size_t n)
+{
+    fprintf(f, "{\n  \"suite\": \"oled_ui_host_bench\",\n");
+    fprintf(f, "  \"commit\": \"%s\",\n", BENCH_GIT_REV);
+    fprintf(f, "  \"repetitions\": %d,\n  \"results\": [", reps);
+    int first = 1;
+    for (size_t i = 0; i < n; i++)
+    {
+        if (!selected[i]) continue;
+        const BenchResult *r = &results[i];
+        fprintf(f, "%s\n    {\"name\": \"%s\", \"iterations\": %llu, "
+                   "\"ns_per_op\": {\"min\": %.1f, \"median\": %.1f, \"mean\": %.1f, \"stddev\": %.1f}, "
+                   "\"spi_bytes_per_op\": %.1f, "
+                   "\"bus\": {\"cmd_bytes\": %.1f, \"data_bytes\": %.1f, \"commands\": %.1f, "
+                   "\"redundant_data_bytes\": %.1f, \"protocol_errors\": %u, \"panel_matches_framebuffer\": %s}}",
+                first ? "" : ",", s_cases[i].name, (unsigned long long)r->iterations,
+                r->min, r->median, r->mean, r->stddev, r->spi_bytes_per_op,
+                r->cmd_bytes_per_op, r->data_bytes_per_op, r->commands_per_op,
+                r->redundant_bytes_per_op, (unsigned)r->protocol_errors, r->panel_ok ? "true" : "false");
+        first = 0;
+    }
+    fprintf(f, "\n  ]\n}\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *json_path = NULL;
+    const char *filter = NULL;
+    int reps = BENCH_DEFAULT_REPS;
+    double min_time_ms = 20.0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--json") && i + 1 < argc) json_path = argv[++i];
+        else if (!strcmp(argv[i], "--reps") && i + 1 < argc) reps = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--min-time-ms") && i + 1 < argc) min_time_ms = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--filter") && i + 1 < argc) filter = argv[++i];
+        else
+        {
+            fprintf(stderr, "usage: %s [--json FILE] [--reps N] [--min-time-ms MS] [--filter SUBSTR]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (reps < 1) reps = 1;
+    if (reps > BENCH_MAX_REPS) reps = BENCH_MAX_REPS;
+
+    HostPort_Init();
+    TimerSvc_Init();
+    OLED_Init();
+
+    const size_t n = sizeof(s_cases) / sizeof(s_cases[0]);
+    BenchResult results[sizeof(s_cases) / sizeof(s_cases[0])];
+    int selected[sizeof(s_cases) / sizeof(s_cases[0])];
+
+    printf("%-14s %12s %12s %12s %10s %10s %8s %10s %s\n", "workload", "min ns", "median ns", "mean ns",
+           "stddev", "spi B/op", "cmd/op", "redund B", "panel");
+    for (size_t i = 0; i < n; i++)
+    {
+        selected[i] = (filter == NULL) || (strstr(s_cases[i].name, filter) != NULL);
+        if (!selected[i]) continue;
+        bench_run_case(&s_cases[i], reps, min_time_ms, &results[i]);
+        printf("%-14s %12.1f %12.1f %12.1f %10.1f %10.1f %8.1f %10.1f %s\n", s_cases[i].name, results[i].min,
+               results[i].median, results[i].mean, results[i].stddev, results[i].spi_bytes_per_op,
+               results[i].commands_per_op, results[i].redundant_bytes_per_op,
+               results[i].protocol_errors ? "proto-err" : (results[i].panel_ok ? "ok" : "MISMATCH"));
+    }
+
+    if (json_path)
+    {
+        FILE *f = fopen(json_path, "w");
+        if (!f)
+        {
+            perror(json_path);
+            return 1;
+        }
+        bench_write_json(f, reps, results, selected, n);
+        fclose(f);
+    }
+    return 0;
+}
@@ -0,0 +1,995 @@
+/*
+ * golden_main.c
+ *
+ *  主机端界面回归：用假时钟 + 脚本化输入确定性地驱动各个界面
+ *  （菜单、信息页、定时器、天气、时钟、贪吃蛇、恐龙），在脚本指定的时刻
+ *  截取 SSD1306 模型 (ssd1306_emu) 重建的面板图像，与 Host/golden/ 下 128x64 的
+ *  PBM 基准图逐像素比较。同时校验面板与 OLED_DisplayBuf（菜单帧叠加覆盖层小部件）一致、
+ *  且总线上没有协议错误；QUIET 步骤断言一段时间内总线静默（如息屏期间）。
+ *  不一致时在 build/golden-out/ 输出实际图像 (.actual.pbm) 与放大的差异图 (.diff.ppm)：
+ *  黑=两者都亮，红=仅基准亮，绿=仅实际亮。
+ *
+ *  用法：golden [--update] [--golden-dir DIR] [--out-dir DIR]
+ */
+
+#include "host_port.h"
+#include "ssd1306_emu.h"
+#include "OLED.h"
+#include "MENU.h"
+#include "ui_overlay.h"
+#include "ui_screen.h"
+#include "ui_popup.h"
+#include "input.h"
+#include "input_accel.h"
+#include "input_queue.h"
+#include "input_replay.h"
+#include "time_task.h"
+#include "stopwatch.h"
+#include "weather.h"
+#include "Game_Snake.h"
+#include "Game_Dino.h"
+#include "cmsis_os.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern uint8_t OLED_DisplayBuf[8][128];
+extern osMessageQueueId_t InputEventQueueHandle;
+extern osMessageQueueId_t TimeQueueHandle;
+
+#define GOLDEN_W            128
+#define GOLDEN_H            64
+#define GOLDEN_DIFF_SCALE   4
+#define GOLDEN_SCENARIO_MS  100000U   // 每个场景从整 100 s 开始，互不影响随机种子等时间相关状态
+
+typedef enum
+{
+    STEP_INPUT,     // 向输入队列投递事件（经 InputQueue_Post，与 InputTask 相同）
+    STEP_SPIN,      // 投递旋转事件，经输入层的转速估计与加速曲线（与 InputTask 相同）
+    STEP_SNAPSHOT,  // 截取显存并比较/更新基准图
+    STEP_TIME,      // 向时间队列投递一条 SNTP 时间
+    STEP_QUIET,     // 断言自上一次快照/断言以来总线上没有任何字节
+    STEP_KEY,       // 按键原始沿（EXTI6，含抖动沿），经消抖与手势识别产生事件
+    STEP_TURN,      // 编码器转动（原始格数），经手势识别产生旋转事件
+    STEP_GOT,       // 断言输入层识别出的下一个事件（INPUT_NONE 表示没有未检查的事件）
+    STEP_QUEUE,     // 断言本场景开始以来的投递统计（入队/合并/溢出/丢弃）
+    STEP_END        // 场景结束
+} GoldenStepKind;
+
+typedef struct
+{
+    uint32_t at_ms;         // 相对场景开始的假时间
+    GoldenStepKind kind;
+    InputType input;
+    int16_t value;
+    const char *name;       // 快照名（对应 golden/<name>.pbm）
+    const InputQueueStats *queue;   // STEP_QUEUE 的期望值（max_depth 不比较）
+    uint8_t mods;           // STEP_GOT：期望的 INPUT_MOD_xxx
+    uint32_t event_ms;      // STEP_GOT：期望的事件时刻（相对场景开始）
+} GoldenStep;
+
+typedef struct
+{
+    const char *name;
+    void (*entry)(void);
+    const GoldenStep *steps;
+} GoldenScenario;
+
+#define IN(t, type, v)  {.at_ms = (t), .kind = STEP_INPUT, .input = (type), .value = (v)}
+#define SPIN(t, type, v) {.at_ms = (t), .kind = STEP_SPIN, .input = (type), .value = (v)}
+#define SNAP(t, n)      {.at_ms = (t), .kind = STEP_SNAPSHOT, .name = (n)}
+#define TIME(t)         {.at_ms = (t), .kind = STEP_TIME}
+#define QUIET(t, n)     {.at_ms = (t), .kind = STEP_QUIET, .name = (n)}
+#define KEY(t, down)    {.at_ms = (t), .kind = STEP_KEY, .value = (down)}
+#define TURN(t, detents) {.at_ms = (t), .kind = STEP_TURN, .value = (detents)}
+#define GOT(t, type, v, m, at) {.at_ms = (t), .kind = STEP_GOT, .input = (type), .value = (v), .mods = (m), .event_ms = (at)}
+#define GOT_NONE(t)     {.at_ms = (t), .kind = STEP_GOT, .input = INPUT_NONE}
+#define END(t)          {.at_ms = (t), .kind = STEP_END}
+#define QUEUE(t, n, p, c, o, d) {.at_ms = (t), .kind = STEP_QUEUE, .name = (n), .queue = &(const InputQueueStats){ \
+                            .posted = (p), .coalesced = (c), .overflows = (o), .dropped = (d)}}
+
+/* ========= 场景脚本 ========= */
+
+static const GoldenStep s_menu_steps[] = {
+    SNAP(400, "main_menu"),             // 初始选中 Tools
+    IN(410, INPUT_DOWN, 2),
+    SNAP(800, "main_menu_setting"),     // 选中 Setting
+    IN(810, INPUT_ENTER, 1),
+    SNAP(1200, "setting_menu"),
+    IN(1210, INPUT_BACK, 2),
+    IN(1300, INPUT_UP, 1),
+    IN(1400, INPUT_ENTER, 1),           // -> Games
+    SNAP(1800, "games_menu"),
+    IN(1810, INPUT_BACK, 2),
+    IN(1900, INPUT_UP, 1),
+    IN(2000, INPUT_ENTER, 1),           // -> Tools
+    IN(2100, INPUT_DOWN, 9),
+    SNAP(2500, "tools_menu_scrolled"),
+    IN(2510, INPUT_UP, 9),
+    IN(2900, INPUT_ENTER, 1),           // -> Timer
+    IN(3000, INPUT_DOWN, 1),
+    SNAP(3400, "timer_setting"),
+    IN(3410, INPUT_BACK, 2),
+    IN(3500, INPUT_BACK, 2),            // 回到主菜单（仍选中 Tools）
+    IN(3600, INPUT_DOWN, 3),
+    IN(4000, INPUT_ENTER, 1),           // -> Information
+    SNAP(4200, "information"),
+    IN(4210, INPUT_ENTER, 1),
+    IN(4300, INPUT_DOWN, 1),
+    IN(4700, INPUT_ENTER, 1),           // -> Test Menu
+    IN(4800, INPUT_DOWN, 7),
+    SNAP(5200, "test_long_menu"),
+    END(5300),
+};
+
+/* 启动倒计时后停在静态信息页：倒计时只经覆盖层局部刷新 */
+static const GoldenStep s_timer_overlay_steps[] = {
+    IN(100, INPUT_ENTER, 1),            // -> Tools
+    IN(500, INPUT_ENTER, 1),            // -> Timer（保留 menu 场景的选中项 Start Timer）
+    IN(1300, INPUT_ENTER, 1),           // Start Timer (60 s)
+    IN(1400, INPUT_BACK, 2),
+    IN(1500, INPUT_BACK, 2),
+    IN(1600, INPUT_DOWN, 3),
+    IN(2000, INPUT_ENTER, 1),           // -> Information
+    SNAP(2300, "information_timer"),
+    SNAP(3300, "information_timer_tick"),
+    IN(3310, INPUT_BACK, 2),
+    SNAP(3700, "main_menu_timer"),
+    END(3800),
+};
+
+static const GoldenStep s_weather_steps[] = {
+    SNAP(300, "weather_card0"),
+    IN(310, INPUT_DOWN, 1),
+    SNAP(900, "weather_card1"),
+    IN(910, INPUT_UP, 1),
+    IN(1500, INPUT_UP, 1),
+    SNAP(2100, "weather_card_last"),
+    END(2200),
+};
+
+static const GoldenStep s_clock_steps[] = {
+    SNAP(50, "clock_syncing"),
+    TIME(60),
+    SNAP(100, "clock"),
+    END(200),
+};
+
+static const GoldenStep s_snake_steps[] = {
+    SNAP(1500, "snake_1500ms"),
+    IN(1510, INPUT_DOWN, 1),
+    SNAP(3000, "snake_3000ms"),
+    END(3100),
+};
+
+static const GoldenStep s_dino_steps[] = {
+    SNAP(100, "dino_title"),
+    IN(110, INPUT_ENTER, 1),
+    SNAP(1000, "dino_running"),
+    IN(1010, INPUT_UP, 1),
+    SNAP(1330, "dino_jump"),
+    END(1400),
+};
+
+/* 自动息屏：120 s 无输入后面板关闭且总线静默，任意输入唤醒并恢复原画面（唤醒事件被丢弃） */
+static const GoldenStep s_sleep_steps[] = {
+    SNAP(400, "sleep_awake"),
+    QUIET(900, "idle_menu_quiet"),      // 动画静止后菜单阻塞等待输入，不再逐帧重发
+    SNAP(121000, "sleep_panel_off"),
+    QUIET(180000, "sleep_bus_quiet"),
+    IN(180000, INPUT_DOWN, 1),
+    SNAP(180400, "sleep_wake"),         // 选中项不变
+    END(180500),
+};
+
+/* 设置页面控件：滑块、数值微调（快速旋转加速）、开关、文本页；数值变化只局部刷新 */
+static const GoldenStep s_settings_steps[] = {
+    IN(100, INPUT_DOWN, 2),
+    IN(500, INPUT_ENTER, 1),            // -> Setting
+    IN(900, INPUT_ENTER, 1),            // -> Display（滑块）
+    SNAP(1200, "display_slider"),       // 过渡结束后
+    IN(1210, INPUT_DOWN, 2),            // +10%
+    SNAP(1300, "display_slider_up"),
+    IN(1310, INPUT_BACK, 2),
+    IN(1700, INPUT_DOWN, 1),
+    IN(2100, INPUT_ENTER, 1),           // -> Sleep（数值微调）
+    SPIN(2400, INPUT_DOWN, 1),
+    SPIN(2450, INPUT_DOWN, 1),
+    SPIN(2500, INPUT_DOWN, 1),
+    SPIN(2550, INPUT_DOWN, 1),
+    SPIN(2600, INPUT_DOWN, 1),          // 连续快速旋转（20 格/秒）：5 + 20 + 20 + 20 + 20 秒
+    SNAP(2700, "sleep_spinner_fast"),
+    IN(2710, INPUT_BACK, 2),
+    IN(3100, INPUT_DOWN, 1),
+    IN(3500, INPUT_ENTER, 1),           // -> System（开关）
+    IN(3800, INPUT_UP, 1),
+    SNAP(3900, "system_toggle_off"),
+    IN(3910, INPUT_DOWN, 1),            // 恢复关闭前的时长
+    IN(3920, INPUT_BACK, 2),
+    IN(4300, INPUT_DOWN, 1),
+    IN(4700, INPUT_ENTER, 1),           // -> About（文本页）
+    SNAP(5000, "about_page"),
+    END(5100),
+};
+
+/* 弹窗层：提示条自动消失；倒计时到点弹出模态框，闪烁结束后总线静默，任意输入确认且不传给菜单 */
+static const GoldenStep s_popup_steps[] = {
+    SNAP(100, "popup_toast_slide"),     // 从底部滑入途中
+    SNAP(400, "popup_toast"),
+    SNAP(1200, "popup_toast_gone"),
+    SNAP(2400, "popup_modal"),
+    SNAP(2500, "popup_modal_blink"),
+    SNAP(3500, "popup_modal_settled"),  // 闪烁结束
+    QUIET(4000, "popup_modal_quiet"),   // 静止的模态框不再刷新
+    IN(4010, INPUT_DOWN, 1),            // 确认弹窗，选中项不变
+    SNAP(4300, "popup_dismissed"),
+    END(4400),
+};
+
+/* 屏幕过渡：过渡中途的画面由两张离屏画面合成（菜单页推入、设置页盖上、天气卡片推入、天气返回菜单淡入） */
+static const GoldenStep s_transition_steps[] = {
+    IN(400, INPUT_ENTER, 1),            // -> Tools
+    SNAP(460, "transition_push"),
+    IN(900, INPUT_BACK, 2),
+    SNAP(960, "transition_push_back"),
+    IN(1300, INPUT_DOWN, 2),
+    IN(1700, INPUT_ENTER, 1),           // -> Setting
+    IN(2100, INPUT_ENTER, 1),           // -> Display（滑块）
+    SNAP(2160, "transition_slide"),
+    IN(2500, INPUT_BACK, 2),
+    SNAP(2560, "transition_slide_back"),
+    IN(2900, INPUT_BACK, 2),
+    IN(3300, INPUT_DOWN, 3),
+    IN(3700, INPUT_ENTER, 1),           // -> Weather（淡入）
+    IN(4000, INPUT_DOWN, 1),
+    SNAP(4060, "transition_weather"),
+    IN(4400, INPUT_ENTER, 1),           // 返回菜单
+    SNAP(4460, "transition_fade"),
+    END(4600),
+};
+
+/* 旋钮加速与惯性滚动：快速拨动一次跨多项，停手后列表减速滑行；之后慢转仍逐项 */
+static const GoldenStep s_fling_steps[] = {
+    IN(400, INPUT_ENTER, 1),            // -> Tools
+    SPIN(800, INPUT_DOWN, 1),           // 起步：1 项
+    SPIN(850, INPUT_DOWN, 1),           // 20 格/秒：4 项
+    SNAP(900, "fling_spin"),
+    SNAP(1600, "fling_settled"),        // 停手后滑行并停下
+    SPIN(2000, INPUT_DOWN, 1),
+    SNAP(2400, "fling_single_step"),
+    END(2500),
+};
+
+/* 两个计时同时运行：带名称的 1 s 提醒先到点，倒计时 3 s 到点时再弹出"时间到" */
+static const GoldenStep s_timers_steps[] = {
+    SNAP(900, "timers_running"),        // 右上角只显示倒计时
+    SNAP(2400, "timers_label"),         // 提醒到点：以名称弹窗
+    IN(2500, INPUT_ENTER, 1),           // 确认（被弹窗吞掉）
+    SNAP(4400, "timers_timeup"),
+    END(4500),
+};
+
+/* 秒表：开始与计次取按下沿的时刻，与松开消抖后才产生的短按事件无关；暂停后翻看计次 */
+static const GoldenStep s_stopwatch_steps[] = {
+    SNAP(300, "stopwatch_zero"),
+    KEY(1000, 1),
+    KEY(1150, 0),                       // 从 1000 ms 开始计时
+    GOT(1200, INPUT_ENTER, 1, 0, 1150),
+    SNAP(1800, "stopwatch_running"),
+    KEY(2234, 1),
+    KEY(2384, 0), KEY(2400, 1), KEY(2410, 0),   // 松开抖动：抖动的下降沿不能覆盖按下时刻
+    GOT(2500, INPUT_ENTER, 1, 0, 2410),  // 计次 1：1.234 s
+    KEY(3500, 1),
+    KEY(3650, 0),                       // 计次 2：1.266 s
+    KEY(3800, 1),
+    KEY(3950, 0),                       // 计次 3：0.300 s
+    IN(4000, INPUT_DOWN, 1),            // 暂停：3.000 s
+    SNAP(4100, "stopwatch_paused"),
+    IN(4110, INPUT_DOWN, 1),            // 翻看更早的计次
+    SNAP(4200, "stopwatch_laps_scrolled"),
+    END(4300),
+};
+
+/* 输入突发：同一时刻 17 格旋转（超过 16 格队列）：第一格立即入队，其余 16 格在界面取走之前
+   合并在尾槽（15 次合并），排空后作为一个事件送出，从 Timer 下移 17 项停在 Input Record；
+   队列满即丢弃时只有 16 格到达，会停在 Memory Test */
+static const GoldenStep s_input_burst_steps[] = {
+    IN(400, INPUT_ENTER, 1),            // -> Tools
+    SNAP(800, "input_burst_before"),
+    IN(1000, INPUT_DOWN, 1), IN(1000, INPUT_DOWN, 1), IN(1000, INPUT_DOWN, 1), IN(1000, INPUT_DOWN, 1),
+    IN(1000, INPUT_DOWN, 1), IN(1000, INPUT_DOWN, 1), IN(1000, INPUT_DOWN, 1), IN(1000, INPUT_DOWN, 1),
+    IN(1000, INPUT_DOWN, 1), IN(1000, INPUT_DOWN, 1), IN(1000, INPUT_DOWN, 1), IN(1000, INPUT_DOWN, 1),
+    IN(1000, INPUT_DOWN, 1), IN(1000, INPUT_DOWN, 1), IN(1000, INPUT_DOWN, 1), IN(1000, INPUT_DOWN, 1),
+    IN(1000, INPUT_DOWN, 1),
+    SNAP(1800, "input_burst_after"),    // 选中 Input Record
+    QUEUE(1800, "input_burst_queue", 3, 15, 0, 0),  // ENTER + 第一格 + 合并后的 16 格
+    END(1900),
+};
+
+/* 背压：同一时刻 20 个交替换向的旋转（下 2、上 1，不能合并）。前 16 个填满队列，
+   之后每次投递都先溢出再阻塞到界面取走一个，一个不丢：从 Timer 净下移 10 项停在 GPIO Control；
+   队列满即丢弃时最后 4 个（净 2 项）丢失，会停在 SPI Test */
+static const GoldenStep s_input_backpressure_steps[] = {
+    IN(400, INPUT_ENTER, 1),            // -> Tools
+    IN(1000, INPUT_DOWN, 2), IN(1000, INPUT_UP, 1), IN(1000, INPUT_DOWN, 2), IN(1000, INPUT_UP, 1),
+    IN(1000, INPUT_DOWN, 2), IN(1000, INPUT_UP, 1), IN(1000, INPUT_DOWN, 2), IN(1000, INPUT_UP, 1),
+    IN(1000, INPUT_DOWN, 2), IN(1000, INPUT_UP, 1), IN(1000, INPUT_DOWN, 2), IN(1000, INPUT_UP, 1),
+    IN(1000, INPUT_DOWN, 2), IN(1000, INPUT_UP, 1), IN(1000, INPUT_DOWN, 2), IN(1000, INPUT_UP, 1),
+    IN(1000, INPUT_DOWN, 2), IN(1000, INPUT_UP, 1), IN(1000, INPUT_DOWN, 2), IN(1000, INPUT_UP, 1),
+    SNAP(1800, "input_backpressure"),   // 选中 GPIO Control
+    QUEUE(1800, "input_backpressure_queue", 21, 0, 3, 0),   // 第 18~20 个投递时队列已满
+    END(1900),
+};
+
+/* 到点与息屏同时发生、定时器回调推迟 20 ms：息屏判定看到剩余 0 时不能无限期睡下去，提示照常弹出 */
+static const GoldenStep s_timer_race_steps[] = {
+    SNAP(119900, "timer_race_before"),  // 倒计时最后一秒
+    SNAP(120400, "timer_race_alert"),   // 面板亮着并弹出"时间到"
+    IN(120410, INPUT_ENTER, 1),         // 确认，后面的场景从空的弹窗层开始
+    END(121000),
+};
+
+/* 按住旋转：滑块使能该手势，按住时每格按 INPUT_HELD_GAIN 倍步数调整，松开不退出 */
+static const GoldenStep s_held_rotate_steps[] = {
+    IN(100, INPUT_DOWN, 2),
+    IN(500, INPUT_ENTER, 1),            // -> Setting
+    IN(900, INPUT_ENTER, 1),            // -> Display（滑块）
+    SNAP(1200, "held_slider"),
+    KEY(1200, 1),
+    TURN(1230, 1),                      // 一格 = 10 步
+    SNAP(1300, "held_slider_fast"),
+    TURN(1310, -1),                     // 恢复
+    KEY(1320, 0),                       // 松开不产生 ENTER（不退出）
+    GOT(1350, INPUT_DOWN, 1, INPUT_MOD_HELD, 1230),
+    GOT(1350, INPUT_UP, 1, INPUT_MOD_HELD, 1310),
+    GOT_NONE(1350),
+    IN(1360, INPUT_BACK, 2),
+    END(1700),
+};
+
+/* 输入回放：Tools -> Input Replay 回放内置脚本（测试长菜单、天气、贪吃蛇），脚本按时刻自行驱动界面 */
+static const GoldenStep s_replay_steps[] = {
+    IN(400, INPUT_ENTER, 1),            // -> Tools
+    IN(800, INPUT_DOWN, 18),            // -> Input Replay
+    IN(1200, INPUT_ENTER, 1),           // 回到主菜单并开始回放（t = 0）
+    SNAP(7400, "replay_test_menu"),     // 滚动 40 格（停在第 13 项）
+    SNAP(13800, "replay_weather"),      // 翻过 5 张卡片
+    SNAP(30000, "replay_snake"),        // 贪吃蛇进行中
+    SNAP(47500, "replay_done"),         // 退出游戏回到主菜单（停在 Games）
+    END(47600),
+};
+
+/* 滚动字幕：选中项比可视窗口（120 px）宽，停顿 1 s 后以 30 px/s 左移，移过文本宽度加间隔（272 px）后首尾相接 */
+static const GoldenStep s_marquee_steps[] = {
+    SNAP(500, "marquee_pause"),         // 停顿：从文本开头显示
+    SNAP(3000, "marquee_scroll"),       // 已左移 60 px
+    SNAP(9500, "marquee_wrap"),         // 左移 255 px：文本末尾与从右边进入的第二份拷贝同屏
+    SNAP(10500, "marquee_restart"),     // 一轮（约 10.07 s）结束后回到开头再次停顿
+    IN(10510, INPUT_DOWN, 1),
+    SNAP(10900, "marquee_short"),       // 选中短选项：不滚动
+    END(11000),
+};
+
+/* 长时间静止后开始的动画：菜单阻塞等待期间动画时钟不走，光标补间从输入后的第一帧计时，
+   第一帧不会把空闲的间隔（最多 UI_ANIM_MAX_STEP_MS）算进去 */
+static const GoldenStep s_anim_idle_steps[] = {
+    SNAP(400, "anim_idle_before"),
+    IN(5000, INPUT_DOWN, 1),
+    SNAP(5030, "anim_idle_tween"),      // 补间途中（从取到输入的那一帧起计时）
+    SNAP(5400, "anim_idle_settled"),
+    END(5500),
+};
+
+/* 手势识别（双击、按住旋转使能）：原始沿与超时经消抖和规则表，检查识别出的事件与时刻
+   （按键事件的时刻是消抖前最后一个沿，长按是到达阈值的时刻） */
+static const GoldenStep s_gesture_steps[] = {
+    KEY(100, 1), KEY(180, 0),           // 单击：松开即产生 ENTER，不为等双击而延迟
+    GOT(210, INPUT_ENTER, 1, 0, 180),
+    GOT_NONE(500),                      // 双击窗口到期，没有事件
+    KEY(600, 1), KEY(610, 0), KEY(620, 1),  // 按下与松开都带抖动：只产生一次 ENTER
+    KEY(700, 0), KEY(710, 1), KEY(720, 0),
+    GOT(800, INPUT_ENTER, 1, 0, 720),
+    GOT_NONE(800),
+    KEY(1100, 1), KEY(1150, 0), KEY(1250, 1), KEY(1300, 0), // 双击：第一次 ENTER，第二次 DOUBLE
+    GOT(1400, INPUT_ENTER, 1, 0, 1150),
+    GOT(1400, INPUT_DOUBLE, 1, 0, 1300),
+    GOT_NONE(1400),
+    KEY(1600, 1), KEY(1650, 0), KEY(2000, 1), KEY(2050, 0), // 第二次按下晚于 INPUT_DOUBLE_MS：两次单击
+    GOT(2100, INPUT_ENTER, 1, 0, 1650),
+    GOT(2100, INPUT_ENTER, 1, 0, 2050),
+    GOT_NONE(2100),
+    KEY(2500, 1),                       // 长按：按下 INPUT_LONG_MS 时产生 BACK，松开没有事件
+    GOT_NONE(3250),
+    GOT(3350, INPUT_BACK, 2, 0, 3300),
+    KEY(3600, 0),
+    GOT_NONE(3700),
+    KEY(4000, 1), TURN(4100, 1), TURN(4200, -2), KEY(4400, 0),  // 按住旋转：带 INPUT_MOD_HELD，松开不产生 ENTER
+    GOT(4500, INPUT_DOWN, 1, INPUT_MOD_HELD, 4100),
+    GOT(4500, INPUT_UP, 2, INPUT_MOD_HELD, 4200),
+    GOT_NONE(5000),                     // 也不会在 4800 ms 产生长按
+    TURN(5100, 3),                      // 松开后的旋转不带修饰
+    GOT(5200, INPUT_DOWN, 3, 0, 5100),
+    END(5300),
+};
+
+/* 手势识别（连发使能）：按住 INPUT_REPEAT_DELAY_MS 后每 INPUT_REPEAT_MS 一次 REPEAT，不产生 BACK；
+   未使能双击时两次快速单击就是两个 ENTER */
+static const GoldenStep s_gesture_repeat_steps[] = {
+    KEY(100, 1), KEY(200, 0),
+    GOT(300, INPUT_ENTER, 1, 0, 200),
+    KEY(500, 1),
+    GOT(950, INPUT_REPEAT, 1, 0, 900),
+    GOT(1250, INPUT_REPEAT, 1, 0, 1000),
+    GOT(1250, INPUT_REPEAT, 1, 0, 1100),
+    GOT(1250, INPUT_REPEAT, 1, 0, 1200),
+    KEY(1250, 0),                       // 松开：不产生 ENTER
+    GOT_NONE(1400),
+    KEY(1500, 1), KEY(1550, 0), KEY(1650, 1), KEY(1700, 0),
+    GOT(1800, INPUT_ENTER, 1, 0, 1550),
+    GOT(1800, INPUT_ENTER, 1, 0, 1700),
+    GOT_NONE(1800),
+    END(1900),
+};
+
+/* 时钟界面：与 StartMenuTask 的 UI_CLOCK 分支一致 */
+static void golden_clock_entry(void)
+{
+    for (;;)
+    {
+        CLOCK_Draw();
+        osDelay(10);
+    }
+}
+
+/* 滚动字幕场景用的页面：第 1 项为超宽选项（31 个字符 = 248 px） */
+#define GOLDEN_MARQUEE_ITEMS(ITEM, SUBMENU, VAR)    \
+    ITEM("<<<", NULL)                               \
+    ITEM("Scrolling label wider than OLED", NULL)   \
+    ITEM("Short", NULL)
+
+MENU_PAGE_DEFINE(GoldenMarquee, NULL, GOLDEN_MARQUEE_ITEMS);
+
+static void golden_marquee_entry(void)
+{
+    MENU_StopTimer();
+    MENU_UpdateActivity();
+    MENU_PushPage(&MENU_Page_GoldenMarquee);
+    Screen_Run();
+}
+
+/* 天气与游戏是屏幕栈上的应用：压栈后由帧循环驱动（帧循环会判定息屏，先重置活动时间，
+   与从菜单进入时一致） */
+static void golden_weather_entry(void)
+{
+    MENU_UpdateActivity();
+    Weather_Open();
+    Screen_Run();
+}
+
+static void golden_snake_entry(void)
+{
+    MENU_UpdateActivity();
+    Game_Snake_Init();
+    Screen_Run();
+}
+
+static void golden_dino_entry(void)
+{
+    MENU_UpdateActivity();
+    Game_Dino_Init();
+    Screen_Run();
+}
+
+/* 手势场景用的空白界面：只经 UI_App.gestures 使能手势（与其他界面一样由屏幕栈设置），
+   识别出的事件由 GOT 步骤检查 */
+static uint32_t golden_gesture_frame(void *ctx, bool full)
+{
+    (void)ctx;
+    (void)full;
+    return UI_SCREEN_IDLE;
+}
+
+static void golden_gesture_input(void *ctx, const InputEvent *event)
+{
+    (void)ctx;
+    (void)event;
+}
+
+static const UI_App s_gesture_app = {
+    .name = "Gestures",
+    .onFrame = golden_gesture_frame,
+    .onInput = golden_gesture_input,
+    .gestures = INPUT_GESTURE_DOUBLE | INPUT_GESTURE_PRESS_ROTATE,
+};
+
+static const UI_App s_gesture_repeat_app = {
+    .name = "Repeat",
+    .onFrame = golden_gesture_frame,
+    .onInput = golden_gesture_input,
+    .gestures = INPUT_GESTURE_REPEAT,
+};
+
+static void golden_gesture_entry(void)
+{
+    MENU_UpdateActivity();
+    Screen_Push(&s_gesture_app, NULL);
+    Screen_Run();
+}
+
+static void golden_gesture_repeat_entry(void)
+{
+    MENU_UpdateActivity();
+    Screen_Push(&s_gesture_repeat_app, NULL);
+    Screen_Run();
+}
+
+/* 前一场景启动的倒计时早已到点，先停掉（连同未取走的到点事件），避免"时间到"弹窗挡住主菜单 */
+static void golden_sleep_entry(void)
+{
+    MENU_StopTimer();
+    MENU_RunMainMenu();
+}
+
+/* 设置场景从默认值开始，不受前面场景的影响 */
+static void golden_settings_entry(void)
+{
+    MENU_StopTimer();
+    oled_brightness = 128;
+    auto_sleep_seconds = 120;
+    MENU_RunMainMenu();
+}
+
+static void golden_popup_entry(void)
+{
+    Popup_Show("Saved", POPUP_TOAST, 600);
+    MENU_StartTimer(2);
+    MENU_RunMainMenu();
+}
+
+static void golden_transition_entry(void)
+{
+    MENU_StopTimer();
+    MENU_RunMainMenu();
+}
+
+static void golden_timer_race_entry(void)
+{
+    MENU_StopTimer();
+    auto_sleep_seconds = 120;
+    HostPort_SetTimerLag(20);
+    MENU_StartTimer(120);   // 与自动息屏同一时刻到点（主菜单开始时重置活动时间）
+    MENU_RunMainMenu();
+}
+
+static void golden_timers_entry(void)
+{
+    TimerSvc_Start("Tea ready", 1000, false);
+    MENU_StartTimer(3);
+    MENU_RunMainMenu();
+}
+
+/* timers 场景结束时"时间到"弹窗仍在，先确认掉（滑出在第一张截图之前结束） */
+static void golden_stopwatch_entry(void)
+{
+    InputEvent ack = {.type = INPUT_BACK, .value = 2, .steps = 2, .time = HostPort_Now()};
+
+    Popup_HandleInput(&ack);
+    Stopwatch_Open();
+    Screen_Run();
+}
+
+static const GoldenScenario s_scenarios[] = {
+    {"menu",    MENU_RunMainMenu,   s_menu_steps},
+    {"weather", golden_weather_entry, s_weather_steps},
+    {"clock",   golden_clock_entry, s_clock_steps},
+    {"snake",   golden_snake_entry, s_snake_steps},
+    {"dino",    golden_dino_entry,  s_dino_steps},
+    {"timer_overlay", MENU_RunMainMenu, s_timer_overlay_steps},   // 新场景加在末尾，避免改变其他场景的起始时间
+    {"sleep",   golden_sleep_entry, s_sleep_steps},
+    {"settings", golden_settings_entry, s_settings_steps},
+    {"popup",   golden_popup_entry, s_popup_steps},
+    {"transition", golden_transition_entry, s_transition_steps},
+    {"fling",   golden_transition_entry, s_fling_steps},
+    {"timers",  golden_timers_entry, s_timers_steps},
+    {"stopwatch", golden_stopwatch_entry, s_stopwatch_steps},
+    {"input_burst", golden_transition_entry, s_input_burst_steps},
+    {"held_rotate", golden_settings_entry, s_held_rotate_steps},
+    {"replay",  golden_transition_entry, s_replay_steps},
+    {"timer_race", golden_timer_race_entry, s_timer_race_steps},
+    {"marquee", golden_marquee_entry, s_marquee_steps},
+    {"input_backpressure", golden_transition_entry, s_input_backpressure_steps},
+    {"gesture", golden_gesture_entry, s_gesture_steps},
+    {"gesture_repeat", golden_gesture_repeat_entry, s_gesture_repeat_steps},
+    {"anim_idle", golden_transition_entry, s_anim_idle_steps},
+};
+
+/* ========= PBM 读写与比较 ========= */
+
+static int s_update = 0;
+static const char *s_golden_dir = "golden";
+static const char *s_out_dir = "build/golden-out";
+static int s_snapshots = 0;
+static int s_failures = 0;
+
+static int golden_pixel(const uint8_t buf[8][128], int x, int y)
+{
+    return (buf[y / 8][x] >> (y % 8)) & 1;
+}
+
+static int pbm_write(const char *path, const uint8_t buf[8][128])
+{
+    FILE *f = fopen(path, "wb");
+    if (!f) return 0;
+    fprintf(f, "P4\n%d %d\n", GOLDEN_W, GOLDEN_H);
+    for (int y = 0; y < GOLDEN_H; y++)
+    {
+        for (int xb = 0; xb < GOLDEN_W / 8; xb++)
+        {
+            uint8_t byte = 0;
+            for (int b = 0; b < 8; b++)
+            {
+                byte |= (uint8_t)(golden_pixel(buf, xb * 8 + b, y) << (7 - b));
+            }
+            fputc(byte, f);
+        }
+    }
+    fclose(f);
+    return 1;
+}
+
+static int pbm_read(const char *path, uint8_t buf[8][128])
+{
+    FILE *f = fopen(path, "rb");
+    int w, h;
+    if (!f) return 0;
+    if (fscanf(f, "P4 %d %d", &w, &h) != 2 || w != GOLDEN_W || h != GOLDEN_H || fgetc(f) == EOF)
+    {
+        fclose(f);
+        return 0;
+    }
+    memset(buf, 0, 8 * 128);
+    for (int y = 0; y < GOLDEN_H; y++)
+    {
+        for (int xb = 0; xb < GOLDEN_W / 8; xb++)
+        {
+            int byte = fgetc(f);
+            if (byte == EOF)
+            {
+                fclose(f);
+                return 0;
+            }
+            for (int b = 0; b < 8; b++)
+            {
+                if (byte & (0x80 >> b)) buf[y / 8][xb * 8 + b] |= (uint8_t)(1 << (y % 8));
+            }
+        }
+    }
+    fclose(f);
+    return 1;
+}
+
+static void ppm_write_diff(const char *path, const uint8_t want[8][128], const uint8_t got[8][128])
+{
+    FILE *f = fopen(path, "wb");
+    if (!f) return;
+    fprintf(f, "P6\n%d %d\n255\n", GOLDEN_W * GOLDEN_DIFF_SCALE, GOLDEN_H * GOLDEN_DIFF_SCALE);
+    for (int y = 0; y < GOLDEN_H * GOLDEN_DIFF_SCALE; y++)
+    {
+        for (int x = 0; x < GOLDEN_W * GOLDEN_DIFF_SCALE; x++)
+        {
+            int a = golden_pixel(want, x / GOLDEN_DIFF_SCALE, y / GOLDEN_DIFF_SCALE);
+            int b = golden_pixel(got, x / GOLDEN_DIFF_SCALE, y / GOLDEN_DIFF_SCALE);
+            uint8_t rgb[3] = {255, 255, 255};
+            if (a && b)      { rgb[0] = 0;   rgb[1] = 0;   rgb[2] = 0; }
+            else if (a)      { rgb[0] = 220; rgb[1] = 0;   rgb[2] = 0; }
+            else if (b)      { rgb[0] = 0;   rgb[1] = 180; rgb[2] = 0; }
+            fwrite(rgb, 1, 3, f);
+        }
+    }
+    fclose(f);
+}
+
+static int golden_panel_matches_framebuffer(const uint8_t panel[8][128])
+{
+    uint8_t composed[8][128];
+
+    if (memcmp(panel, OLED_DisplayBuf, sizeof(composed)) == 0) return 1;
+
+    memcpy(composed, OLED_DisplayBuf, sizeof(composed));
+    for (uint8_t page = 0; page < 8; page++)
+    {
+        Overlay_Compose(page, composed[page]);
+    }
+    return memcmp(panel, composed, sizeof(composed)) == 0;
+}
+
+static void golden_snapshot(const char *name)
+{
+    char path[512];
+    uint8_t want[8][128];
+    uint8_t got[8][128];
+    int bad = 0;
+
+    SSD1306Emu_RenderPanel(got);
+    s_snapshots++;
+
+    /* 截图时刻界面已经刷新完毕，屏上内容应与显存（菜单帧还要叠加覆盖层小部件）一致；息屏时面板全黑，不比较 */
+    if (SSD1306Emu_IsDisplayOn() && !golden_panel_matches_framebuffer(got))
+    {
+        fprintf(stderr, "FAIL %-28s panel does not match OLED_DisplayBuf\n", name);
+        bad = 1;
+    }
+    if (SSD1306Emu_GetStats().protocol_errors)
+    {
+        fprintf(stderr, "FAIL %-28s %u SSD1306 protocol error(s), last: %s\n", name,
+                (unsigned)SSD1306Emu_GetStats().protocol_errors, SSD1306Emu_LastError());
+        SSD1306Emu_ResetStats();
+        bad = 1;
+    }
+
+    snprintf(path, sizeof(path), "%s/%s.pbm", s_golden_dir, name);
+    if (s_update)
+    {
+        if (!pbm_write(path, got))
+        {
+            fprintf(stderr, "golden: cannot write %s\n", path);
+            bad = 1;
+        }
+        s_failures += bad;
+        return;
+    }
+
+    if (!pbm_read(path, want))
+    {
+        fprintf(stderr, "FAIL %-28s missing or invalid %s\n", name, path);
+        s_failures++;
+        return;
+    }
+    if (memcmp(want, got, sizeof(got)) == 0)
+    {
+        if (!bad) printf("ok   %s\n", name);
+        s_failures += bad;
+        return;
+    }
+
+    int diff = 0;
+    for (int y = 0; y < GOLDEN_H; y++)
+        for (int x = 0; x < GOLDEN_W; x++)
+            diff += golden_pixel(want, x, y) != golden_pixel(got, x, y);
+    fprintf(stderr, "FAIL %-28s %d pixel(s) differ\n", name, diff);
+    s_failures++;
+
+    snprintf(path, sizeof(path), "%s/%s.actual.pbm", s_out_dir, name);
+    pbm_write(path, got);
+    snprintf(path, sizeof(path), "%s/%s.diff.ppm", s_out_dir, name);
+    ppm_write_diff(path, want, got);
+}
+
+/* ========= 脚本执行（在 osDelay / 阻塞读队列的空闲钩子中推进） ========= */
+
+static const GoldenStep *s_step;
+static uint32_t s_scenario_start;
+static uint32_t s_bus_mark;        // 上一次快照/断言时的总线字节数
+static InputQueueStats s_queue_mark;    // 场景开始时的投递统计
+
+#define GOLDEN_GOT_MAX  16
+static InputEvent s_got[GOLDEN_GOT_MAX];   // 输入层识别出、尚未被 GOT 检查的事件
+static uint8_t s_got_head;
+static uint8_t s_got_count;
+
+/* 与 InputTask 相同：取出输入层（消抖、手势识别）产生的全部事件，投递到输入队列 */
+static void golden_input_task(void)
+{
+    for (;;)
+    {
+        InputEvent event = Input_GetEvent();
+        if (event.type == INPUT_NONE)
+        {
+            break;
+        }
+        if (InputReplay_Playing())
+        {
+            InputReplay_Stop();
+        }
+        if (s_got_count < GOLDEN_GOT_MAX)
+        {
+            s_got[(s_got_head + s_got_count++) % GOLDEN_GOT_MAX] = event;
+        }
+        InputQueue_Post(&event);
+    }
+}
+
+static void golden_check_got(const GoldenStep *st)
+{
+    s_snapshots++;
+    if (st->input == INPUT_NONE)
+    {
+        if (s_got_count == 0)
+        {
+            return;
+        }
+        fprintf(stderr, "FAIL got @%-4u unexpected event %d value %d at %u\n", (unsigned)st->at_ms,
+                (int)s_got[s_got_head].type, s_got[s_got_head].value,
+                (unsigned)(s_got[s_got_head].time - s_scenario_start));
+        s_failures++;
+        s_got_count = 0;
+        return;
+    }
+    if (s_got_count == 0)
+    {
+        fprintf(stderr, "FAIL got @%-4u no event, want %d value %d at %u\n", (unsigned)st->at_ms,
+                (int)st->input, st->value, (unsigned)st->event_ms);
+        s_failures++;
+        return;
+    }
+
+    const InputEvent *ev = &s_got[s_got_head];
+    s_got_head = (uint8_t)((s_got_head + 1U) % GOLDEN_GOT_MAX);
+    s_got_count--;
+    if (ev->type != st->input || ev->value != st->value || ev->mods != st->mods ||
+        ev->time - s_scenario_start != st->event_ms)
+    {
+        fprintf(stderr, "FAIL got @%-4u event %d value %d mods %u at %u, want %d value %d mods %u at %u\n",
+                (unsigned)st->at_ms, (int)ev->type, ev->value, (unsigned)ev->mods,
+                (unsigned)(ev->time - s_scenario_start),
+                (int)st->input, st->value, (unsigned)st->mods, (unsigned)st->event_ms);
+        s_failures++;
+    }
+}
+
+static uint32_t golden_bus_bytes(void)
+{
+    SSD1306Emu_Stats st = SSD1306Emu_GetStats();
+    return st.cmd_bytes + st.data_bytes;
+}
+
+static void golden_idle_hook(uint32_t elapsed_ms)
+{
+    (void)elapsed_ms;
+    uint32_t t = HostPort_Now() - s_scenario_start;
+
+    InputQueue_Flush(); // 与 InputTask 相同：界面取空队列后送出合并中的旋转
+    InputReplay_Poll(HostPort_Now());
+
+    while (t >= s_step->at_ms)
+    {
+        const GoldenStep *st = s_step++;
+        switch (st->kind)
+        {
+        case STEP_INPUT:
+        {
+            InputEvent ev = {.type = st->input, .value = st->value, .steps = st->value, // 不加速
+                             .time = HostPort_Now()};
+            InputQueue_Post(&ev);
+        }
+        break;
+
+        case STEP_KEY:
+            HostPort_Key(st->value != 0);
+            break;
+
+        case STEP_TURN:
+            HostPort_Turn(st->value);
+            break;
+
+        case STEP_GOT:
+            golden_input_task();    // 先取出到此刻为止识别出的事件
+            golden_check_got(st);
+            break;
+
+        case STEP_SPIN:
+        {
+            InputEvent ev = InputAccel_Rotation((st->input == INPUT_DOWN) ? st->value : (int16_t)-st->value,
+                                                HostPort_Now());
+            InputQueue_Post(&ev);
+        }
+        break;
+
+        case STEP_SNAPSHOT:
+            golden_snapshot(st->name);
+            s_bus_mark = golden_bus_bytes();
+            break;
+
+        case STEP_QUIET:
+        {
+            uint32_t bytes = golden_bus_bytes() - s_bus_mark;
+            s_snapshots++;
+            if (bytes)
+            {
+                fprintf(stderr, "FAIL %-28s %u byte(s) sent on the bus\n", st->name, (unsigned)bytes);
+                s_failures++;
+            }
+            else
+            {
+                printf("ok   %s\n", st->name);
+            }
+            s_bus_mark = golden_bus_bytes();
+        }
+        break;
+
+        case STEP_QUEUE:
+        {
+            InputQueueStats now;
+            InputQueue_GetStats(&now);
+            uint32_t posted = now.posted - s_queue_mark.posted;
+            uint32_t coalesced = now.coalesced - s_queue_mark.coalesced;
+            uint32_t overflows = now.overflows - s_queue_mark.overflows;
+            uint32_t dropped = now.dropped - s_queue_mark.dropped;
+            s_snapshots++;
+            if (posted != st->queue->posted || coalesced != st->queue->coalesced ||
+                overflows != st->queue->overflows || dropped != st->queue->dropped)
+            {
+                fprintf(stderr, "FAIL %-28s posted/coalesced/overflows/dropped %u/%u/%u/%u, want %u/%u/%u/%u\n",
+                        st->name, (unsigned)posted, (unsigned)coalesced, (unsigned)overflows, (unsigned)dropped,
+                        (unsigned)st->queue->posted, (unsigned)st->queue->coalesced,
+                        (unsigned)st->queue->overflows, (unsigned)st->queue->dropped);
+                s_failures++;
+            }
+            else
+            {
+                printf("ok   %s\n", st->name);
+            }
+        }
+        break;
+
+        case STEP_TIME:
+        {
+            SNTP_Time_t tm = {2026, 1, 4, 16, 34, 45, "Sun"};
+            osMessageQueuePut(TimeQueueHandle, &tm, 0, 0);
+        }
+        break;
+
+        case STEP_END:
+            HostPort_Exit();
+            break;
+        }
+    }
+    golden_input_task();
+}
+
+int main(int argc, char **argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--update")) s_update = 1;
+        else if (!strcmp(argv[i], "--golden-dir") && i + 1 < argc) s_golden_dir = argv[++i];
+        else if (!strcmp(argv[i], "--out-dir") && i + 1 < argc) s_out_dir = argv[++i];
+        else
+        {
+            fprintf(stderr, "usage: %s [--update] [--golden-dir DIR] [--out-dir DIR]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    HostPort_Init();
+    TimerSvc_Init();
+    OLED_Init();
+    MENU_SetFpsVisible(0);  // 帧率随主机耗时变化，不进基准图
+    HostPort_SetIdleHook(golden_idle_hook);
+
+    for (size_t i = 0; i < sizeof(s_scenarios) / sizeof(s_scenarios[0]); i++)
+    {
+        InputEvent discard;
+        while (osMessageQueueGet(InputEventQueueHandle, &discard, NULL, 0) == osOK);
+
+        HostPort_Advance(GOLDEN_SCENARIO_MS - (HostPort_Now() % GOLDEN_SCENARIO_MS));
+        s_scenario_start = HostPort_Now();
+        s_step = s_scenarios[i].steps;
+        InputQueue_GetStats(&s_queue_mark);
+        s_got_count = 0;
+
+        HostPort_SetTimerLag(0);
+        Screen_Reset(); // 上一场景在帧循环中途结束，栈上的屏幕（及其动画槽位）在此释放
+        OLED_Clear();
+        HostPort_Run(s_scenarios[i].entry);
+    }
+
+    if (s_update)
+    {
+        printf("golden: wrote %d image(s) to %s/\n", s_snapshots, s_golden_dir);
+        return s_failures ? 1 : 0;
+    }
+    printf("golden: %d/%d snapshot(s) match\n", s_snapshots - s_failures, s_snapshots);
+    return s_failures ? 1 : 0;
+}
@@ -0,0 +1,536 @@
+/*
+ * host_port.c
+ *
+ *  主机端移植层实现，见 host_port.h。
+ */
+
+#include "host_port.h"
+#include "ssd1306_emu.h"
+#include "stm32f4xx_hal.h"
+#include "cmsis_os.h"
+#include "flash_storage.h"
+#include "esp_at.h"
+#include "input.h"
+#include "encoder_driver.h"
+#include "time_task.h"
+#include "low_power.h"
+
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* 主机端没有 MX_xxx_Init：外设句柄与队列句柄在这里定义 */
+GPIO_TypeDef HostGPIOA, HostGPIOB, HostGPIOC;
+TIM_TypeDef HostTIM5;
+SYSCFG_TypeDef HostSYSCFG;
+EXTI_TypeDef HostEXTI;
+SPI_HandleTypeDef hspi1;
+TIM_HandleTypeDef htim1;
+osThreadId_t InputTaskHandle;       // 主机端没有 InputTask（NULL）
+osMessageQueueId_t InputEventQueueHandle;
+osMessageQueueId_t TimeQueueHandle;
+osEventFlagsId_t g_appEventFlags;   // 主机端不创建：WiFi 视为未连接
+
+#define HOST_QUEUE_MAX_MSG   32U
+#define HOST_QUEUE_MAX_SIZE  32U
+#define HOST_BLOCK_STEP_MS   10U      // 阻塞等待时每步推进的假时间
+#define HOST_BLOCK_LIMIT_MS  600000U  // 无钩子时的死等保护（10 分钟假时间）
+
+struct HostMessageQueue
+{
+    uint32_t msg_count;
+    uint32_t msg_size;
+    uint32_t head;
+    uint32_t count;
+    uint32_t blocked;   // 队列满时阻塞投递的消息：排在 count 之后，取走一条即补入一条
+    uint8_t  buf[HOST_QUEUE_MAX_MSG][HOST_QUEUE_MAX_SIZE];
+};
+
+static struct HostMessageQueue s_queues[4];
+static uint8_t s_queue_used = 0;
+
+static uint32_t s_now_ms = 0;
+static HostPort_IdleHook s_idle_hook = NULL;
+static jmp_buf s_exit_env;
+static bool s_exit_armed = false;
+
+struct HostTimer
+{
+    osTimerFunc_t func;
+    void *argument;
+    osTimerType_t type;
+    uint32_t period;
+    uint32_t deadline;
+    bool running;
+};
+
+#define HOST_TIMER_MAX 8U
+
+static struct HostTimer s_timers[HOST_TIMER_MAX];
+static uint8_t s_timer_used = 0;
+static uint32_t s_timer_lag_ms = 0;     // 回调推迟执行的毫秒数（见 HostPort_SetTimerLag）
+
+static GPIO_PinState s_dc_level = GPIO_PIN_RESET;
+static HostSpiStats s_spi;
+
+static bool s_key_down;             // PB6 电平（true = 按下，低电平）
+static bool s_key_stable;           // 消抖后的状态
+static uint32_t s_key_edge_ms;      // 最近一个按键沿（含抖动）
+static int16_t s_encoder_detents;   // 已转动、尚未被 Encoder_Roll 取走的格数
+
+/* ========= 假时钟 ========= */
+
+void HostPort_Init(void)
+{
+    memset(s_queues, 0, sizeof(s_queues));
+    s_queue_used = 0;
+    memset(s_timers, 0, sizeof(s_timers));
+    s_timer_used = 0;
+    s_timer_lag_ms = 0;
+    s_now_ms = 0;
+    HostTIM5.CNT = 0;
+    s_key_down = false;
+    s_key_stable = false;
+    s_encoder_detents = 0;
+    s_idle_hook = NULL;
+    memset(&s_spi, 0, sizeof(s_spi));
+    SSD1306Emu_Reset();
+    SSD1306Emu_ResetStats();
+
+    InputEventQueueHandle = osMessageQueueNew(16, sizeof(InputEvent), NULL);
+    TimeQueueHandle = osMessageQueueNew(16, sizeof(SNTP_Time_t), NULL);
+}
+
+uint32_t HostPort_Now(void)
+{
+    return s_now_ms;
+}
+
+/* 执行已到点的软件定时器（回调里可以重新启动定时器）；设置了推迟时，到点后再过 s_timer_lag_ms 才执行 */
+static void host_fire_timers(void)
+{
+    for (uint8_t i = 0; i < s_timer_used; i++)
+    {
+        struct HostTimer *t = &s_timers[i];
+
+        while (t->running && (int32_t)(s_now_ms - t->deadline) >= (int32_t)s_timer_lag_ms)
+        {
+            if (t->type == osTimerPeriodic)
+            {
+                t->deadline += t->period;
+            }
+            else
+            {
+                t->running = false;
+            }
+            t->func(t->argument);
+        }
+    }
+}
+
+void HostPort_Advance(uint32_t ms)
+{
+    s_now_ms += ms;
+    HostTIM5.CNT = s_now_ms * 1000U;
+    SSD1306Emu_Tick(ms);
+    host_fire_timers();
+}
+
+void HostPort_SetTimerLag(uint32_t ms)
+{
+    s_timer_lag_ms = ms;
+}
+
+void HostPort_SetIdleHook(HostPort_IdleHook hook)
+{
+    s_idle_hook = hook;
+}
+
+static void host_idle(uint32_t ms)
+{
+    s_now_ms += ms;
+    HostTIM5.CNT = s_now_ms * 1000U;
+    SSD1306Emu_Tick(ms);
+    host_fire_timers();
+    if (s_idle_hook)
+    {
+        s_idle_hook(ms);
+    }
+}
+
+void HostPort_Run(void (*entry)(void))
+{
+    if (setjmp(s_exit_env) == 0)
+    {
+        s_exit_armed = true;
+        entry();
+    }
+    s_exit_armed = false;
+}
+
+void HostPort_Exit(void)
+{
+    if (!s_exit_armed)
+    {
+        fprintf(stderr, "host_port: HostPort_Exit() outside HostPort_Run()\n");
+        abort();
+    }
+    longjmp(s_exit_env, 1);
+}
+
+/* ========= HAL 桩 ========= */
+
+uint32_t HAL_GetTick(void)
+{
+    return s_now_ms;
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+    host_idle(Delay);
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    /* OLED DC 引脚：PB1 */
+    if (GPIOx == GPIOB && GPIO_Pin == GPIO_PIN_1)
+    {
+        s_dc_level = PinState;
+    }
+    /* OLED RES 引脚：PB0，低电平复位 */
+    if (GPIOx == GPIOB && GPIO_Pin == GPIO_PIN_0 && PinState == GPIO_PIN_RESET)
+    {
+        SSD1306Emu_Reset();
+    }
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    if (GPIOx == GPIOB && GPIO_Pin == GPIO_PIN_6)
+    {
+        return s_key_down ? GPIO_PIN_RESET : GPIO_PIN_SET; // 按键：上拉输入，按下为低
+    }
+    return GPIO_PIN_SET;
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+    (void)IRQn;
+    (void)PreemptPriority;
+    (void)SubPriority;
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+    (void)IRQn;
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    (void)hspi;
+    (void)Timeout;
+
+    s_spi.transfers++;
+    SSD1306Emu_Write(s_dc_level == GPIO_PIN_SET, pData, Size);
+    if (s_dc_level == GPIO_PIN_SET)
+    {
+        s_spi.data_bytes += Size;
+    }
+    else
+    {
+        s_spi.cmd_bytes += Size;
+    }
+    return HAL_OK;
+}
+
+void HostPort_ResetSpiStats(void)
+{
+    memset(&s_spi, 0, sizeof(s_spi));
+}
+
+HostSpiStats HostPort_GetSpiStats(void)
+{
+    return s_spi;
+}
+
+/* ========= CMSIS-RTOS2 桩（单线程） ========= */
+
+osMessageQueueId_t osMessageQueueNew(uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t *attr)
+{
+    (void)attr;
+    if (s_queue_used >= (sizeof(s_queues) / sizeof(s_queues[0])) ||
+        msg_count > HOST_QUEUE_MAX_MSG || msg_size > HOST_QUEUE_MAX_SIZE)
+    {
+        return NULL;
+    }
+
+    struct HostMessageQueue *q = &s_queues[s_queue_used++];
+    q->msg_count = msg_count;
+    q->msg_size = msg_size;
+    q->head = 0;
+    q->count = 0;
+    q->blocked = 0;
+    return q;
+}
+
+/* 单线程下生产者无法真的阻塞：队列满且允许等待时，消息记为"阻塞中"，返回 osOK，
+   等消费者取走一条后按顺序补入队列（相当于目标板上生产者被唤醒后完成投递） */
+osStatus_t osMessageQueuePut(osMessageQueueId_t mq_id, const void *msg_ptr, uint8_t msg_prio, uint32_t timeout)
+{
+    (void)msg_prio;
+    if (!mq_id || !msg_ptr) return osErrorParameter;
+    if (mq_id->count >= mq_id->msg_count || mq_id->blocked)
+    {
+        if (timeout == 0) return osErrorResource;
+        if (mq_id->count + mq_id->blocked >= HOST_QUEUE_MAX_MSG) return osErrorTimeout;
+    }
+
+    uint32_t tail = (mq_id->head + mq_id->count + mq_id->blocked) % HOST_QUEUE_MAX_MSG;
+    memcpy(mq_id->buf[tail], msg_ptr, mq_id->msg_size);
+    if (mq_id->count < mq_id->msg_count)
+    {
+        mq_id->count++;
+    }
+    else
+    {
+        mq_id->blocked++;
+    }
+    return osOK;
+}
+
+osStatus_t osMessageQueueGet(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio, uint32_t timeout)
+{
+    uint32_t waited = 0;
+
+    if (!mq_id || !msg_ptr) return osErrorParameter;
+    if (msg_prio) *msg_prio = 0;
+
+    /* 队列空且允许等待：推进假时钟，让钩子有机会注入消息 */
+    while (mq_id->count == 0 && waited < timeout)
+    {
+        uint32_t step = timeout - waited;
+        if (step > HOST_BLOCK_STEP_MS) step = HOST_BLOCK_STEP_MS;
+        if (!s_idle_hook && timeout == osWaitForever && waited >= HOST_BLOCK_LIMIT_MS)
+        {
+            fprintf(stderr, "host_port: osMessageQueueGet() would block forever\n");
+            abort();
+        }
+        host_idle(step);
+        waited += step;
+    }
+
+    if (mq_id->count == 0)
+    {
+        return (timeout == 0) ? osErrorResource : osErrorTimeout;
+    }
+
+    memcpy(msg_ptr, mq_id->buf[mq_id->head], mq_id->msg_size);
+    mq_id->head = (mq_id->head + 1) % HOST_QUEUE_MAX_MSG;
+    if (mq_id->blocked)
+    {
+        mq_id->blocked--;   // 阻塞的投递完成，队列仍满
+    }
+    else
+    {
+        mq_id->count--;
+    }
+    return osOK;
+}
+
+uint32_t osMessageQueueGetCount(osMessageQueueId_t mq_id)
+{
+    return mq_id ? mq_id->count : 0;
+}
+
+osStatus_t osMessageQueueReset(osMessageQueueId_t mq_id)
+{
+    if (!mq_id) return osErrorParameter;
+    mq_id->head = 0;
+    mq_id->count = 0;
+    mq_id->blocked = 0;
+    return osOK;
+}
+
+struct HostEventFlags
+{
+    uint32_t flags;
+};
+
+uint32_t osEventFlagsGet(osEventFlagsId_t ef_id)
+{
+    return ef_id ? ef_id->flags : 0U;
+}
+
+uint32_t osEventFlagsSet(osEventFlagsId_t ef_id, uint32_t flags)
+{
+    if (!ef_id) return osFlagsError;
+    ef_id->flags |= flags;
+    return ef_id->flags;
+}
+
+uint32_t osEventFlagsClear(osEventFlagsId_t ef_id, uint32_t flags)
+{
+    if (!ef_id) return osFlagsError;
+    uint32_t prev = ef_id->flags;
+    ef_id->flags &= ~flags;
+    return prev;
+}
+
+osStatus_t osDelay(uint32_t ticks)
+{
+    host_idle(ticks);
+    return osOK;
+}
+
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags)
+{
+    (void)thread_id;
+    return flags;
+}
+
+osTimerId_t osTimerNew(osTimerFunc_t func, osTimerType_t type, void *argument, const osTimerAttr_t *attr)
+{
+    (void)attr;
+    if (!func || s_timer_used >= HOST_TIMER_MAX) return NULL;
+
+    struct HostTimer *t = &s_timers[s_timer_used++];
+    t->func = func;
+    t->argument = argument;
+    t->type = type;
+    t->running = false;
+    return t;
+}
+
+osStatus_t osTimerStart(osTimerId_t timer_id, uint32_t ticks)
+{
+    if (!timer_id || ticks == 0) return osErrorParameter;
+    timer_id->period = ticks;
+    timer_id->deadline = s_now_ms + ticks;
+    timer_id->running = true;
+    return osOK;
+}
+
+osStatus_t osTimerStop(osTimerId_t timer_id)
+{
+    if (!timer_id) return osErrorParameter;
+    if (!timer_id->running) return osErrorResource;
+    timer_id->running = false;
+    return osOK;
+}
+
+uint32_t osTimerIsRunning(osTimerId_t timer_id)
+{
+    return (timer_id && timer_id->running) ? 1U : 0U;
+}
+
+/* ========= Flash 桩：读取失败，config_store 回落到默认配置 ========= */
+
+FS_Status FlashStorage_Read(uint32_t address, void *buffer, uint32_t length)
+{
+    (void)address;
+    (void)buffer;
+    (void)length;
+    return FS_ERR_HAL;
+}
+
+FS_Status FlashStorage_EraseConfigSector(void)
+{
+    return FS_OK;
+}
+
+FS_Status FlashStorage_Write(uint32_t address, const void *data, uint32_t length)
+{
+    (void)address;
+    (void)data;
+    (void)length;
+    return FS_OK;
+}
+
+/* ========= 按键与编码器驱动桩：沿由脚本注入（HostPort_Key / HostPort_Turn），经 input.c 的 EXTI 回调 ========= */
+
+#define HOST_KEY_DEBOUNCE_MS    20U     // 与 encoder_driver.c 的 KEY_DEBOUNCE_TICKS 相同
+
+void Key_OnEdgeFromISR(void)
+{
+    s_key_edge_ms = s_now_ms;
+}
+
+/* 与 encoder_driver.c 相同：最后一个沿之后稳定 HOST_KEY_DEBOUNCE_MS 才算有效跳变 */
+KeyPressState KeyPress(void)
+{
+    if (s_key_stable != s_key_down && (s_now_ms - s_key_edge_ms) >= HOST_KEY_DEBOUNCE_MS)
+    {
+        s_key_stable = s_key_down;
+        return s_key_stable ? KEY_DOWN : KEY_UP;
+    }
+    return KEY_UNPRESSED;
+}
+
+uint32_t KeyPress_EdgeTick(void)
+{
+    return s_key_edge_ms;
+}
+
+uint32_t KeyPress_MsUntilDeadline(void)
+{
+    uint32_t elapsed = s_now_ms - s_key_edge_ms;
+
+    if (s_key_stable == s_key_down)
+    {
+        return UINT32_MAX;
+    }
+    return (elapsed >= HOST_KEY_DEBOUNCE_MS) ? 0U : HOST_KEY_DEBOUNCE_MS - elapsed;
+}
+
+/* 编码器不模拟 A/B 相：注入的格数就是消抖后的格数 */
+int16_t Encoder_Roll(void)
+{
+    int16_t detents = s_encoder_detents;
+
+    s_encoder_detents = 0;
+    return detents;
+}
+
+uint32_t Encoder_MsUntilDeadline(void)
+{
+    return UINT32_MAX;
+}
+
+void HostPort_Key(bool pressed)
+{
+    s_key_down = pressed;
+    HAL_GPIO_EXTI_Callback(GPIO_PIN_6);
+}
+
+void HostPort_Turn(int16_t detents)
+{
+    s_encoder_detents = (int16_t)(s_encoder_detents + detents);
+    HAL_GPIO_EXTI_Callback(GPIO_PIN_8);
+}
+
+/* ========= 低功耗桩：主机端没有 STOP 模式，息屏阻塞由输入队列模拟 ========= */
+
+void LowPower_SetDisplaySleeping(bool sleeping)
+{
+    (void)sleeping;
+}
+
+void LowPower_OnWakeEdge(void)
+{
+}
+
+/* ========= ESP-AT 桩：主机端没有网络 ========= */
+
+bool ESP_AT_SendWaitFor(const char* cmd, const char* expect, uint32_t timeout_ms)
+{
+    (void)cmd;
+    (void)expect;
+    (void)timeout_ms;
+    return false;
+}
+
+const char* ESP_AT_GetLastRxSnippet(void)
+{
+    return NULL;
+}
@@ -0,0 +1,51 @@
+/*
+ * host_port.h
+ *
+ *  主机端 (Linux) 移植层：为 Core/Src 中的 OLED / MENU 等可移植模块提供
+ *  假时钟、SPI 总线计数、单线程消息队列、软件定时器、按键/编码器驱动以及 Flash / ESP-AT 桩函数。
+ */
+
+#ifndef HOST_PORT_H
+#define HOST_PORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* SPI 总线统计（由 HAL_SPI_Transmit 桩累计，DC 低=命令，DC 高=数据） */
+typedef struct
+{
+    uint32_t cmd_bytes;     // 命令字节数
+    uint32_t data_bytes;    // 数据字节数
+    uint32_t transfers;     // HAL_SPI_Transmit 调用次数
+} HostSpiStats;
+
+/* 空闲钩子：osDelay 或阻塞读取队列时调用，elapsed_ms 为本次推进的假时间 */
+typedef void (*HostPort_IdleHook)(uint32_t elapsed_ms);
+
+void HostPort_Init(void);
+
+/* 假时钟 */
+uint32_t HostPort_Now(void);
+void HostPort_Advance(uint32_t ms);
+void HostPort_SetIdleHook(HostPort_IdleHook hook);
+
+/* 软件定时器回调在到点后再推迟 ms 毫秒执行（默认 0）：模拟定时器服务任务优先级低于 UI 任务，
+ * 界面已看到剩余时间为 0、到点标记却还没置位的窗口 */
+void HostPort_SetTimerLag(uint32_t ms);
+
+/* 在可退出的上下文中运行一个阻塞式界面函数（如 MENU_RunMainMenu）；
+ * 钩子内调用 HostPort_Exit() 即可从任意深度的 while(1) 中返回 */
+void HostPort_Run(void (*entry)(void));
+void HostPort_Exit(void);
+
+/* 原始输入沿：按键 PB6 电平变化（含抖动沿，true = 按下）与编码器转动的格数（正 = 顺时针），
+ * 在当前假时间经 EXTI 回调进入 input.c（按下时刻捕获、消抖、手势识别）；
+ * 识别出的事件由调用方像 InputTask 一样用 Input_GetEvent 取出 */
+void HostPort_Key(bool pressed);
+void HostPort_Turn(int16_t detents);
+
+/* SPI 统计 */
+void HostPort_ResetSpiStats(void);
+HostSpiStats HostPort_GetSpiStats(void);
+
+#endif /* HOST_PORT_H */
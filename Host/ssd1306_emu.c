@@ -0,0 +1,448 @@
+/*
+ * ssd1306_emu.c
+ *
+ *  SSD1306 协议模型实现，见 ssd1306_emu.h。
+ *  只建模 OLED.c 会用到、或将来可能用到的命令子集；未知命令计入 protocol_errors。
+ */
+
+#include "ssd1306_emu.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define EMU_ROWS        64
+#define EMU_CMD_MAX     8
+
+typedef enum
+{
+    ADDR_HORIZONTAL = 0,
+    ADDR_VERTICAL   = 1,
+    ADDR_PAGE       = 2
+} EmuAddrMode;
+
+typedef enum
+{
+    SCROLL_RIGHT = 0,
+    SCROLL_LEFT,
+    SCROLL_VERT_RIGHT,
+    SCROLL_VERT_LEFT
+} EmuScrollType;
+
+typedef struct
+{
+    uint8_t ram[SSD1306_EMU_PAGES][SSD1306_EMU_WIDTH];
+
+    /* 寻址 */
+    EmuAddrMode mode;
+    uint8_t col, page;
+    uint8_t col_start, col_end;
+    uint8_t page_start, page_end;
+
+    /* 显示控制 */
+    bool display_on;
+    bool entire_on;     // A5：忽略 RAM 全亮
+    bool inverse;       // A7
+    bool seg_remap;     // A1
+    bool com_remap;     // C8
+    bool charge_pump;
+    uint8_t contrast;
+    uint8_t start_line;
+    uint8_t display_offset;
+    uint8_t mux;        // 多路复用率（行数）
+
+    /* 硬件滚动 */
+    bool scroll_active;
+    EmuScrollType scroll_type;
+    uint8_t scroll_page_start, scroll_page_end;
+    uint8_t scroll_interval;    // 帧间隔编码 0~7
+    uint8_t scroll_voffset;     // 每步垂直偏移行数
+    uint8_t vscroll_fixed;      // A3：顶部固定行数
+    uint8_t vscroll_rows;       // A3：滚动区行数
+    uint8_t vscroll_pos;        // 当前垂直滚动偏移
+    uint32_t scroll_frames;     // 距离上次滚动步进的帧数
+    uint32_t tick_ms;           // 不足一帧的剩余时间
+
+    /* 命令解析 */
+    uint8_t cmd[EMU_CMD_MAX];
+    uint8_t cmd_len;
+    uint8_t cmd_need;
+
+    SSD1306Emu_Stats stats;
+    char last_error[96];
+} SSD1306Emu;
+
+static SSD1306Emu s_emu;
+
+/* 数据手册中滚动帧间隔编码对应的帧数 */
+static const uint16_t s_scroll_frames[8] = {5, 64, 128, 256, 3, 4, 25, 2};
+
+static void emu_error(const char *fmt, uint8_t cmd)
+{
+    s_emu.stats.protocol_errors++;
+    snprintf(s_emu.last_error, sizeof(s_emu.last_error), fmt, cmd);
+}
+
+void SSD1306Emu_Reset(void)
+{
+    /* GDDRAM 与统计不受复位影响，其余寄存器回到上电默认值 */
+    uint8_t ram[SSD1306_EMU_PAGES][SSD1306_EMU_WIDTH];
+    SSD1306Emu_Stats stats = s_emu.stats;
+    memcpy(ram, s_emu.ram, sizeof(ram));
+
+    memset(&s_emu, 0, sizeof(s_emu));
+    memcpy(s_emu.ram, ram, sizeof(ram));
+    s_emu.stats = stats;
+
+    s_emu.mode = ADDR_PAGE;
+    s_emu.col_end = SSD1306_EMU_WIDTH - 1;
+    s_emu.page_end = SSD1306_EMU_PAGES - 1;
+    s_emu.contrast = 0x7F;
+    s_emu.mux = EMU_ROWS;
+    s_emu.vscroll_rows = EMU_ROWS;
+}
+
+/* ========= 命令 ========= */
+
+static uint8_t emu_arg_count(uint8_t c)
+{
+    switch (c)
+    {
+    case 0x20: case 0x81: case 0x8D: case 0xA8:
+    case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+        return 1;
+    case 0x21: case 0x22: case 0xA3:
+        return 2;
+    case 0x29: case 0x2A:
+        return 5;
+    case 0x26: case 0x27:
+        return 6;
+    default:
+        return 0;
+    }
+}
+
+static void emu_scroll_setup(const uint8_t *c)
+{
+    if (s_emu.scroll_active)
+    {
+        emu_error("cmd 0x%02X: scroll setup while scrolling is active", c[0]);
+    }
+    s_emu.scroll_page_start = c[2] & 0x07;
+    s_emu.scroll_interval = c[3] & 0x07;
+    s_emu.scroll_page_end = c[4] & 0x07;
+    if (s_emu.scroll_page_end < s_emu.scroll_page_start)
+    {
+        emu_error("cmd 0x%02X: scroll end page before start page", c[0]);
+    }
+
+    switch (c[0])
+    {
+    case 0x26: s_emu.scroll_type = SCROLL_RIGHT; s_emu.scroll_voffset = 0; break;
+    case 0x27: s_emu.scroll_type = SCROLL_LEFT; s_emu.scroll_voffset = 0; break;
+    case 0x29: s_emu.scroll_type = SCROLL_VERT_RIGHT; s_emu.scroll_voffset = c[5] & 0x3F; break;
+    default:   s_emu.scroll_type = SCROLL_VERT_LEFT; s_emu.scroll_voffset = c[5] & 0x3F; break;
+    }
+}
+
+static void emu_execute(const uint8_t *c)
+{
+    uint8_t op = c[0];
+    s_emu.stats.commands++;
+
+    if (op <= 0x1F)
+    {
+        if (s_emu.mode != ADDR_PAGE)
+        {
+            emu_error("cmd 0x%02X: column nibble only applies in page addressing mode", op);
+            return;
+        }
+        if (op <= 0x0F) s_emu.col = (uint8_t)((s_emu.col & 0xF0) | op);
+        else            s_emu.col = (uint8_t)((s_emu.col & 0x0F) | ((op & 0x07) << 4));
+        return;
+    }
+    if (op >= 0x40 && op <= 0x7F)
+    {
+        s_emu.start_line = op & 0x3F;
+        return;
+    }
+    if (op >= 0xB0 && op <= 0xB7)
+    {
+        if (s_emu.mode != ADDR_PAGE)
+        {
+            emu_error("cmd 0x%02X: page start only applies in page addressing mode", op);
+            return;
+        }
+        s_emu.page = op & 0x07;
+        return;
+    }
+
+    switch (op)
+    {
+    case 0x20:
+        if ((c[1] & 0x03) == 0x03)
+        {
+            emu_error("cmd 0x%02X: invalid addressing mode", op);
+            return;
+        }
+        s_emu.mode = (EmuAddrMode)(c[1] & 0x03);
+        break;
+
+    case 0x21:
+        s_emu.col_start = c[1] & 0x7F;
+        s_emu.col_end = c[2] & 0x7F;
+        s_emu.col = s_emu.col_start;
+        if (s_emu.col_end < s_emu.col_start) emu_error("cmd 0x%02X: column end before start", op);
+        if (s_emu.mode == ADDR_PAGE) emu_error("cmd 0x%02X: column range ignored in page mode", op);
+        break;
+
+    case 0x22:
+        s_emu.page_start = c[1] & 0x07;
+        s_emu.page_end = c[2] & 0x07;
+        s_emu.page = s_emu.page_start;
+        if (s_emu.page_end < s_emu.page_start) emu_error("cmd 0x%02X: page end before start", op);
+        if (s_emu.mode == ADDR_PAGE) emu_error("cmd 0x%02X: page range ignored in page mode", op);
+        break;
+
+    case 0x26: case 0x27: case 0x29: case 0x2A:
+        emu_scroll_setup(c);
+        break;
+
+    case 0x2E:
+        s_emu.scroll_active = false;
+        break;
+
+    case 0x2F:
+        s_emu.scroll_active = true;
+        s_emu.scroll_frames = 0;
+        break;
+
+    case 0x81: s_emu.contrast = c[1]; break;
+    case 0x8D: s_emu.charge_pump = (c[1] & 0x04) != 0; break;
+    case 0xA0: s_emu.seg_remap = false; break;
+    case 0xA1: s_emu.seg_remap = true; break;
+
+    case 0xA3:
+        s_emu.vscroll_fixed = c[1] & 0x3F;
+        s_emu.vscroll_rows = c[2] & 0x7F;
+        s_emu.vscroll_pos = 0;
+        if (s_emu.vscroll_fixed + s_emu.vscroll_rows > s_emu.mux || s_emu.vscroll_rows == 0)
+        {
+            emu_error("cmd 0x%02X: vertical scroll area exceeds MUX ratio", op);
+            s_emu.vscroll_fixed = 0;
+            s_emu.vscroll_rows = s_emu.mux;
+        }
+        break;
+
+    case 0xA4: s_emu.entire_on = false; break;
+    case 0xA5: s_emu.entire_on = true; break;
+    case 0xA6: s_emu.inverse = false; break;
+    case 0xA7: s_emu.inverse = true; break;
+
+    case 0xA8:
+        if ((c[1] & 0x3F) < 15)
+        {
+            emu_error("cmd 0x%02X: MUX ratio below 16", op);
+            return;
+        }
+        s_emu.mux = (uint8_t)((c[1] & 0x3F) + 1);
+        break;
+
+    case 0xAE: s_emu.display_on = false; break;
+    case 0xAF:
+        if (!s_emu.charge_pump) emu_error("cmd 0x%02X: display on with charge pump disabled", op);
+        s_emu.display_on = true;
+        break;
+
+    case 0xC0: s_emu.com_remap = false; break;
+    case 0xC8: s_emu.com_remap = true; break;
+    case 0xD3: s_emu.display_offset = c[1] & 0x3F; break;
+
+    case 0xD5: case 0xD9: case 0xDA: case 0xDB: case 0xE3:
+        break;  // 时序 / 硬件配置 / NOP，不影响图像
+
+    default:
+        emu_error("cmd 0x%02X: unknown command", op);
+        break;
+    }
+}
+
+static void emu_command_byte(uint8_t b)
+{
+    s_emu.stats.cmd_bytes++;
+    if (s_emu.cmd_len == 0)
+    {
+        s_emu.cmd_need = (uint8_t)(1 + emu_arg_count(b));
+    }
+    s_emu.cmd[s_emu.cmd_len++] = b;
+    if (s_emu.cmd_len == s_emu.cmd_need)
+    {
+        emu_execute(s_emu.cmd);
+        s_emu.cmd_len = 0;
+    }
+}
+
+/* ========= 数据 ========= */
+
+static void emu_data_byte(uint8_t b)
+{
+    s_emu.stats.data_bytes++;
+    if (s_emu.ram[s_emu.page][s_emu.col] == b)
+    {
+        s_emu.stats.redundant_bytes++;
+    }
+    s_emu.ram[s_emu.page][s_emu.col] = b;
+
+    switch (s_emu.mode)
+    {
+    case ADDR_HORIZONTAL:
+        if (s_emu.col >= s_emu.col_end)
+        {
+            s_emu.col = s_emu.col_start;
+            s_emu.page = (s_emu.page >= s_emu.page_end) ? s_emu.page_start : (uint8_t)(s_emu.page + 1);
+        }
+        else
+        {
+            s_emu.col++;
+        }
+        break;
+
+    case ADDR_VERTICAL:
+        if (s_emu.page >= s_emu.page_end)
+        {
+            s_emu.page = s_emu.page_start;
+            s_emu.col = (s_emu.col >= s_emu.col_end) ? s_emu.col_start : (uint8_t)(s_emu.col + 1);
+        }
+        else
+        {
+            s_emu.page++;
+        }
+        break;
+
+    case ADDR_PAGE:
+        /* 页模式：列指针到末尾后回到 0，页指针不变 */
+        s_emu.col = (uint8_t)((s_emu.col + 1) & 0x7F);
+        break;
+    }
+}
+
+void SSD1306Emu_Write(bool dc, const uint8_t *pData, uint16_t Size)
+{
+    if (dc && s_emu.cmd_len != 0)
+    {
+        emu_error("cmd 0x%02X: data phase before all command arguments were sent", s_emu.cmd[0]);
+        s_emu.cmd_len = 0;
+    }
+    for (uint16_t i = 0; i < Size; i++)
+    {
+        if (dc) emu_data_byte(pData[i]);
+        else    emu_command_byte(pData[i]);
+    }
+}
+
+/* ========= 硬件滚动 ========= */
+
+static void emu_scroll_step(void)
+{
+    bool right = (s_emu.scroll_type == SCROLL_RIGHT || s_emu.scroll_type == SCROLL_VERT_RIGHT);
+
+    for (uint8_t p = s_emu.scroll_page_start; p <= s_emu.scroll_page_end; p++)
+    {
+        uint8_t *row = s_emu.ram[p];
+        if (right)
+        {
+            uint8_t last = row[SSD1306_EMU_WIDTH - 1];
+            memmove(row + 1, row, SSD1306_EMU_WIDTH - 1);
+            row[0] = last;
+        }
+        else
+        {
+            uint8_t first = row[0];
+            memmove(row, row + 1, SSD1306_EMU_WIDTH - 1);
+            row[SSD1306_EMU_WIDTH - 1] = first;
+        }
+    }
+
+    if (s_emu.scroll_voffset && s_emu.vscroll_rows)
+    {
+        s_emu.vscroll_pos = (uint8_t)((s_emu.vscroll_pos + s_emu.scroll_voffset) % s_emu.vscroll_rows);
+    }
+}
+
+void SSD1306Emu_Tick(uint32_t ms)
+{
+    if (!s_emu.scroll_active) return;
+
+    s_emu.tick_ms += ms;
+    while (s_emu.tick_ms >= SSD1306_EMU_FRAME_MS)
+    {
+        s_emu.tick_ms -= SSD1306_EMU_FRAME_MS;
+        if (++s_emu.scroll_frames >= s_scroll_frames[s_emu.scroll_interval])
+        {
+            s_emu.scroll_frames = 0;
+            emu_scroll_step();
+        }
+    }
+}
+
+/* ========= 输出 ========= */
+
+void SSD1306Emu_GetRam(uint8_t out[SSD1306_EMU_PAGES][SSD1306_EMU_WIDTH])
+{
+    memcpy(out, s_emu.ram, sizeof(s_emu.ram));
+}
+
+void SSD1306Emu_RenderPanel(uint8_t out[SSD1306_EMU_PAGES][SSD1306_EMU_WIDTH])
+{
+    memset(out, 0, SSD1306_EMU_PAGES * SSD1306_EMU_WIDTH);
+    if (!s_emu.display_on) return;
+
+    for (uint8_t y = 0; y < EMU_ROWS; y++)
+    {
+        /* 观察者的第 y 行对应的 COM 行（C8 为本板的正向） */
+        uint8_t com = s_emu.com_remap ? y : (uint8_t)(EMU_ROWS - 1 - y);
+        if (com >= s_emu.mux) continue;
+
+        /* 垂直滚动区内的行叠加滚动偏移，再叠加起始行与显示偏移 */
+        uint8_t row = com;
+        if (com >= s_emu.vscroll_fixed && com < s_emu.vscroll_fixed + s_emu.vscroll_rows)
+        {
+            row = (uint8_t)(s_emu.vscroll_fixed +
+                            (com - s_emu.vscroll_fixed + s_emu.vscroll_pos) % s_emu.vscroll_rows);
+        }
+        row = (uint8_t)((row + s_emu.start_line + s_emu.display_offset) & (EMU_ROWS - 1));
+
+        for (uint8_t x = 0; x < SSD1306_EMU_WIDTH; x++)
+        {
+            uint8_t col = s_emu.seg_remap ? x : (uint8_t)(SSD1306_EMU_WIDTH - 1 - x);
+            uint8_t on = s_emu.entire_on ? 1 : ((s_emu.ram[row / 8][col] >> (row % 8)) & 1);
+            if (s_emu.inverse) on ^= 1;
+            if (on) out[y / 8][x] |= (uint8_t)(1 << (y % 8));
+        }
+    }
+}
+
+bool SSD1306Emu_IsDisplayOn(void)
+{
+    return s_emu.display_on;
+}
+
+uint8_t SSD1306Emu_GetContrast(void)
+{
+    return s_emu.contrast;
+}
+
+SSD1306Emu_Stats SSD1306Emu_GetStats(void)
+{
+    return s_emu.stats;
+}
+
+void SSD1306Emu_ResetStats(void)
+{
+    memset(&s_emu.stats, 0, sizeof(s_emu.stats));
+    s_emu.last_error[0] = '\0';
+}
+
+const char *SSD1306Emu_LastError(void)
+{
+    return s_emu.last_error;
+}
@@ -0,0 +1,56 @@
+/*
+ * ssd1306_emu.h
+ *
+ *  主机端 SSD1306 (128x64) 协议模型：消费 OLED.c 经 SPI 发出的 DC/命令/数据字节流，
+ *  按数据手册维护寻址模式、页/列指针、对比度、起始行、反色、重映射与硬件滚动，
+ *  重建 GDDRAM 与面板实际显示的图像，并统计总线字节数与命令数。
+ *
+ *  由 host_port.c 的 HAL_SPI_Transmit / HAL_GPIO_WritePin 桩驱动（DC=PB1，RES=PB0）。
+ */
+
+#ifndef SSD1306_EMU_H
+#define SSD1306_EMU_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SSD1306_EMU_WIDTH   128
+#define SSD1306_EMU_PAGES   8
+#define SSD1306_EMU_FRAME_MS 10U   // 面板帧周期（D5=0x80 时约 100 Hz），驱动硬件滚动
+
+/* 总线统计 */
+typedef struct
+{
+    uint32_t cmd_bytes;         // DC 低电平字节数（命令 + 参数）
+    uint32_t data_bytes;        // DC 高电平字节数（写 GDDRAM）
+    uint32_t commands;          // 完整解析的命令条数（不含参数字节）
+    uint32_t redundant_bytes;   // 写入值与 GDDRAM 原值相同的数据字节（可省掉的传输）
+    uint32_t protocol_errors;   // 未知命令、非法参数、当前模式下无效的命令
+} SSD1306Emu_Stats;
+
+/* 硬件复位（RES 拉低）：寄存器恢复上电默认值，GDDRAM 保持 */
+void SSD1306Emu_Reset(void);
+
+/* 一次 SPI 传输：dc=false 为命令流，dc=true 为数据流 */
+void SSD1306Emu_Write(bool dc, const uint8_t *pData, uint16_t Size);
+
+/* 推进面板时间（用于硬件滚动） */
+void SSD1306Emu_Tick(uint32_t ms);
+
+/* GDDRAM 原始内容（页格式，与 OLED_DisplayBuf 相同布局） */
+void SSD1306Emu_GetRam(uint8_t out[SSD1306_EMU_PAGES][SSD1306_EMU_WIDTH]);
+
+/* 面板上实际看到的图像：考虑开关显示、全亮、反色、起始行/偏移、段/COM 重映射与垂直滚动。
+ * 以 OLED_Init 的方向 (A1 + C8) 为正向，此时与 GDDRAM 逐字节一致 */
+void SSD1306Emu_RenderPanel(uint8_t out[SSD1306_EMU_PAGES][SSD1306_EMU_WIDTH]);
+
+bool SSD1306Emu_IsDisplayOn(void);
+uint8_t SSD1306Emu_GetContrast(void);
+
+SSD1306Emu_Stats SSD1306Emu_GetStats(void);
+void SSD1306Emu_ResetStats(void);
+
+/* 最近一次协议错误的描述（无错误时为空串） */
+const char *SSD1306Emu_LastError(void);
+
+#endif /* SSD1306_EMU_H */